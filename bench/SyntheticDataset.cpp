@@ -0,0 +1,147 @@
+#include "SyntheticDataset.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// splitmix64: tiny, fast and identical everywhere, unlike the std distributions
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double unit() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t state;
+};
+
+const char* const kPrograms[] = {
+    "MS in Data Science", "MS in Information Security", "MS in Computer Science",
+    "MS in Artificial Intelligence", "BS in Software Engineering", "BS in Computer Science",
+};
+
+const char* const kTopics[] = {
+    "Image processing & Computer Vision", "Artificial Neural Networks", "Emerging Trends in Information Security",
+    "Wireless and Mobile Communication Networks", "Data Structure and Algorithm Design", "Machine Learning",
+    "Distributed Systems", "Cloud Computing", "Database Systems", "Compiler Construction",
+    "Natural Language Processing", "Software Project Management",
+};
+
+void appendCourse(std::string& out, size_t course) {
+    const size_t topics = sizeof(kTopics) / sizeof(kTopics[0]);
+    out += "CT-";
+    out += std::to_string(100 + course);
+    out += ',';
+    // Every tenth course name needs CSV quoting
+    if (course % 10 == 9) {
+        out += '"';
+        out += kTopics[course % topics];
+        out += ", Part ";
+        out += std::to_string(course / topics + 1);
+        out += '"';
+    } else {
+        out += kTopics[course % topics];
+        out += ' ';
+        out += std::to_string(course / topics + 1);
+    }
+}
+
+} // namespace
+
+bool writeSyntheticDataset(const std::string& filename, const SyntheticDatasetConfig& config,
+                           SyntheticDatasetStats& stats) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    stats = SyntheticDatasetStats();
+    stats.courses = config.courses ? config.courses : std::max<size_t>(20, config.students / 20);
+
+    // Zipf cumulative distribution over course ranks
+    std::vector<double> cdf(stats.courses);
+    double total = 0;
+    for (size_t k = 0; k < stats.courses; k++) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), config.zipfExponent);
+        cdf[k] = total;
+    }
+    for (double& p : cdf) {
+        p /= total;
+    }
+    std::vector<size_t> courseSizes(stats.courses, 0);
+
+    Random random(config.seed);
+    auto pickCourse = [&]() {
+        size_t k = static_cast<size_t>(std::upper_bound(cdf.begin(), cdf.end(), random.unit()) - cdf.begin());
+        return std::min(k, stats.courses - 1);
+    };
+
+    const size_t programs = sizeof(kPrograms) / sizeof(kPrograms[0]);
+    std::string buffer = "Name,Roll Number,Batch,Program,Course ID 1,Course 1,Course ID 2,Course 2,"
+                         "Customised Course ID,Customised Course\n";
+    buffer.reserve(1 << 20);
+
+    for (size_t i = 0; i < config.students; i++) {
+        // CT-<batch year><program code><serial>, unique for any population size
+        unsigned year = 22 + static_cast<unsigned>(i % 4);
+        size_t j = i / 4;
+        char roll[32];
+        std::snprintf(roll, sizeof(roll), "CT-%02u%03zu%03zu", year, 279 + j / 1000, j % 1000);
+
+        buffer += "Student ";
+        buffer += std::to_string(i);
+        buffer += ',';
+        buffer += roll;
+        buffer += ",20";
+        buffer += std::to_string(year);
+        buffer += ',';
+        buffer += kPrograms[(j / 1000) % programs];
+
+        // Two regular courses and sometimes a customised one, all distinct
+        size_t picks[3];
+        size_t count = random.unit() < config.thirdCourseRate ? 3 : 2;
+        count = std::min(count, stats.courses);
+        for (size_t p = 0; p < count; p++) {
+            size_t course = pickCourse();
+            for (int attempt = 0; attempt < 16 && std::find(picks, picks + p, course) != picks + p; attempt++) {
+                course = pickCourse();
+            }
+            while (std::find(picks, picks + p, course) != picks + p) {
+                course = (course + 1) % stats.courses;
+            }
+            picks[p] = course;
+            courseSizes[course]++;
+            buffer += ',';
+            appendCourse(buffer, course);
+        }
+        if (count == 2) {
+            buffer += ",,";
+        }
+        buffer += '\n';
+        stats.rows++;
+        stats.enrollments += count;
+
+        if (buffer.size() > (1 << 20) - 1024) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            stats.bytes += buffer.size();
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    stats.bytes += buffer.size();
+    stats.largestCourse = *std::max_element(courseSizes.begin(), courseSizes.end());
+    return file.good();
+}
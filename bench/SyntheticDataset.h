@@ -0,0 +1,33 @@
+#ifndef SYNTHETICDATASET_H
+#define SYNTHETICDATASET_H
+
+#include <cstdint>
+#include <string>
+
+// Deterministic enrolment CSV generator for benchmarks. Output has the same
+// layout as the real exports (Name, Roll Number, Batch, Program, two course
+// pairs and a customised course pair) with roll numbers like CT-24279001.
+// Course popularity follows a Zipf distribution, so a few core courses are
+// very large and there is a long tail of small electives.
+// The same seed and sizes give byte-identical files on every platform.
+struct SyntheticDatasetConfig {
+    size_t students = 1000;
+    size_t courses = 0;          // 0: one course per 20 students, at least 20
+    double zipfExponent = 1.0;
+    double thirdCourseRate = 0.6; // Share of students with a customised third course
+    uint64_t seed = 20251116;
+};
+
+struct SyntheticDatasetStats {
+    size_t rows = 0;
+    size_t courses = 0;
+    size_t enrollments = 0;
+    uint64_t bytes = 0;
+    size_t largestCourse = 0;
+};
+
+// Writes the dataset to filename; false if the file cannot be written
+bool writeSyntheticDataset(const std::string& filename, const SyntheticDatasetConfig& config,
+                           SyntheticDatasetStats& stats);
+
+#endif // SYNTHETICDATASET_H
@@ -0,0 +1,364 @@
+#include "SyntheticDataset.h"
+#include "../include/DatabaseManager.h"
+#include "../include/TimetableGenerator.h"
+#include "../include/AnalyticsEngine.h"
+#include "../include/Snapshot.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+// Scaling benchmark: generates Zipf-distributed enrolment datasets of growing size
+// and times every engine phase, with throughput, peak RSS and heap allocations.
+
+// Heap allocation counters, fed by the replacement operator new below
+static std::atomic<uint64_t> allocationCount(0);
+static std::atomic<uint64_t> allocationBytes(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace {
+
+struct PhaseResult {
+    std::string name;
+    double ms = 0;
+    double items = 0;       // Rows, sessions or bytes, for throughput
+    const char* unit = "";
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t peakRssKb = 0;
+};
+
+// Starts a new peak-RSS window where the platform allows it (Linux clear_refs)
+void resetPeakRss() {
+#ifdef __linux__
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs.is_open()) {
+        clearRefs << "5";
+    }
+#endif
+}
+
+uint64_t peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+#else
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+#endif
+    return 0;
+}
+
+PhaseResult measure(const std::string& name, const char* unit, const std::function<double()>& phase) {
+    PhaseResult result;
+    result.name = name;
+    result.unit = unit;
+    resetPeakRss();
+    uint64_t allocationsBefore = allocationCount.load();
+    uint64_t bytesBefore = allocationBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    result.items = phase();
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.allocations = allocationCount.load() - allocationsBefore;
+    result.allocatedBytes = allocationBytes.load() - bytesBefore;
+    result.peakRssKb = peakRssKb();
+    return result;
+}
+
+uint64_t fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+void printUsage() {
+    std::cout << "Usage: timetable-bench [options]\n"
+                 "  --sizes LIST      Student counts (default: 1000,10000,100000,1000000)\n"
+                 "  --threads N       Import and conflict-graph threads, 0 = all (default: 0)\n"
+                 "  --mode MODE       sequential or dsatur (default: sequential)\n"
+                 "  --share-rooms     Seat several courses of an exam slot in one room\n"
+                 "  --sittings N      Three-hour exam sittings per day, 1-3 (default: 1)\n"
+                 "  --formats LIST    Exporters to time: csv,txt,pdf,tickets (default: csv,txt,pdf)\n"
+                 "  --zipf S          Zipf exponent of course popularity (default: 1.0)\n"
+                 "  --rooms FILE      Room inventory CSV (default: 11 rooms + 4 labs of 55 seats)\n"
+                 "  --dir DIR         Scratch directory for datasets and exports (default: .)\n"
+                 "  --json FILE       Also write the results as JSON\n"
+                 "  --keep            Keep generated datasets and exports\n"
+                 "  --verbose         Show engine progress messages\n";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+    std::vector<std::string> formats = {"csv", "txt", "pdf"};
+    unsigned threads = 0;
+    SchedulingMode mode = SchedulingMode::Sequential;
+    bool shareRooms = false;
+    int sittings = 1;
+    double zipf = 1.0;
+    std::string dir = ".";
+    std::string roomsFile;
+    std::string jsonFile;
+    bool keep = false;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            for (const std::string& size : splitList(argv[++i])) {
+                sizes.push_back(static_cast<size_t>(std::strtoull(size.c_str(), nullptr, 10)));
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--mode" && hasValue) {
+            mode = std::string(argv[++i]) == "dsatur" ? SchedulingMode::DSatur : SchedulingMode::Sequential;
+        } else if (arg == "--formats" && hasValue) {
+            formats = splitList(argv[++i]);
+        } else if (arg == "--sittings" && hasValue) {
+            sittings = std::clamp(std::atoi(argv[++i]), 1, 3);
+        } else if (arg == "--zipf" && hasValue) {
+            zipf = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--rooms" && hasValue) {
+            roomsFile = argv[++i];
+        } else if (arg == "--dir" && hasValue) {
+            dir = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonFile = argv[++i];
+        } else if (arg == "--share-rooms") {
+            shareRooms = true;
+        } else if (arg == "--keep") {
+            keep = true;
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    RoomInventory rooms = RoomInventory::standardCampus();
+    if (!roomsFile.empty() && !rooms.loadFromCSV(roomsFile)) {
+        return 1;
+    }
+
+    // Engine chatter is not part of the measurement
+    Log::setConsole(verbose ? LogLevel::Info : LogLevel::Error);
+    std::ostringstream json;
+    json << "[";
+
+    for (size_t run = 0; run < sizes.size(); run++) {
+        const size_t students = sizes[run];
+        const std::string prefix = dir + "/bench_" + std::to_string(students);
+        const std::string input = prefix + ".csv";
+
+        SyntheticDatasetConfig config;
+        config.students = students;
+        config.zipfExponent = zipf;
+        SyntheticDatasetStats dataset;
+        if (!writeSyntheticDataset(input, config, dataset)) {
+            std::cerr << "Could not write dataset " << input << std::endl;
+            return 1;
+        }
+        std::cout << "\n== " << students << " students, " << dataset.courses << " courses, " << dataset.enrollments
+                  << " enrollments, largest course " << dataset.largestCourse << ", " << dataset.bytes / 1024
+                  << " KiB ==" << std::endl;
+
+        std::vector<PhaseResult> phases;
+        {
+            DatabaseManager db;
+            TimetableGenerator generator(db);
+            generator.setStartDate("16-11-2025");
+            generator.setThreadCount(threads);
+            generator.setSchedulingMode(mode);
+            generator.setRoomSharing(shareRooms);
+            generator.setSittingPlan(SittingPlan::standardDay(sittings));
+            generator.setRoomInventory(rooms);
+            bool ok = true;
+
+            phases.push_back(measure("importFromCSV", "rows", [&]() {
+                ok = db.importFromCSV(input, threads);
+                return static_cast<double>(dataset.rows);
+            }));
+            phases.push_back(measure("fetchCourses", "courses", [&]() {
+                return static_cast<double>(db.fetchCourses().size());
+            }));
+            phases.push_back(measure("fetchStudents", "students", [&]() {
+                return static_cast<double>(db.fetchStudents().size());
+            }));
+            phases.push_back(measure("fetchEnrollments", "enrollments", [&]() {
+                return static_cast<double>(db.fetchEnrollments().size());
+            }));
+            if (ok) {
+                phases.push_back(measure("generate", "sessions", [&]() {
+                    ok = generator.generate();
+                    return static_cast<double>(generator.getEntries().size());
+                }));
+            }
+            if (ok) {
+                AnalyticsEngine analytics;
+                analytics.setThreadCount(threads);
+                phases.push_back(measure("analyse", "sessions", [&]() {
+                    analytics.analyse(generator);
+                    return static_cast<double>(generator.getEntries().size());
+                }));
+                phases.push_back(measure("analyseCached", "sessions", [&]() {
+                    analytics.analyse(generator);
+                    return static_cast<double>(generator.getEntries().size());
+                }));
+                // Help-desk lookups: every student's exams by roll number
+                phases.push_back(measure("studentTimetable", "lookups", [&]() {
+                    const StudentTable& students = db.getStore().students;
+                    uint64_t rooms = 0;
+                    for (uint32_t s = 0; s < students.size(); s++) {
+                        for (uint32_t idx : generator.studentTimetable(students.find(students.rollNo(s)))) {
+                            rooms += generator.getEntries()[idx].room;
+                        }
+                    }
+                    return rooms > 0 ? static_cast<double>(students.size()) : 0.0;
+                }));
+            }
+            if (ok) {
+                // Save, reopen and reload: the snapshot path that replaces CSV import
+                const std::string snapshotPath = prefix + ".snap";
+                phases.push_back(measure("saveSnapshot", "bytes", [&]() {
+                    ok = writeSnapshot(snapshotPath, db.getStore(), &generator);
+                    return static_cast<double>(fileSize(snapshotPath));
+                }));
+                SnapshotFile snapshot;
+                DatabaseManager snapshotDb;
+                TimetableGenerator restored(snapshotDb);
+                phases.push_back(measure("openSnapshot", "bytes", [&]() {
+                    ok = ok && snapshot.open(snapshotPath);
+                    return static_cast<double>(fileSize(snapshotPath));
+                }));
+                phases.push_back(measure("loadSnapshot", "enrollments", [&]() {
+                    ok = ok && snapshotDb.loadSnapshot(snapshot) && restored.loadSchedule(snapshot);
+                    return static_cast<double>(snapshotDb.getStore().enrollments.size());
+                }));
+                snapshot.close();
+                if (!keep) {
+                    std::remove(snapshotPath.c_str());
+                }
+            }
+            for (const std::string& format : formats) {
+                if (!ok) break;
+                const std::string output = prefix + (format == "tickets" ? "_tickets.pdf" : "_out." + format);
+                const char* name = format == "csv" ? "exportToCSV" : format == "txt" ? "exportToText"
+                                 : format == "pdf" ? "exportToPDF" : "exportHallTickets";
+                phases.push_back(measure(name, "bytes", [&]() {
+                    if (format == "csv") {
+                        generator.exportToCSV(output);
+                    } else if (format == "txt") {
+                        generator.exportToText(output);
+                    } else if (format == "pdf") {
+                        generator.exportToPDF(output);
+                    } else if (format == "tickets") {
+                        generator.exportHallTickets(output);
+                    }
+                    return static_cast<double>(fileSize(output));
+                }));
+                if (!keep) {
+                    std::remove(output.c_str());
+                }
+            }
+            Log::flush();
+            if (!ok) {
+                std::cerr << "Engine failed for " << students << " students" << std::endl;
+            }
+        }
+        if (!keep) {
+            std::remove(input.c_str());
+        }
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-18s %12s %24s %12s %14s %12s\n", "phase", "ms", "throughput per s",
+                      "allocs", "alloc bytes", "peak RSS MB");
+        std::cout << line;
+        json << (run ? ",\n" : "\n") << "  {\"students\": " << students << ", \"courses\": " << dataset.courses
+             << ", \"enrollments\": " << dataset.enrollments << ", \"csvBytes\": " << dataset.bytes
+             << ", \"phases\": [";
+        for (size_t p = 0; p < phases.size(); p++) {
+            const PhaseResult& r = phases[p];
+            double perSecond = r.ms > 0 ? r.items * 1000.0 / r.ms : 0;
+            std::snprintf(line, sizeof(line), "%-18s %12.3f %12.4g %-11s %12llu %14llu %12.1f\n", r.name.c_str(), r.ms,
+                          perSecond, r.unit, static_cast<unsigned long long>(r.allocations),
+                          static_cast<unsigned long long>(r.allocatedBytes), r.peakRssKb / 1024.0);
+            std::cout << line;
+            json << (p ? ", " : "") << "\n    {\"phase\": \"" << r.name << "\", \"ms\": " << r.ms << ", \"items\": "
+                 << r.items << ", \"unit\": \"" << r.unit << "\", \"perSecond\": " << perSecond
+                 << ", \"allocations\": " << r.allocations << ", \"allocatedBytes\": " << r.allocatedBytes
+                 << ", \"peakRssKb\": " << r.peakRssKb << "}";
+        }
+        json << "\n  ]}";
+    }
+    json << "\n]\n";
+
+    if (!jsonFile.empty()) {
+        std::ofstream out(jsonFile);
+        out << json.str();
+    }
+    return 0;
+}
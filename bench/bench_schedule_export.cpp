@@ -0,0 +1,131 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include "../include/DatabaseManager.h"
+#include "../include/TimetableGenerator.h"
+
+// Compares exporting / refreshing from ScheduleEntry records against the old
+// path that re-parsed comma-joined schedule lines, on a ~20k-session schedule.
+
+static double timeMs(const std::function<void()>& fn, int repeats) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+// Old exportToCSV body: seven find/substr rounds per line
+static size_t legacyCSV(const std::vector<std::string>& schedule, const std::string& filename) {
+    std::ofstream file(filename);
+    file << "Date,Day_Num,Room,Room_Cap,Course_ID,Section,Course_N,Students_S,Student_F,Start_Time,End_Time,Capacity,Status\n";
+    for (const auto& entry : schedule) {
+        std::string fields[7];
+        std::string str = entry;
+        for (int f = 0; f < 6; f++) {
+            size_t nextPos = str.find(",");
+            fields[f] = str.substr(0, nextPos);
+            str = str.substr(nextPos + 1);
+        }
+        fields[6] = str;
+        const std::string& date = fields[2];
+        std::string formattedDate = date.substr(0, 2) + "/" + date.substr(3, 2) + "/" + date.substr(6, 4);
+        std::string studentsCount = fields[6].substr(0, fields[6].find("/"));
+        file << formattedDate << "," << fields[1] << "," << fields[5] << ",55," << fields[3] << ",1-Jan,Unknown Course,"
+             << studentsCount << "," << fields[4] << ",2:00 PM,5:00 PM,55,OK\n";
+    }
+    return static_cast<size_t>(file.tellp());
+}
+
+// Old ScheduleTableModel::setSchedule body: getline tokenising and stoi per line
+static long legacyRefresh(const std::vector<std::string>& schedule) {
+    long checksum = 0;
+    for (const auto& line : schedule) {
+        std::vector<std::string> tokens;
+        std::string token;
+        std::stringstream ss(line);
+        while (std::getline(ss, token, ',')) {
+            tokens.push_back(token);
+        }
+        int dayNum = std::stoi(tokens[1]) - 1;
+        const std::string& roomStr = tokens[5];
+        int roomNum = roomStr.find("Room#") != std::string::npos
+            ? std::stoi(roomStr.substr(roomStr.find("#") + 1)) - 1
+            : std::stoi(roomStr.substr(3)) + 10;
+        int numStudents = std::stoi(tokens[6].substr(0, tokens[6].find("/")));
+        checksum += dayNum + roomNum + numStudents + static_cast<long>(tokens[3].size() + tokens[4].size());
+    }
+    return checksum;
+}
+
+static long entryRefresh(const TimetableGenerator& generator) {
+    long checksum = 0;
+    for (const ScheduleEntry& entry : generator.getEntries()) {
+        std::string courseId = generator.courseCode(entry);
+        std::string range = generator.studentRange(entry);
+        checksum += (entry.dayIndex - 1) + (static_cast<long>(entry.room) - 1) + static_cast<long>(entry.count)
+                  + static_cast<long>(courseId.size() + range.size());
+    }
+    return checksum;
+}
+
+int main(int argc, char* argv[]) {
+    int courses = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const int students = 2000;
+    const std::string input = "bench_schedule_input.csv";
+
+    // Every student takes three courses; three students per course -> one session per course
+    {
+        std::ofstream out(input);
+        out << "Name,Roll Number,Batch,Program,Course ID 1,Course 1,Course ID 2,Course 2,Customised Course ID,Customised Course\n";
+        for (int c = 0; c < courses; c++) {
+            for (int k = 0; k < 3; k++) {
+                char roll[32];
+                std::snprintf(roll, sizeof(roll), "CT-%08d", (c * 3 + k) % students);
+                out << "Student," << roll << ",2025,BS," << "C" << c << ",Course " << c << ",,,,\n";
+            }
+        }
+    }
+
+    DatabaseManager db;
+    if (!db.importFromCSV(input, 0)) {
+        std::cout << "CSV import failed!" << std::endl;
+        return 1;
+    }
+    TimetableGenerator generator(db);
+    generator.setStartDate("16-11-2025");
+    if (!generator.generate()) {
+        std::cout << "Timetable generation failed!" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> lines = generator.getSchedule();
+    std::cout << "\nSessions: " << generator.getEntries().size() << std::endl;
+
+    const int repeats = 5;
+    double csvNew = timeMs([&] { generator.exportToCSV("bench_schedule_new.csv"); }, repeats);
+    double csvOld = timeMs([&] { legacyCSV(lines, "bench_schedule_old.csv"); }, repeats);
+    double txtNew = timeMs([&] { generator.exportToText("bench_schedule_new.txt"); }, repeats);
+    double linesNew = timeMs([&] { generator.getSchedule(); }, repeats);
+    long oldSum = 0, newSum = 0;
+    double refreshOld = timeMs([&] { oldSum = legacyRefresh(lines); }, repeats);
+    double refreshNew = timeMs([&] { newSum = entryRefresh(generator); }, repeats);
+
+    std::cout << "CSV export:    entries " << csvNew << " ms, re-parse " << csvOld << " ms ("
+              << csvOld / csvNew << "x)" << std::endl;
+    std::cout << "Model refresh: entries " << refreshNew << " ms, re-parse " << refreshOld << " ms ("
+              << refreshOld / refreshNew << "x)" << (oldSum == newSum ? "" : "  CHECKSUM MISMATCH") << std::endl;
+    std::cout << "Text export:   " << txtNew << " ms" << std::endl;
+    std::cout << "getSchedule(): " << linesNew << " ms" << std::endl;
+
+    std::remove(input.c_str());
+    std::remove("bench_schedule_new.csv");
+    std::remove("bench_schedule_old.csv");
+    std::remove("bench_schedule_new.txt");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#ifndef ANALYTICSENGINE_H
+#define ANALYTICSENGINE_H
+
+#include <vector>
+#include <string>
+#include "TimetableGenerator.h"
+
+// Aggregates of one generated schedule. Everything is held in dense arrays indexed
+// by exam day (0 = day 1), room (0 = room 1), course id or department, so charts can
+// read them in order without sorting string keys.
+struct ScheduleAnalytics {
+    uint64_t version = 0;            // Schedule version the numbers were computed from
+    int days = 0;
+    int rooms = 0;
+    int32_t firstDate = 0;           // Date of day 1, days since 01-01-1970
+    uint32_t largestRoom = 0;        // Seats of the largest room in use
+
+    std::vector<uint32_t> sessionsPerDay;
+    std::vector<uint32_t> seatsPerDay;        // Students sitting an exam that day
+    std::vector<uint32_t> roomCapacity;
+    std::vector<uint32_t> sessionsPerRoom;
+    std::vector<uint32_t> seatsPerRoom;
+    std::vector<uint32_t> roomDayLoad;        // Seated students, days x rooms, row-major
+    std::vector<uint32_t> slotsPerRoom;       // Exam slots the room held a session in
+
+    std::vector<std::string> departments;     // In first-seen course order
+    std::vector<uint32_t> sessionsPerDepartment;
+
+    std::vector<uint32_t> clashesPerCourse;   // Students of the course with another exam in the same slot
+    std::vector<uint32_t> examsPerStudent;    // Histogram: students by number of scheduled exams
+    uint64_t clashingSeats = 0;               // Sum of clashesPerCourse
+    uint32_t clashingStudents = 0;            // Students with at least one same-slot clash
+    double computeMs = 0;
+
+    uint32_t roomLoad(int day, int room) const { return roomDayLoad[static_cast<size_t>(day) * rooms + room]; }
+    // Seated students over the room's seats in the exam slots it was used, 0-100;
+    // shared rooms count once per slot however many sessions they hold
+    double roomUtilisation(int room) const;
+};
+
+// Computes ScheduleAnalytics from a generator in one fused parallel pass over the
+// sessions plus one over the student occupancy index. Each worker fills its own
+// partial aggregates, which are summed at the end, so no counter is shared between
+// threads. The result is cached by schedule version: asking again for an unchanged
+// schedule costs nothing.
+class AnalyticsEngine {
+public:
+    AnalyticsEngine();
+
+    void setThreadCount(unsigned threads); // 0 = all hardware threads
+
+    // Returns the cached result if the generator's schedule has not changed
+    const ScheduleAnalytics& analyse(const TimetableGenerator& generator);
+    const ScheduleAnalytics& getResult() const { return result; }
+    bool hasResult() const { return valid; }
+    void invalidate() { valid = false; }
+
+private:
+    void compute(const TimetableGenerator& generator);
+
+    ScheduleAnalytics result;
+    bool valid;
+    unsigned threadCount;
+};
+
+#endif // ANALYTICSENGINE_H
@@ -0,0 +1,118 @@
+#ifndef CIVILDATE_H
+#define CIVILDATE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Dates are day numbers: days since 01-01-1970 in the proleptic Gregorian
+// calendar. Conversions are pure integer arithmetic (H. Hinnant's civil date
+// algorithms), so they are constexpr, thread-safe and unaffected by time zones
+// or daylight saving, unlike mktime/localtime.
+
+struct CivilDate {
+    int year;
+    unsigned month; // 1-12
+    unsigned day;   // 1-31
+};
+
+constexpr bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+constexpr unsigned daysInMonth(int year, unsigned month) {
+    constexpr unsigned char days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29u : days[month - 1];
+}
+
+constexpr int32_t daysFromCivil(int year, unsigned month, unsigned day) {
+    const int y = year - (month <= 2 ? 1 : 0);
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+constexpr CivilDate civilFromDays(int32_t days) {
+    const int32_t z = days + 719468;
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    return CivilDate{static_cast<int>(yoe) + era * 400 + (month <= 2 ? 1 : 0), month, day};
+}
+
+// 0 = Monday ... 6 = Sunday; 01-01-1970 was a Thursday
+constexpr int weekdayFromDays(int32_t days) {
+    return static_cast<int>(((days % 7) + 7 + 3) % 7);
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0, "civil date epoch");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "civil date leap century");
+static_assert(civilFromDays(11016).day == 29, "civil date round trip");
+static_assert(weekdayFromDays(0) == 3, "01-01-1970 was a Thursday");
+
+// "DD-MM-YYYY"; false if malformed or not a real date
+bool parseDate(std::string_view text, int32_t& days);
+// Appends DD-MM-YYYY without allocating beyond the string's own growth
+void appendDate(std::string& out, int32_t days);
+std::string formatDate(int32_t days);
+const char* weekdayName(int32_t days);
+
+// Times of day are minutes after midnight. "HH:MM" on the 24-hour clock;
+// false if malformed
+bool parseTime(std::string_view text, int32_t& minutes);
+// Appends "2:00 PM"; minutes past midnight wrap into the next day
+void appendTime(std::string& out, int32_t minutes);
+std::string formatTime(int32_t minutes);
+
+// Weekday set such as "Sat;Sun", "Mon-Fri", "Sat-Mon" or "All" as a mask,
+// bit 0 = Monday; an empty text is every day. False if a name is not a weekday.
+bool parseWeekdays(std::string_view text, uint8_t& mask);
+
+// Which days may hold exams: every day except the configured weekend days and
+// holidays. Holidays are kept as a bitmap over the range they span, so
+// isExamDay() is O(1) however many there are.
+//
+// Holidays file: one DD-MM-YYYY date per line, optionally followed by a comma
+// and a name; blank lines and lines starting with '#' are skipped.
+class ExamCalendar {
+public:
+    static constexpr uint8_t kSaturdayAndSunday = 0x60;
+
+    ExamCalendar();
+
+    void setWeekend(uint8_t weekdayMask) { weekend = weekdayMask & 0x7F; } // Bit 0 = Monday
+    uint8_t getWeekend() const { return weekend; }
+    void addHoliday(int32_t date);
+    bool loadHolidays(const std::string& filename); // false (calendar unchanged) on error
+    void clearHolidays();
+    size_t holidayCount() const { return holidays; }
+    std::vector<int32_t> holidayDates() const; // Ascending
+
+    bool isHoliday(int32_t date) const {
+        const int64_t offset = static_cast<int64_t>(date) - firstHoliday;
+        return offset >= 0 && offset < static_cast<int64_t>(holidayBits.size()) * 64 &&
+               (holidayBits[offset / 64] >> (offset % 64)) & 1;
+    }
+    bool isExamDay(int32_t date) const { return !((weekend >> weekdayFromDays(date)) & 1) && !isHoliday(date); }
+    bool hasExamDays() const { return weekend != 0x7F; }
+
+    // First exam day on or after the date; the date itself if no day is eligible
+    int32_t nextExamDay(int32_t date) const;
+    // The first `count` exam days from the date on
+    std::vector<int32_t> examDays(int32_t from, size_t count) const;
+
+private:
+    uint8_t weekend;
+    int32_t firstHoliday;
+    std::vector<uint64_t> holidayBits; // Bit i = firstHoliday + i
+    size_t holidays;
+};
+
+#endif // CIVILDATE_H
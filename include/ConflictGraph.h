@@ -0,0 +1,67 @@
+#ifndef CONFLICTGRAPH_H
+#define CONFLICTGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "EntityStore.h"
+
+// Weighted course x course conflict graph in compressed sparse row form.
+// The weight of edge (a, b) is the number of students enrolled in both courses.
+// It is the off-diagonal part of A^T A, where A is the student x course
+// incidence matrix; rows are computed in parallel with a dense accumulator
+// per thread (Gustavson's sparse product).
+class ConflictGraph {
+public:
+    ConflictGraph();
+
+    // threadCount 0 uses every hardware thread
+    void build(const EnrollmentTable& enrollments, size_t studentCount, size_t courseCount,
+               unsigned threadCount = 0);
+    void clear();
+
+    size_t courseCount() const { return courseSizes.size(); }
+    size_t edgeCount() const { return adjacency.size() / 2; } // Undirected edges
+
+    // Number of distinct students enrolled in the course (diagonal of A^T A)
+    uint32_t courseSize(uint32_t c) const { return courseSizes[c]; }
+
+    uint32_t degree(uint32_t c) const { return static_cast<uint32_t>(offsets[c + 1] - offsets[c]); }
+
+    // Neighbours of c in ascending id order, with weights at the same positions
+    ArrayView<uint32_t> neighbours(uint32_t c) const {
+        return ArrayView<uint32_t>(adjacency.data() + offsets[c], degree(c));
+    }
+    ArrayView<uint32_t> weights(uint32_t c) const {
+        return ArrayView<uint32_t>(edgeWeights.data() + offsets[c], degree(c));
+    }
+
+    // Shared students of a and b, 0 if they do not conflict (O(log degree))
+    uint32_t weight(uint32_t a, uint32_t b) const;
+
+    // Sum of the weights of all edges of c
+    uint64_t weightedDegree(uint32_t c) const;
+
+    double getBuildMs() const { return buildMs; }
+
+    // The CSR arrays as stored, e.g. for saving a snapshot
+    ArrayView<size_t> rowOffsets() const { return ArrayView<size_t>(offsets); }
+    ArrayView<uint32_t> adjacencyList() const { return ArrayView<uint32_t>(adjacency); }
+    ArrayView<uint32_t> weightList() const { return ArrayView<uint32_t>(edgeWeights); }
+    ArrayView<uint32_t> courseSizeList() const { return ArrayView<uint32_t>(courseSizes); }
+
+    // Replaces the graph with saved CSR arrays. false (graph cleared) if they are
+    // inconsistent: offsets must be non-decreasing, end at the edge count and
+    // have one entry more than courseSizes, and neighbours must be valid course ids.
+    bool restore(ArrayView<uint64_t> rowOffsets, ArrayView<uint32_t> neighbourIds, ArrayView<uint32_t> neighbourWeights,
+                 ArrayView<uint32_t> sizes);
+
+private:
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> adjacency;
+    std::vector<uint32_t> edgeWeights;
+    std::vector<uint32_t> courseSizes;
+    double buildMs;
+};
+
+#endif // CONFLICTGRAPH_H
@@ -0,0 +1,80 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    void* fileHandle;     // Using void* to avoid including windows.h
+    void* mappingHandle;
+#endif
+};
+
+// One field of a record. text points into the parsed buffer with the
+// surrounding quotes removed; escaped is set when it still contains "" pairs.
+struct CsvField {
+    std::string_view text;
+    bool escaped = false;
+
+    // Returns the field value, collapsing "" into scratch only when needed
+    std::string_view value(std::string& scratch) const;
+};
+
+// RFC 4180 record reader over an in-memory buffer. Delimiters, quotes and
+// line breaks are located 16/32 bytes at a time with SSE2/AVX2 where the CPU
+// supports it, falling back to a scalar scan elsewhere. Fields are views into
+// the buffer, so reading allocates nothing once the field vector has grown.
+class CsvReader {
+public:
+    CsvReader(const char* begin, const char* end);
+
+    // Reads the next record into fields; returns false at end of input
+    bool nextRecord(std::vector<CsvField>& fields);
+
+    // Raw text of the record returned by the last nextRecord() call
+    std::string_view recordText() const { return std::string_view(recordBegin, recordEnd - recordBegin); }
+
+    // Start of the next unread record
+    const char* position() const { return pos; }
+
+    // Name of the scanning kernel in use ("avx2", "sse2" or "scalar")
+    static const char* kernelName();
+
+private:
+    const char* pos;
+    const char* end;
+    const char* recordBegin;
+    const char* recordEnd;
+};
+
+// Splits [begin, end) into up to `parts` ranges that each start at a record
+// boundary, for parsing them in parallel: the range starts followed by end.
+// Quotes are counted on up to `threads` threads.
+std::vector<const char*> splitAtRecords(const char* begin, const char* end, size_t parts, unsigned threads);
+
+// Field text helpers shared by the CSV-based loaders (rooms, calendars, sittings)
+std::string_view trim(std::string_view text); // Without leading and trailing whitespace
+bool equalsIgnoreCase(std::string_view a, std::string_view b); // ASCII case-insensitive
+
+#endif // CSVREADER_H
@@ -5,24 +5,55 @@
 #include <vector>
 #include <map>
 #include <utility>
-#include "LinkedList.h"
+#include "EntityStore.h"
 #include "Models.h"
+#include "StoreIndex.h"
+
+class SnapshotFile;
+
+// Wall-clock breakdown of the last importFromCSV() call, in milliseconds
+struct ImportTimings {
+    unsigned threads = 0;
+    size_t chunks = 0;
+    size_t rows = 0;
+    size_t bytes = 0;
+    double mapMs = 0;     // Opening and mapping the file
+    double splitMs = 0;   // Finding record-aligned chunk boundaries
+    double parseMs = 0;   // Parsing and per-chunk deduplication
+    double mergeMs = 0;   // Ordered merge into the entity store
+    double indexMs = 0;   // Building the query indexes (StoreIndex)
+    double totalMs = 0;
+};
 
 class DatabaseManager {
 public:
     DatabaseManager();
     ~DatabaseManager();
+    // The index points into the store, and generators keep a reference to the manager
+    DatabaseManager(const DatabaseManager&) = delete;
+    DatabaseManager& operator=(const DatabaseManager&) = delete;
 
     bool connect(const std::string& dsn, const std::string& username, const std::string& password);
-    bool importFromCSV(const std::string& filename);
+    // threadCount 0 uses every hardware thread; the result is identical for any count.
+    // With append, records are merged into previously imported CSV data instead of replacing it.
+    bool importFromCSV(const std::string& filename, unsigned threadCount = 1, bool append = false);
+    // Replaces the data with the dataset of an open snapshot (see Snapshot.h). The
+    // file is not parsed, but the tables own their strings, so every row is copied
+    // and its key re-interned: O(rows) hash inserts and string allocations (about
+    // 90 ms at 100k students). The timings report the snapshot's open time as mapMs
+    // and the copy as mergeMs.
+    bool loadSnapshot(const SnapshotFile& snapshot);
     void disconnect();
 
-    // Core data fetch methods
-    LinkedList<Course> fetchCourses();
-    LinkedList<Student> fetchStudents();
-    LinkedList<Enrollment> fetchEnrollments();
+    // Core data fetch methods (read-only views into the interned store)
+    const CourseTable& fetchCourses();
+    const StudentTable& fetchStudents();
+    const EnrollmentTable& fetchEnrollments();
+    const EntityStore& getStore() const { return store; }
+    // Rebuilt whenever the data is replaced, so it always matches getStore()
+    const StoreIndex& getIndex() const { return index; }
 
-    // GUI helper methods
+    // GUI helper methods, answered from the index
     std::vector<std::string> getCourseCodes();
     std::vector<std::string> getCourseNames();
     std::vector<std::pair<std::string, std::string>> getStudentList();
@@ -31,19 +62,22 @@ public:
     
     // Check if data is loaded from CSV
     bool isDataFromCSV() const { return csvDataLoaded; }
+    const ImportTimings& getLastImportTimings() const { return lastImport; }
 
 private:
     bool connected;
     bool csvDataLoaded;
     
-    // CSV data storage
-    LinkedList<Course> csvCourses;
-    LinkedList<Student> csvStudents;
-    LinkedList<Enrollment> csvEnrollments;
+    // Interned data of the active source (CSV import or mock database)
+    EntityStore store;
+    StoreIndex index;
+    ImportTimings lastImport;
     void* hEnv;   // Using void* to avoid including sql.h
     void* hDbc;   // Using void* to avoid including sql.h
     void* hStmt;  // Using void* to avoid including sql.h
     
+    void loadMockData();
+    bool hasData() const;
     bool checkSQLReturn(int ret, const std::string& operation);
     std::string getSQLError(short handleType, void* handle);
 };
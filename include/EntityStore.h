@@ -0,0 +1,154 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Models.h"
+
+// Sentinel returned by lookups for keys that were never interned
+constexpr uint32_t kInvalidId = 0xFFFFFFFFu;
+
+// Read-only, non-owning view over a contiguous column
+template<typename T>
+class ArrayView {
+public:
+    ArrayView() : ptr(nullptr), count(0) {}
+    ArrayView(const T* data, size_t size) : ptr(data), count(size) {}
+    ArrayView(const std::vector<T>& v) : ptr(v.data()), count(v.size()) {}
+
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+    const T* data() const { return ptr; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    const T* ptr;
+    size_t count;
+};
+
+// Maps each distinct string to a dense id (0, 1, 2, ...) in first-seen order.
+// Strings live in a deque so the string_view keys of the hash index stay valid.
+// A copy would keep keys pointing into the source's strings, so interners (and
+// the tables and stores holding them) can only be moved; moving keeps every
+// string where it is.
+class StringInterner {
+public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+    StringInterner(StringInterner&&) = default;
+    StringInterner& operator=(StringInterner&&) = default;
+
+    uint32_t intern(std::string_view s);
+    uint32_t find(std::string_view s) const;
+    const std::string& str(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+    void reserve(size_t n) { index.reserve(n); }
+    void clear();
+
+private:
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> index;
+};
+
+// Course columns; the course's dense id is its row index
+class CourseTable {
+public:
+    // Returns the id of the course, adding a row if the id is new
+    uint32_t add(std::string_view courseId, std::string_view name, std::string_view department);
+    uint32_t find(std::string_view courseId) const { return ids.find(courseId); }
+
+    size_t size() const { return ids.size(); }
+    const std::string& id(uint32_t c) const { return ids.str(c); }
+    const std::string& name(uint32_t c) const { return names[c]; }
+    const std::string& department(uint32_t c) const { return departments[c]; }
+    Course row(uint32_t c) const { return Course(id(c), name(c), department(c)); }
+
+    void reserve(size_t n);
+    void clear();
+
+private:
+    StringInterner ids;
+    std::vector<std::string> names;
+    std::vector<std::string> departments;
+};
+
+// Student columns; the student's dense id is its row index
+class StudentTable {
+public:
+    // Returns the id of the student, adding a row if the roll number is new
+    uint32_t add(std::string_view rollNo, std::string_view name, int semester,
+                 std::string_view batch, std::string_view program);
+    uint32_t find(std::string_view rollNo) const { return rollNos.find(rollNo); }
+
+    size_t size() const { return rollNos.size(); }
+    const std::string& rollNo(uint32_t s) const { return rollNos.str(s); }
+    const std::string& name(uint32_t s) const { return names[s]; }
+    int semester(uint32_t s) const { return semesters[s]; }
+    const std::string& batch(uint32_t s) const { return batches[s]; }
+    const std::string& program(uint32_t s) const { return programs[s]; }
+    Student row(uint32_t s) const;
+
+    void reserve(size_t n);
+    void clear();
+
+private:
+    StringInterner rollNos;
+    std::vector<std::string> names;
+    std::vector<int> semesters;
+    std::vector<std::string> batches;
+    std::vector<std::string> programs;
+};
+
+// Enrollments as two parallel arrays of student and course ids
+class EnrollmentTable {
+public:
+    void add(uint32_t student, uint32_t course) {
+        students.push_back(student);
+        courses.push_back(course);
+    }
+
+    // Bulk fill: resize once, then set rows independently (e.g. from several threads)
+    void resize(size_t n) {
+        students.resize(n);
+        courses.resize(n);
+    }
+    void set(size_t i, uint32_t student, uint32_t course) {
+        students[i] = student;
+        courses[i] = course;
+    }
+
+    size_t size() const { return students.size(); }
+    uint32_t student(size_t i) const { return students[i]; }
+    uint32_t course(size_t i) const { return courses[i]; }
+    ArrayView<uint32_t> studentIds() const { return ArrayView<uint32_t>(students); }
+    ArrayView<uint32_t> courseIds() const { return ArrayView<uint32_t>(courses); }
+
+    void reserve(size_t n);
+    void clear();
+
+private:
+    std::vector<uint32_t> students;
+    std::vector<uint32_t> courses;
+};
+
+// All entities of one data source, interned once at load time
+class EntityStore {
+public:
+    CourseTable courses;
+    StudentTable students;
+    EnrollmentTable enrollments;
+
+    // Adds an enrollment by key; returns false if the student or course is unknown
+    bool addEnrollment(std::string_view rollNo, std::string_view courseId);
+    void clear();
+};
+
+#endif // ENTITYSTORE_H
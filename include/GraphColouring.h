@@ -0,0 +1,21 @@
+#ifndef GRAPHCOLOURING_H
+#define GRAPHCOLOURING_H
+
+#include <cstdint>
+#include <vector>
+#include "ConflictGraph.h"
+
+struct Colouring {
+    std::vector<uint32_t> colour; // Colour per course, kInvalidId for skipped courses
+    uint32_t colourCount = 0;
+};
+
+// DSatur colouring of the conflict graph: repeatedly colours the uncoloured
+// course with the most distinct neighbour colours (ties: higher degree, then
+// larger course, then lower id) with the smallest colour free among its
+// neighbours. The candidates are kept in an ordered set that is updated as
+// saturation changes, giving O((V + E) log V) overall.
+// Courses with include[c] == false are left uncoloured.
+Colouring colourDSatur(const ConflictGraph& graph, const std::vector<bool>& include);
+
+#endif // GRAPHCOLOURING_H
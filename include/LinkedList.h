@@ -1,108 +1,286 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
 template<typename T>
 struct Node {
     T data;
     Node* next;
-    
+
     Node(const T& value) : data(value), next(nullptr) {}
+
+    template<typename... Args>
+    Node(std::in_place_t, Args&&... args) : data(std::forward<Args>(args)...), next(nullptr) {}
+};
+
+// Slab allocator for list nodes: nodes are carved out of chunks that double in
+// size (up to kMaxChunk nodes), so filling a list costs O(log n) heap
+// allocations instead of one per element, and neighbouring nodes share cache
+// lines. Nodes are only released all together; the list never frees one alone.
+template<typename T>
+class NodePool {
+public:
+    NodePool() : used(0), capacity(0), nextChunk(kFirstChunk) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool&& other) noexcept { steal(other); }
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            chunks.clear();
+            steal(other);
+        }
+        return *this;
+    }
+
+    // Uninitialised storage for one node
+    void* allocate() {
+        if (used == capacity) {
+            chunks.emplace_back(new Slot[nextChunk]);
+            used = 0;
+            capacity = nextChunk;
+            nextChunk = nextChunk < kMaxChunk ? nextChunk * 2 : kMaxChunk;
+        }
+        return &chunks.back()[used++];
+    }
+
+    // Sizes the next chunk for at least `count` more nodes
+    void reserve(size_t count) {
+        if (capacity - used < count && count > nextChunk) {
+            nextChunk = count;
+        }
+    }
+
+    // Frees every chunk; the nodes must already be destroyed
+    void release() {
+        chunks.clear();
+        used = 0;
+        capacity = 0;
+        nextChunk = kFirstChunk;
+    }
+
+private:
+    static constexpr size_t kFirstChunk = 16;
+    static constexpr size_t kMaxChunk = 4096;
+
+    struct Slot {
+        alignas(Node<T>) unsigned char bytes[sizeof(Node<T>)];
+    };
+
+    void steal(NodePool& other) {
+        chunks = std::move(other.chunks);
+        used = other.used;
+        capacity = other.capacity;
+        nextChunk = other.nextChunk;
+        other.chunks.clear();
+        other.used = 0;
+        other.capacity = 0;
+        other.nextChunk = kFirstChunk;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    size_t used;        // Slots handed out from the last chunk
+    size_t capacity;    // Slots in the last chunk
+    size_t nextChunk;
 };
 
+// Singly linked list with tail insertion. Nodes come from the list's own
+// NodePool; copies are deep and moves take over the nodes in O(1).
 template<typename T>
 class LinkedList {
 private:
     Node<T>* head;
     Node<T>* tail;
     int size;
-    
+    NodePool<T> pool;
+
+    template<typename Value, typename NodeType>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        explicit Iterator(NodeType* node = nullptr) : node(node) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        Iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            node = node->next;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        NodeType* node;
+    };
+
+    void link(Node<T>* newNode) {
+        if (tail == nullptr) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            tail = newNode;
+        }
+        size++;
+    }
+
+    void copyFrom(const LinkedList& other) {
+        pool.reserve(static_cast<size_t>(other.size));
+        for (const T& value : other) {
+            insertAtEnd(value);
+        }
+    }
+
+    void stealFrom(LinkedList& other) noexcept {
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        pool = std::move(other.pool);
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
     // Helper function to swap data of two nodes
     void swap(Node<T>* a, Node<T>* b) {
-        T temp = a->data;
-        a->data = b->data;
-        b->data = temp;
+        using std::swap;
+        swap(a->data, b->data);
     }
 
-    // Helper function to partition the list and return pivot node
-    Node<T>* partition(Node<T>* low, Node<T>* high) {
+    // Lomuto partition of [low, high] around high's value. Returns the pivot's
+    // node and sets beforePivot to its predecessor inside the range (nullptr if
+    // the pivot ends up first), so the caller needs no rescan from head.
+    Node<T>* partition(Node<T>* low, Node<T>* high, Node<T>*& beforePivot) {
+        beforePivot = nullptr;
         if (low == high || low == nullptr || high == nullptr)
             return low;
 
-        T pivot = high->data;
-        Node<T>* i = low->next;
-        Node<T>* j = low;
-
-        while (i != high->next) {
-            if (i->data < pivot) {
-                j = j->next;
-                swap(i, j);
+        Node<T>* boundary = nullptr; // Last node holding a value below the pivot
+        for (Node<T>* i = low; i != high; i = i->next) {
+            if (i->data < high->data) {
+                boundary = boundary == nullptr ? low : boundary->next;
+                swap(i, boundary);
             }
-            i = i->next;
         }
-        swap(j, high);
-        return j;
+        Node<T>* pivot = boundary == nullptr ? low : boundary->next;
+        swap(pivot, high);
+        beforePivot = boundary;
+        return pivot;
     }
 
     // Helper function for quickSort
     void quickSortRecursive(Node<T>* low, Node<T>* high) {
-        if (low != nullptr && high != nullptr && low != high && low != high->next) {
-            Node<T>* pivot = partition(low, high);
-            Node<T>* temp = head;
-            
-            while (temp != nullptr && temp->next != pivot) {
-                temp = temp->next;
+        // Recurse into the left part, loop on the right one
+        while (low != nullptr && high != nullptr && low != high) {
+            Node<T>* beforePivot = nullptr;
+            Node<T>* pivot = partition(low, high, beforePivot);
+            if (beforePivot != nullptr) {
+                quickSortRecursive(low, beforePivot);
             }
-            
-            if (temp != nullptr) {
-                quickSortRecursive(low, temp);
+            if (pivot == high) {
+                return;
             }
-            
-            quickSortRecursive(pivot->next, high);
+            low = pivot->next;
         }
     }
 
 public:
+    using iterator = Iterator<T, Node<T>>;
+    using const_iterator = Iterator<const T, const Node<T>>;
+
     LinkedList() : head(nullptr), tail(nullptr), size(0) {}
-    
+
+    LinkedList(const LinkedList& other) : head(nullptr), tail(nullptr), size(0) {
+        copyFrom(other);
+    }
+
+    LinkedList(LinkedList&& other) noexcept : head(nullptr), tail(nullptr), size(0) {
+        stealFrom(other);
+    }
+
+    LinkedList& operator=(const LinkedList& other) {
+        if (this != &other) {
+            LinkedList copy(other);
+            clear();
+            stealFrom(copy);
+        }
+        return *this;
+    }
+
+    LinkedList& operator=(LinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
     ~LinkedList() {
+        clear();
+    }
+
+    void clear() {
         Node<T>* current = head;
         while (current != nullptr) {
             Node<T>* next = current->next;
-            delete current;
+            current->~Node<T>();
             current = next;
         }
+        pool.release();
+        head = tail = nullptr;
+        size = 0;
     }
-    
+
     void insertAtEnd(const T& value) {
-        Node<T>* newNode = new Node<T>(value);
-        if (tail == nullptr) {
-            head = tail = newNode;
-        } else {
-            tail->next = newNode;
-            tail = newNode;
-        }
-        size++;
+        link(new (pool.allocate()) Node<T>(value));
+    }
+
+    // Constructs the element in place at the end of the list
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        Node<T>* newNode = new (pool.allocate()) Node<T>(std::in_place, std::forward<Args>(args)...);
+        link(newNode);
+        return newNode->data;
     }
-    
+
     Node<T>* getHead() const {
         return head;
     }
-    
+
     int getSize() const {
         return size;
     }
 
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+
     // Public quickSort function
     void quickSort() {
         if (head == nullptr || head->next == nullptr)
             return;
 
-        Node<T>* temp = head;
-        while (temp->next != nullptr)
-            temp = temp->next;
-
-        quickSortRecursive(head, temp);
+        quickSortRecursive(head, tail);
     }
 };
 
-#endif // LINKEDLIST_H
\ No newline at end of file
+#endif // LINKEDLIST_H
@@ -0,0 +1,98 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+// Process-wide asynchronous log. A line is formatted on the calling thread into a
+// thread-local buffer and copied into a fixed ring of slots (a bounded
+// multi-producer queue with per-slot sequence numbers, no locks). One writer
+// thread drains the ring in batches: one write per sink per batch, to the console
+// and to a log file that stays open. When the ring is full producers wait for the
+// writer instead of dropping lines. Lines longer than kLogLineBytes are cut.
+//
+// Every sink has its own minimum level; a line below all of them is never
+// formatted (see LOG). Console lines are the message, prefixed with the level
+// unless it is Info; file lines always carry the level and a UTC timestamp.
+constexpr size_t kLogLineBytes = 480;
+
+namespace Log {
+
+// Console sink. With stream nullptr, Debug and Info go to stdout and Warning and
+// Error to stderr; otherwise every line goes to stream. Default: Info, split.
+void setConsole(LogLevel minimum, std::FILE* stream = nullptr);
+// Opens the file sink, truncating unless append; false (sink closed) on error
+bool openFile(const std::string& filename, LogLevel minimum = LogLevel::Debug, bool append = false);
+void closeFile();
+
+// Lowest level any sink accepts
+extern std::atomic<uint8_t> threshold;
+inline bool enabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >= threshold.load(std::memory_order_relaxed);
+}
+
+void write(LogLevel level, std::string_view message);
+// Returns once every line written before the call has reached the sinks
+void flush();
+// Drains the ring and stops the writer thread; later lines are written directly.
+// Runs automatically at exit.
+void shutdown();
+
+} // namespace Log
+
+// One line for the LOG macro; the text is sent when the statement ends
+class LogLine {
+public:
+    explicit LogLine(LogLevel level);
+    ~LogLine();
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    std::ostream& stream() { return out; }
+
+private:
+    LogLevel level;
+    std::ostream& out;
+};
+
+// Lets the first `burst` occurrences of a repeated message through and counts the
+// rest, so a warning per skipped row cannot flood the log. Thread-safe; report
+// suppressed() once the repeating work is done.
+class LogLimiter {
+public:
+    explicit LogLimiter(uint32_t burst) : burst(burst), seen(0) {}
+
+    bool allow() { return seen.fetch_add(1, std::memory_order_relaxed) < burst; }
+    uint64_t suppressed() const {
+        const uint64_t count = seen.load(std::memory_order_relaxed);
+        return count > burst ? count - burst : 0;
+    }
+
+private:
+    uint32_t burst;
+    std::atomic<uint64_t> seen;
+};
+
+// LOG(LogLevel::Info) << "Imported " << n << " rows";
+// Must not be nested inside another LOG statement on the same thread.
+#define LOG(level) \
+    if (!Log::enabled(level)) {} else LogLine(level).stream()
+
+// As LOG, but only while the limiter allows it
+#define LOG_LIMITED(limiter, level) \
+    if (!Log::enabled(level) || !(limiter).allow()) {} else LogLine(level).stream()
+
+#endif // LOGGER_H
@@ -0,0 +1,49 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Resolves a requested thread count: 0 means "all hardware threads"
+inline unsigned resolveThreadCount(unsigned requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw != 0 ? hw : 1;
+}
+
+// Splits [0, count) into contiguous ranges and calls fn(begin, end, worker)
+// for each one, worker 0 on the calling thread and the rest on new threads.
+template<typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn&& fn) {
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(std::max(1u, threads), std::max<size_t>(count, 1)));
+    if (workers <= 1) {
+        fn(size_t(0), count, 0u);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    size_t step = count / workers;
+    size_t extra = count % workers;
+    size_t begin = 0;
+    size_t firstEnd = 0;
+    for (unsigned w = 0; w < workers; w++) {
+        size_t end = begin + step + (w < extra ? 1 : 0);
+        if (w == 0) {
+            firstEnd = end;
+        } else {
+            pool.emplace_back([&fn, begin, end, w]() { fn(begin, end, w); });
+        }
+        begin = end;
+    }
+    fn(size_t(0), firstEnd, 0u);
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,71 @@
+#ifndef PDFWRITER_H
+#define PDFWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal streaming PDF 1.4 writer. Every object goes to disk as soon as it is
+// complete and its byte offset is recorded for the xref table, so memory use is
+// bounded by one content stream. Content streams are Flate-compressed when the
+// build has zlib (HAVE_ZLIB), otherwise they are written as plain text.
+// All pages share one resource dictionary: Helvetica as /F1 plus the forms.
+
+// A content stream encoded ahead of time, e.g. on a worker thread
+struct PdfStream {
+    std::string data;
+    bool deflated = false;
+};
+
+class PdfWriter {
+public:
+    PdfWriter();
+    ~PdfWriter();
+
+    bool open(const std::string& filename, double pageWidth = 612, double pageHeight = 792);
+
+    // Reusable Form XObject, drawn from page content with "/<name> Do".
+    // Must be added before the first page that uses it.
+    void addForm(const std::string& name, const std::string& content,
+                 double left, double bottom, double right, double top);
+    void addForm(const std::string& name, const PdfStream& content,
+                 double left, double bottom, double right, double top);
+
+    void addPage(const std::string& content);
+    void addPage(const PdfStream& content);
+
+    // Compresses a content stream without a writer; safe to call from any thread
+    static PdfStream encodeStream(std::string content);
+
+    // Writes the page tree, resources, xref table and trailer; false on I/O error
+    bool close();
+
+    bool isOpen() const { return file.is_open(); }
+    int pageCount() const { return static_cast<int>(pageIds.size()); }
+    uint64_t bytesWritten() const { return offset; }
+
+    // Escapes a string for use inside a PDF literal "(...)"
+    static std::string escapeText(const std::string& text);
+
+private:
+    std::ofstream file;
+    uint64_t offset;
+    double width;
+    double height;
+    std::vector<uint64_t> objectOffsets; // Index = object number, 0 unused
+    std::vector<uint32_t> pageIds;
+    std::vector<std::pair<std::string, uint32_t>> forms;
+    std::string compressed;              // Scratch buffer reused across streams
+
+    uint32_t newObject();
+    void beginObject(uint32_t id);
+    void write(const std::string& text);
+    void writeStream(uint32_t id, const std::string& dictionary, const std::string& content);
+    void writeEncoded(uint32_t id, const std::string& dictionary, const std::string& data, bool deflated);
+    void writePage(uint32_t contentId);
+    static bool deflate(const std::string& content, std::string& out);
+};
+
+#endif // PDFWRITER_H
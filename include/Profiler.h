@@ -0,0 +1,112 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped timers and counters for the engine's hot paths. Each instrumented site
+// is a static ProfileSite; sites with the same name are reported together.
+// Totals live in per-thread tables of relaxed atomics, so counting never takes a
+// lock; timed scopes are also appended, under an uncontended per-thread lock, to
+// a trace (up to kMaxProfileEvents per thread) for a Chrome trace-event file.
+//
+// Recording is off until Profiler::setEnabled(true); while off a site costs one
+// relaxed load. Builds without HAVE_PROFILING compile the macros away.
+constexpr uint32_t kMaxProfileSites = 256;
+constexpr size_t kMaxProfileEvents = 1 << 16;
+
+enum class ProfileKind : uint8_t {
+    Timer,
+    Counter
+};
+
+class ProfileSite {
+public:
+    ProfileSite(const char* name, ProfileKind kind);
+
+    uint32_t index;             // Shared by every site with this name
+};
+
+// Totals of one name over all threads
+struct ProfileStat {
+    std::string name;
+    ProfileKind kind = ProfileKind::Timer;
+    uint64_t calls = 0;         // Scopes completed, or increments
+    uint64_t value = 0;         // Counter total
+    double totalMs = 0;
+    double minMs = 0;
+    double maxMs = 0;
+};
+
+namespace Profiler {
+
+extern std::atomic<bool> active;
+inline bool enabled() {
+    return active.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool enable);
+// Clears all totals and events; call while no instrumented code is running
+void reset();
+
+uint64_t nowNs();
+void recordScope(const ProfileSite& site, uint64_t startNs, uint64_t endNs);
+void add(const ProfileSite& site, uint64_t amount);
+
+// Sites that recorded anything, by name
+std::vector<ProfileStat> stats();
+uint64_t droppedEvents();
+
+// {"enabled": ..., "droppedEvents": N, "stats": [{"name": ..., "kind": "timer", ...}]}
+std::string statsJson();
+// false if the file cannot be written
+bool writeStatsJson(const std::string& filename);
+// Trace-event JSON for chrome://tracing or Perfetto: one complete ("X") event per
+// timed scope and one counter ("C") event per counter with its total
+bool writeChromeTrace(const std::string& filename);
+
+} // namespace Profiler
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const ProfileSite& site)
+        : site(site), start(Profiler::enabled() ? Profiler::nowNs() : 0) {}
+    ~ProfileScope() {
+        if (start != 0) {
+            Profiler::recordScope(site, start, Profiler::nowNs());
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const ProfileSite& site;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef HAVE_PROFILING
+// Times the rest of the enclosing block: PROFILE_SCOPE("import.parse");
+#define PROFILE_SCOPE(name) \
+    static const ProfileSite PROFILE_CONCAT(profileSite, __LINE__)(name, ProfileKind::Timer); \
+    ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileSite, __LINE__))
+
+// Adds amount to a counter: PROFILE_COUNT("import.rows", rows);
+#define PROFILE_COUNT(name, amount) \
+    do { \
+        if (Profiler::enabled()) { \
+            static const ProfileSite profileCounter(name, ProfileKind::Counter); \
+            Profiler::add(profileCounter, static_cast<uint64_t>(amount)); \
+        } \
+    } while (0)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_COUNT(name, amount) do {} while (0)
+#endif
+
+#endif // PROFILER_H
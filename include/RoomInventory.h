@@ -0,0 +1,195 @@
+#ifndef ROOMINVENTORY_H
+#define ROOMINVENTORY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "CivilDate.h"
+
+enum class RoomType {
+    Classroom,
+    Lab,
+    Hall
+};
+
+struct Room {
+    std::string name;
+    uint32_t capacity = 0;
+    RoomType type = RoomType::Classroom;
+    uint8_t weekdays = 0x7F; // Open days, bit 0 = Monday ... bit 6 = Sunday
+};
+
+// The rooms exams can be held in. Schedule entries refer to a room by its
+// position in the inventory plus one, so the order of the rooms is also the
+// order of the timetable's room columns.
+//
+// Rooms CSV layout, one room per line after the header:
+//   Name,Capacity,Type,Days
+//   Main Hall,400,Hall,Mon-Fri
+//   Lab 3,30,Lab,Mon;Wed;Fri
+// Type is Classroom, Lab or Hall (default Classroom); Days is All (default),
+// a day range such as Mon-Fri, or days separated by ';'.
+class RoomInventory {
+public:
+    static constexpr uint8_t kEveryDay = 0x7F;
+
+    // Room#1-#11 and Lab1-Lab4 with 55 seats each, open every day
+    static RoomInventory standardCampus();
+
+    // Replaces the inventory with the rooms in the file; false (inventory unchanged) on error
+    bool loadFromCSV(const std::string& filename);
+
+    void addRoom(const Room& room);
+    void clear() { rooms.clear(); }
+
+    size_t size() const { return rooms.size(); }
+    bool empty() const { return rooms.empty(); }
+    const Room& room(uint32_t index) const { return rooms[index]; }
+    const std::vector<Room>& getRooms() const { return rooms; }
+
+    bool isOpen(uint32_t index, int32_t date) const { return (rooms[index].weekdays >> weekdayFromDays(date)) & 1; }
+    uint32_t largestCapacity() const;
+    uint32_t smallestCapacity() const;
+    uint64_t seatsOn(int weekday) const;    // Seats of the rooms open on that weekday, 0 = Monday
+    uint64_t maxSeatsPerDay() const;        // Best weekday
+
+    static const char* typeName(RoomType type);
+
+private:
+    std::vector<Room> rooms;
+};
+
+// Packs courses into the rooms open on one exam day. Rooms are kept in an index
+// ordered by decreasing capacity (ties in inventory order), with two skip lists
+// over it that find the largest free room and the smallest free room holding a
+// given number of students in near-constant time, so packing a course costs
+// O(sessions) rather than O(rooms).
+class RoomAllocator {
+public:
+    explicit RoomAllocator(const RoomInventory& inventory);
+
+    // Frees every room open on the date; false if none is
+    bool openDay(int32_t date);
+
+    uint64_t freeSeats() const { return free; }
+    bool hasBookings() const { return booked; }
+
+    // Seats `students` in as few rooms as possible: the largest free rooms until the
+    // rest fits in one, then the smallest free room that holds the rest (best fit).
+    // Appends (inventory index, seats) pairs in seating order. Returns false and
+    // takes nothing if the free rooms cannot hold everyone.
+    bool allocate(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions);
+
+    // Takes every free room, largest first, seating up to `students`
+    void takeAll(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions);
+
+    // Takes one room by inventory index; false if it is closed or already taken
+    bool reserve(uint32_t index);
+
+private:
+    uint32_t firstFreeFrom(uint32_t pos);   // Smallest free position >= pos, or size
+    uint32_t lastFreeUpTo(uint32_t pos);    // Largest free position < pos, plus one; 0 if none
+    void take(uint32_t pos);
+
+    const RoomInventory& inventory;
+    std::vector<uint32_t> order;            // Inventory indices by decreasing capacity
+    std::vector<uint32_t> position;         // Position per inventory index (inverse of order)
+    std::vector<uint32_t> capacity;         // Capacity per position
+    std::vector<uint32_t> groupStart;       // First position with the same capacity
+    std::vector<uint32_t> nextFree;         // Skip list towards larger positions
+    std::vector<uint32_t> prevFree;         // Skip list towards smaller positions, shifted by one
+    uint64_t free;
+    bool booked;
+};
+
+// Room sharing: seats several courses of one day in the same room, up to its
+// capacity. The day's courses are queued, then packed first-fit decreasing:
+// largest course first, each into the first partly filled room with enough free
+// seats, otherwise into the smallest empty room that holds it. A course no single
+// room can take is split, filling the room with the most free seats first (the
+// repair step), so every queue that fits the day's free seats gets packed.
+// Packing costs O(courses x rooms) per day.
+class SharedRoomPacker {
+public:
+    // One course's share of a room
+    struct Seating {
+        uint32_t item;   // Caller's id, e.g. the course
+        uint32_t room;   // Inventory index
+        uint32_t first;  // Offset of the first seated student within the item
+        uint32_t seats;
+    };
+
+    explicit SharedRoomPacker(const RoomInventory& inventory);
+
+    // Empties the rooms open on the date and the queue; false if no room is open
+    bool openDay(int32_t date);
+
+    uint64_t freeSeats() const { return free; } // Open seats neither taken nor queued
+    bool hasBookings() const { return booked; }
+
+    // Takes seats in one room, e.g. for a session that keeps its room; false if
+    // the room is closed or has fewer free seats
+    bool reserve(uint32_t index, uint32_t seats);
+
+    // Takes whole rooms, largest first, seating up to `students`
+    void takeAll(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions);
+
+    // Queues `students` of an item, starting at offset `first`; false and nothing
+    // queued if they exceed freeSeats()
+    bool queue(uint32_t item, uint32_t first, uint32_t students);
+
+    // Packs and clears the queue. Appends the seatings item by item, largest item
+    // first; an item's seatings are in student order.
+    void pack(std::vector<Seating>& seatings);
+
+private:
+    struct Pending {
+        uint32_t item;
+        uint32_t first;
+        uint32_t students;
+    };
+
+    uint32_t fitRoom(uint32_t students) const;  // Inventory index, or size() if no room holds them alone
+    void seat(uint32_t index, uint32_t seats);
+
+    const RoomInventory& inventory;
+    std::vector<uint32_t> order;                // Inventory indices by decreasing capacity
+    std::vector<uint32_t> left;                 // Free seats per inventory index, 0 when closed
+    std::vector<uint8_t> used;                  // Room holds a seating today
+    std::vector<uint32_t> usedOrder;            // Partly or fully used rooms, in order of first use
+    std::vector<Pending> pending;
+    uint64_t free;
+    bool booked;
+};
+
+// Booked time intervals of every room, for rooms that hold several sittings a
+// day and exams of different lengths. A booking is [start, end) in minutes since
+// 01-01-1970 with a seat count; bookings with the same interval are merged. Each
+// room keeps its bookings sorted by start, and with the room's longest booking as
+// bound an overlap query is one binary search plus a scan of the bookings that
+// can reach the interval: O(log n + k). Bookings made in time order, as the
+// generator makes them, are appended without moving the others.
+class RoomTimeline {
+public:
+    void reset(size_t rooms);
+
+    // Adds `seats` (negative to release) to the room's booking for [start, end)
+    void book(uint32_t room, int32_t start, int32_t end, int32_t seats);
+
+    // Seats of the room's bookings that overlap [start, end); 0 = the room is free
+    uint32_t seatsBooked(uint32_t room, int32_t start, int32_t end) const;
+
+private:
+    struct Booking {
+        int32_t start;
+        int32_t end;
+        int32_t seats;
+    };
+
+    std::vector<std::vector<Booking>> rooms;  // By inventory index, sorted by (start, end)
+    std::vector<int32_t> longest;             // Longest booking per room, never shrinks
+};
+
+#endif // ROOMINVENTORY_H
@@ -0,0 +1,89 @@
+#ifndef SCHEDULEOPTIMISER_H
+#define SCHEDULEOPTIMISER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "ConflictGraph.h"
+
+// Settings of the optimiser pass. The weights price one unit of each term of the
+// objective; the defaults make a same-day clash worth five exam days.
+struct OptimiserConfig {
+    double seconds = 5.0;           // Wall-clock budget; the best schedule so far is kept when it runs out
+    unsigned threads = 0;           // Independent annealing chains, 0 = one per hardware thread
+    int maxDays = 0;                // Days courses may move to, 0 = the current exam period
+    uint64_t seed = 1;
+
+    double examDayWeight = 20;      // Per day of the exam period (last used day)
+    double clashWeight = 100;       // Per student pair of exams on the same day
+    double backToBackWeight = 5;    // Per student pair of exams on consecutive days
+    double emptySeatWeight = 10;    // Per exam day, times the share of its seats left empty
+    double overflowWeight = 100;    // Per seat booked beyond a day's capacity
+};
+
+// Objective terms of one course -> day assignment
+struct ScheduleScore {
+    int examDays = 0;
+    uint64_t clashes = 0;           // Student pairs of exams on the same day
+    uint64_t backToBack = 0;        // Student pairs of exams on consecutive days
+    double emptySeats = 0;          // Sum over exam days of the empty share of their seats
+    uint64_t overflowSeats = 0;     // Seats booked beyond the capacity of their day
+    double energy = 0;              // Weighted sum, lower is better
+};
+
+struct OptimiserReport {
+    ScheduleScore initial;
+    ScheduleScore best;
+    unsigned chains = 0;
+    uint64_t moves = 0;             // Proposed moves over all chains
+    uint64_t accepted = 0;
+    double ms = 0;
+    bool cancelled = false;         // Stopped early; best is still the best schedule found
+};
+
+// The course -> day assignment to improve. Courses that must keep their sessions
+// (for example ones spread over several days) are not movable: they add their
+// seats to fixedDemand, mark their days as used, and clash with the movable
+// courses that share students with them on those days. The clash terms come
+// from the conflict graph, whose edge weight is the number of shared students.
+// With several sittings a day the generator passes exam slots as the days.
+struct AnnealingProblem {
+    const ConflictGraph* conflicts = nullptr;
+    std::vector<int32_t> courseDay;     // Day per course, 1-based; ignored for fixed courses
+    std::vector<uint8_t> movable;       // 1 if the optimiser may change the course's day
+    std::vector<uint64_t> footprint;    // Seats of the rooms the course fills on its own
+    std::vector<uint64_t> dayCapacity;  // Seats open per day, index 1..days (0 unused)
+    std::vector<uint64_t> fixedDemand;  // Seats booked by fixed courses per day, same indexing
+    std::vector<uint32_t> fixedCount;   // Fixed courses per day, same indexing
+    // Days each fixed course holds sessions on, ascending (CSR over course ids; empty
+    // runs for movable courses). Conflict edges to fixed courses are priced from these.
+    std::vector<uint32_t> fixedDayOffsets;
+    std::vector<int32_t> fixedDays;
+
+    int days() const { return static_cast<int>(dayCapacity.size()) - 1; }
+};
+
+struct AnnealingResult {
+    std::vector<int32_t> courseDay;
+    OptimiserReport report;
+};
+
+// Exact score of an assignment, O(courses + edges)
+ScheduleScore scoreAssignment(const AnnealingProblem& problem, const std::vector<int32_t>& courseDay,
+                              const OptimiserConfig& config);
+
+// Simulated annealing over course days. Each chain proposes moves of one course
+// to another open day, or swaps of two courses' days, and accepts worse ones with
+// probability exp(-delta / T) under a geometric cooling schedule stretched over
+// the time budget. The delta of a move only reads the moved course's conflict
+// edges and two days' totals, so a move costs O(degree) no matter how large the
+// timetable is. Chains are independent (own state and random stream) and run on
+// separate threads; the best assignment over all chains is returned.
+// `cancel` stops every chain at its next clock check; `progress` is called from
+// the first chain with the elapsed share of the budget, 0-100.
+AnnealingResult annealSchedule(const AnnealingProblem& problem, const OptimiserConfig& config,
+                               const std::atomic<bool>* cancel = nullptr,
+                               const std::function<void(int)>& progress = nullptr);
+
+#endif // SCHEDULEOPTIMISER_H
@@ -0,0 +1,58 @@
+#ifndef SITTINGPLAN_H
+#define SITTINGPLAN_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// One exam time slot of every exam day
+struct Sitting {
+    std::string name;
+    int32_t start = 0;      // Minutes after midnight
+    int32_t length = 0;     // Minutes; courses without a duration of their own run this long
+};
+
+// The sittings of an exam day and the exam durations of courses. An exam slot is
+// one sitting of one exam day; schedules number slots from 1 in time order, so
+// with a single sitting the slot number is the day number.
+//
+// Sittings text: comma-separated [Name=]HH:MM-HH:MM ranges, e.g.
+//   Morning=09:00-12:00,Afternoon=14:00-17:00,Evening=18:00-21:00
+// Durations CSV, one course per line after the header:
+//   Course,Minutes
+//   CS-101,120
+class SittingPlan {
+public:
+    static constexpr int32_t kMaxMinutes = 12 * 60; // Longest sitting or exam
+
+    // 2:00 PM - 5:00 PM, the single sitting of the original timetable
+    static SittingPlan singleAfternoon();
+    // 1-3 three-hour sittings: the afternoon, then the morning (9:00 AM) and the evening (6:00 PM)
+    static SittingPlan standardDay(int sittings);
+
+    // Replaces the sittings; false (plan unchanged) if malformed or overlapping
+    bool parse(std::string_view text);
+    // false if the sitting overlaps another or runs past midnight; kept in start order
+    bool addSitting(const Sitting& sitting);
+
+    // Adds the durations in the file; false (durations unchanged) on error
+    bool loadDurations(const std::string& filename);
+    void setCourseDuration(const std::string& course, int32_t minutes);
+    void clearCourseDurations() { courseMinutes.clear(); }
+    size_t durationCount() const { return courseMinutes.size(); }
+    // The course's own duration, or 0 if it runs the length of its sitting
+    int32_t courseDuration(const std::string& course) const;
+
+    size_t size() const { return sittings.size(); }
+    const Sitting& sitting(uint32_t index) const { return sittings[index]; }
+    const std::vector<Sitting>& getSittings() const { return sittings; }
+    std::string timeRange(uint32_t index) const; // "2:00 PM - 5:00 PM"
+
+private:
+    std::vector<Sitting> sittings;
+    std::unordered_map<std::string, int32_t> courseMinutes;
+};
+
+#endif // SITTINGPLAN_H
@@ -0,0 +1,174 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "CsvReader.h"
+#include "EntityStore.h"
+
+class TimetableGenerator;
+
+// Binary snapshot of a dataset and, optionally, its generated schedule.
+//
+// Layout (little-endian, fixed-width fields):
+//   SnapshotHeader
+//   SnapshotSectionEntry[sectionCount]
+//   section payloads, each starting on a 64-byte boundary
+// The header checksum covers the header (with the checksum field zeroed) and
+// the section table; every section has its own payload checksum. A text column
+// is one section: uint64 count, uint64 offsets[count + 1], then the characters.
+// Everything else is a plain array of fixed-size records, so opening a snapshot
+// maps the file and hands out views; nothing is parsed.
+//
+// Version 2 stores ScheduleEntry records with their sitting and duration;
+// version 1 files (SnapshotEntryV1, one daily sitting) are still read.
+constexpr uint32_t kSnapshotVersion = 2;
+constexpr uint32_t kSnapshotOldestVersion = 1;
+constexpr size_t kSnapshotAlignment = 64;
+
+enum class SnapshotSection : uint32_t {
+    CourseIds = 1,
+    CourseNames,
+    CourseDepartments,
+    StudentRollNos,
+    StudentNames,
+    StudentSemesters,       // int32 per student
+    StudentBatches,
+    StudentPrograms,
+    EnrollmentStudents,     // uint32 per enrollment
+    EnrollmentCourses,      // uint32 per enrollment
+    ScheduleInfo,           // One SnapshotScheduleInfo; absent if no schedule was saved
+    ScheduleEntries,        // ScheduleEntry records; SnapshotEntryV1 in version 1 files
+    RoomNames,
+    Rooms,                  // SnapshotRoom per room
+    Holidays,               // int32 day numbers
+    ConflictOffsets,        // uint64, courses + 1
+    ConflictNeighbours,     // uint32 per directed edge
+    ConflictWeights,        // uint32 per directed edge
+    ConflictCourseSizes,    // uint32 per course
+    SittingNames,
+    Sittings                // SnapshotSitting per sitting; absent before sittings (one 2:00 PM sitting)
+};
+
+struct SnapshotHeader {
+    char magic[8];              // "TTSNAP\r\n"
+    uint32_t version;
+    uint32_t byteOrder;         // 0x01020304 as written by the producing machine
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t checksum;          // Header and section table
+};
+
+struct SnapshotSectionEntry {
+    uint32_t id;
+    uint32_t elementSize;       // 1 for text columns
+    uint64_t offset;            // From the start of the file
+    uint64_t bytes;
+    uint64_t checksum;
+};
+
+struct SnapshotScheduleInfo {
+    int32_t startDay;           // Days since 01-01-1970
+    uint32_t mode;              // SchedulingMode
+    uint32_t weekend;           // ExamCalendar weekend mask
+    uint32_t flags;             // kSnapshotRoomSharing; 0 in files written before room sharing
+};
+
+constexpr uint32_t kSnapshotRoomSharing = 1;
+
+struct SnapshotSitting {
+    int32_t start;              // Minutes after midnight
+    int32_t length;
+};
+
+// Schedule entry of version 1 files, written before sittings: every exam in the one daily sitting
+struct SnapshotEntryV1 {
+    int32_t dayIndex;
+    int32_t date;
+    uint32_t course;
+    uint32_t room;
+    uint32_t firstStudent;
+    uint32_t count;
+};
+
+struct SnapshotRoom {
+    uint32_t capacity;
+    uint8_t type;               // RoomType
+    uint8_t weekdays;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 40, "snapshot header layout");
+static_assert(sizeof(SnapshotSectionEntry) == 32, "snapshot section layout");
+
+// View of a text column inside a mapped snapshot
+class TextColumn {
+public:
+    TextColumn() : offsets(nullptr), chars(nullptr), count(0) {}
+    TextColumn(const uint64_t* offsets, const char* chars, size_t count)
+        : offsets(offsets), chars(chars), count(count) {}
+
+    size_t size() const { return count; }
+    std::string_view operator[](size_t i) const {
+        return std::string_view(chars + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+    }
+
+private:
+    const uint64_t* offsets;
+    const char* chars;
+    size_t count;
+};
+
+// A snapshot file mapped read-only. Views stay valid until close().
+class SnapshotFile {
+public:
+    SnapshotFile();
+
+    // Maps and validates the file; with verifyChecksums every section's payload
+    // is also checked. Logs the reason and returns false on error.
+    bool open(const std::string& filename, bool verifyChecksums = true);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    uint32_t getVersion() const { return version; } // Format version of the open file
+
+    bool hasSection(SnapshotSection id) const { return find(id) != nullptr; }
+    bool hasSchedule() const { return hasSection(SnapshotSection::ScheduleInfo); }
+
+    // Empty if the section is absent or its records are not sizeof(T) bytes
+    template<typename T>
+    ArrayView<T> array(SnapshotSection id) const {
+        const SnapshotSectionEntry* entry = find(id);
+        if (entry == nullptr || entry->elementSize != sizeof(T)) {
+            return ArrayView<T>();
+        }
+        return ArrayView<T>(reinterpret_cast<const T*>(file.data() + entry->offset),
+                            static_cast<size_t>(entry->bytes / sizeof(T)));
+    }
+    TextColumn text(SnapshotSection id) const;
+
+    double getOpenMs() const { return openMs; }
+
+private:
+    const SnapshotSectionEntry* find(SnapshotSection id) const;
+
+    MappedFile file;
+    const SnapshotSectionEntry* sections;
+    size_t sectionCount;
+    uint32_t version;
+    double openMs;
+};
+
+// Writes the store and, if generator has a schedule, the schedule with its rooms,
+// calendar, sittings and conflict graph. The file is written next to the target and renamed
+// over it once complete. false (with the reason logged) on error.
+bool writeSnapshot(const std::string& filename, const EntityStore& store, const TimetableGenerator* generator);
+
+// Checksum used for snapshot sections: 8 bytes per step, multiply-xorshift mixing
+uint64_t snapshotChecksum(const void* data, size_t size);
+// Checksum of a header (its checksum field is ignored) and its section table
+uint64_t snapshotHeaderChecksum(const SnapshotHeader& header, const SnapshotSectionEntry* table);
+
+#endif // SNAPSHOT_H
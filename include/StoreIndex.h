@@ -0,0 +1,94 @@
+#ifndef STOREINDEX_H
+#define STOREINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "EntityStore.h"
+
+// Rows of one table grouped by a text column. Every distinct value gets a dense
+// group id in first-seen row order, and the rows of each group are stored
+// contiguously in row order (CSR). Finding a group is one hash probe; listing its
+// rows costs only the rows returned.
+class GroupIndex {
+public:
+    // keyOf(row) returns the row's value as something convertible to std::string_view
+    template<typename KeyOf>
+    void build(size_t rowCount, KeyOf keyOf) {
+        clear();
+        rowGroups.resize(rowCount);
+        for (size_t row = 0; row < rowCount; row++) {
+            rowGroups[row] = names.intern(keyOf(static_cast<uint32_t>(row)));
+        }
+        groupRows();
+    }
+    void clear();
+
+    size_t size() const { return names.size(); }
+    const std::string& name(uint32_t group) const { return names.str(group); }
+    uint32_t find(std::string_view name) const { return names.find(name); } // kInvalidId if absent
+    uint32_t groupOf(uint32_t row) const { return rowGroups[row]; }
+    ArrayView<uint32_t> rows(uint32_t group) const {
+        return ArrayView<uint32_t>(members.data() + offsets[group], offsets[group + 1] - offsets[group]);
+    }
+    ArrayView<uint32_t> rows(std::string_view name) const; // Empty for an unknown value
+
+private:
+    void groupRows();
+
+    StringInterner names;
+    std::vector<uint32_t> rowGroups;  // Group per row
+    std::vector<uint32_t> offsets;    // Groups + 1
+    std::vector<uint32_t> members;    // Row ids, grouped
+};
+
+// Secondary indexes of an EntityStore, built once per load by DatabaseManager.
+// Roll numbers and course ids are hashed by the tables themselves; this adds the
+// enrollments grouped by student and by course (the student <-> course join in
+// both directions) and groupings of students by program and batch and of courses
+// by department. Queries return views into the index, so a lookup costs one hash
+// probe or array access plus the size of its result.
+class StoreIndex {
+public:
+    void build(const EntityStore& store);
+    void clear();
+
+    uint32_t findStudent(std::string_view rollNo) const { return store ? store->students.find(rollNo) : kInvalidId; }
+    uint32_t findCourse(std::string_view courseId) const { return store ? store->courses.find(courseId) : kInvalidId; }
+
+    // Enrollments of one student or course, in enrollment order
+    ArrayView<uint32_t> coursesOf(uint32_t student) const { return group(studentOffsets, studentCourses, student); }
+    ArrayView<uint32_t> studentsOf(uint32_t course) const { return group(courseOffsets, courseStudents, course); }
+    uint32_t enrollmentCount(uint32_t course) const { return courseOffsets[course + 1] - courseOffsets[course]; }
+
+    // CSR arrays of coursesOf() and studentsOf(), for consumers that keep their own copy
+    const std::vector<uint32_t>& studentCourseOffsets() const { return studentOffsets; }
+    const std::vector<uint32_t>& courseStudentOffsets() const { return courseOffsets; }
+    const std::vector<uint32_t>& courseStudentIds() const { return courseStudents; }
+
+    const GroupIndex& programs() const { return programGroups; }     // Over student ids
+    const GroupIndex& batches() const { return batchGroups; }        // Over student ids
+    const GroupIndex& departments() const { return departmentGroups; } // Over course ids
+
+    double buildMs() const { return lastBuildMs; }
+
+private:
+    static ArrayView<uint32_t> group(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& ids,
+                                     uint32_t key) {
+        return ArrayView<uint32_t>(ids.data() + offsets[key], offsets[key + 1] - offsets[key]);
+    }
+
+    const EntityStore* store = nullptr;
+    std::vector<uint32_t> studentOffsets;  // Students + 1
+    std::vector<uint32_t> studentCourses;
+    std::vector<uint32_t> courseOffsets;   // Courses + 1
+    std::vector<uint32_t> courseStudents;
+    GroupIndex programGroups;
+    GroupIndex batchGroups;
+    GroupIndex departmentGroups;
+    double lastBuildMs = 0;
+};
+
+#endif // STOREINDEX_H
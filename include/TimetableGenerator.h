@@ -1,11 +1,73 @@
 #ifndef TIMETABLEGENERATOR_H
 #define TIMETABLEGENERATOR_H
 
+#include <atomic>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "Models.h"
-#include "LinkedList.h"
 #include "DatabaseManager.h"
+#include "CivilDate.h"
+#include "ConflictGraph.h"
+#include "RoomInventory.h"
+#include "ScheduleOptimiser.h"
+#include "SittingPlan.h"
+
+class SnapshotFile;
+
+// How generate() assigns courses to days
+enum class SchedulingMode {
+    Sequential, // Courses in list order, rooms filled round-robin (original behaviour)
+    DSatur      // Conflict-graph colouring: one colour per exam slot, no student sits two exams in one slot
+};
+
+// Stage of the generator, published for observers on other threads. A run ends
+// in Finished, Cancelled or Failed.
+enum class GenerationPhase {
+    Idle,
+    BuildingConflicts,
+    Scheduling,
+    Optimising,
+    Exporting,
+    Finished,
+    Cancelled,
+    Failed      // generate() rejected its input (date, sittings, rooms, data)
+};
+
+// One exam session: a slice of a course's enrolled students in one room in one
+// sitting of one day. Text (dates, times, room names, roll numbers) is only
+// produced when the entry is exported.
+struct ScheduleEntry {
+    int32_t dayIndex;       // Exam day number, 1 = start date
+    int32_t date;           // Days since 01-01-1970
+    uint32_t course;        // Course id in the entity store
+    uint32_t room;          // Room number: position in the room inventory, 1 = first room
+    uint32_t firstStudent;  // Offset of the session's first student in the course's student list
+    uint32_t count;         // Students seated in this session
+    uint16_t sitting;       // Sitting of the day in the SittingPlan, 0 = first
+    uint16_t minutes;       // Exam duration; the room is booked from the sitting's start for this long
+};
+
+// Outcome of validating or applying a course date change
+struct RescheduleReport {
+    bool applied = false;
+    std::string error;                          // Set when the request itself is invalid
+    int newDayNumber = 0;                       // Day number of the target date (1 = start date)
+    std::vector<std::string> clashingStudents;  // Would sit another exam in the target slot
+    std::vector<std::string> occupiedRooms;     // Already booked at the target time
+
+    bool hasClashes() const { return !clashingStudents.empty() || !occupiedRooms.empty(); }
+};
+
+// Outcome of a hall-ticket export
+struct HallTicketReport {
+    size_t tickets = 0;     // Students with at least one scheduled exam
+    size_t pages = 0;
+    size_t files = 0;       // 1 for a single PDF
+    size_t failedFiles = 0; // Per-student files that could not be written
+    uint64_t bytes = 0;
+    double ms = 0;
+};
 
 class TimetableGenerator {
 public:
@@ -13,27 +75,170 @@ public:
     ~TimetableGenerator();
 
     void setStartDate(const std::string& date);
-    bool generate();
+    void setThreadCount(unsigned threads); // 0 = all hardware threads
+    void setSchedulingMode(SchedulingMode mode);
+    SchedulingMode getSchedulingMode() const { return mode; }
+    void setRoomInventory(const RoomInventory& rooms); // Default: RoomInventory::standardCampus()
+    const RoomInventory& getRoomInventory() const { return roomInventory; }
+    void setExamCalendar(const ExamCalendar& calendar); // Default: every day is an exam day
+    // Room sharing lets courses of the same day sit in one room up to its capacity
+    // (see SharedRoomPacker); days are then filled by seats rather than whole rooms.
+    // Default: off, every session has its room to itself.
+    void setRoomSharing(bool share);
+    bool getRoomSharing() const { return roomSharing; }
+    const ExamCalendar& getExamCalendar() const { return calendar; }
+    // Sittings per day and course durations. Default: SittingPlan::singleAfternoon(),
+    // one exam slot a day. Courses are scheduled into exam slots, students are
+    // checked for clashes per slot, and rooms are booked for the exam's actual time,
+    // so a long exam keeps its rooms into the next sitting.
+    void setSittingPlan(const SittingPlan& plan);
+    const SittingPlan& getSittingPlan() const { return sittings; }
+    bool generate(); // false on invalid input or when cancelled
+    int32_t getStartDay() const { return startDay; } // Days since 01-01-1970 of day 1
+
+    // Restores a schedule saved with writeSnapshot(), together with its start date,
+    // mode, room sharing, sittings, rooms, calendar and conflict graph, instead of
+    // generating one. The dataset must already be loaded from the same snapshot.
+    // false (no schedule) if the snapshot has none or it does not match the dataset.
+    bool loadSchedule(const SnapshotFile& snapshot);
+
+    // Improves the generated schedule by moving whole courses between exam slots
+    // with parallel simulated annealing (see annealSchedule; its days are slots),
+    // then repacks every slot's rooms. Courses spread over several slots keep their
+    // sessions. Cancelling, including a Cancel requested since generate() started,
+    // stops the search early and applies the best schedule found so far.
+    // false if there is no schedule to improve.
+    bool optimise(const OptimiserConfig& config, OptimiserReport* report = nullptr);
     bool exportToCSV(const std::string& filename);
     bool exportToText(const std::string& filename);
     bool exportToPDF(const std::string& filename);
-    
+
+    // Admit cards for every student with a scheduled exam: roll number, name, program
+    // and each exam's date, time, course and room. Pages are rendered and compressed
+    // in parallel (setThreadCount) and share one font and one set of page forms.
+    // perStudent: `path` is an existing directory that gets <roll number>.pdf per
+    // student; otherwise `path` is one multi-page PDF. false if any file failed.
+    bool exportHallTickets(const std::string& path, bool perStudent = false, HallTicketReport* report = nullptr);
+
+    // Progress and cooperative cancellation. These are the only members that may be
+    // used from another thread while generate() or an export is running. A cancel
+    // request stops the running generate() at its next checkpoint.
+    GenerationPhase getPhase() const { return phase.load(std::memory_order_relaxed); }
+    int getProgressPercent() const { return progressPercent.load(std::memory_order_relaxed); }
+    void requestCancel() { cancelRequested.store(true, std::memory_order_relaxed); }
+
     // Getters for the generated timetable
-    std::vector<std::string> getSchedule() const;
+    const std::vector<ScheduleEntry>& getEntries() const { return entries; }
+    std::vector<std::string> getSchedule() const; // Legacy comma-joined lines
     bool isGenerated() const;
-    
+    const ConflictGraph& getConflictGraph() const { return conflicts; }
+    const EntityStore& getStore() const { return database.getStore(); }
+    const StoreIndex& getStoreIndex() const { return database.getIndex(); }
+
+    // Changes whenever the schedule does (generate, date moves). Versions are unique
+    // across generator instances, so caches can key on the version alone.
+    uint64_t getScheduleVersion() const { return scheduleVersion; }
+
+    // Text formatting of entries, for the output edges
+    std::string formatEntry(const ScheduleEntry& entry) const;
+    std::string studentRange(const ScheduleEntry& entry) const;
+    const std::string& courseCode(const ScheduleEntry& entry) const;
+    ArrayView<uint32_t> sessionStudents(const ScheduleEntry& entry) const;
+    ArrayView<uint32_t> courseEntries(uint32_t course) const; // Indices into getEntries()
+    ArrayView<int32_t> studentExamSlots(uint32_t student) const; // Exam slot per enrolment, 0 = unscheduled
+    // A student's personal timetable: indices into getEntries() of every session they
+    // sit, by date and room. O(k) in their exam count; empty if none is scheduled.
+    ArrayView<uint32_t> studentTimetable(uint32_t student) const;
+    // Exam slot of the entry: sittings numbered in time order from 1 = first sitting of day 1
+    int32_t examSlot(const ScheduleEntry& entry) const {
+        return (entry.dayIndex - 1) * static_cast<int32_t>(sittings.size()) + entry.sitting + 1;
+    }
+    int32_t startMinute(const ScheduleEntry& entry) const { return sittings.sitting(entry.sitting).start; }
+    std::string examTime(const ScheduleEntry& entry) const; // "2:00 PM - 5:00 PM"
+    const std::string& roomName(uint32_t room) const { return roomInventory.room(room - 1).name; }
+    uint32_t roomCapacity(uint32_t room) const { return roomInventory.room(room - 1).capacity; }
+
     // Methods for changing test dates
     std::vector<std::pair<std::string, std::string>> getCoursesWithDates() const;
     bool updateCourseDate(const std::string& courseId, const std::string& newDate);
-    
+
+    // Incremental edits: cost is proportional to the course's enrolment and sessions
+    // (the sessions are sorted once, so k sessions cost k log k).
+    // checkCourseDate only reports clashes; moveCourseDate applies the move unless it
+    // would create clashes and allowClashes is false. `sitting` is the target sitting
+    // of the day; kKeepSitting leaves every session in the sitting it has.
+    static constexpr int kKeepSitting = -1;
+    RescheduleReport checkCourseDate(const std::string& courseId, const std::string& newDate,
+                                     int sitting = kKeepSitting) const;
+    RescheduleReport moveCourseDate(const std::string& courseId, const std::string& newDate, bool allowClashes,
+                                    int sitting = kKeepSitting);
+
 private:
     DatabaseManager& database;
     bool generated;
-    std::vector<std::string> schedule;
+    uint64_t scheduleVersion;
+    std::vector<ScheduleEntry> entries;
     std::string startDate;
+    int32_t startDay;
+    unsigned threadCount;
+    SchedulingMode mode;
+    bool roomSharing;
+    RoomInventory roomInventory;
+    ExamCalendar calendar;
+    SittingPlan sittings;
+    ConflictGraph conflicts;
+    std::atomic<GenerationPhase> phase;
+    std::atomic<int> progressPercent;
+    std::atomic<bool> cancelRequested;
+
+    // Enrolled student ids per course in CSR form, kept from the last generate()
+    std::vector<uint32_t> courseOffsets;
+    std::vector<uint32_t> courseStudents;
+    std::vector<std::vector<uint32_t>> courseSessions; // Entry indices per course
+    std::vector<int32_t> courseMinutes;                // Own exam duration per course, 0 = its sitting's length
+
+    // Occupancy indexes kept up to date across edits
+    std::vector<uint32_t> studentSlotOffsets;  // Range per student id, one entry per enrolment
+    std::vector<int32_t> studentSlots;         // Booked exam slot per enrolment, 0 = free
+    RoomTimeline roomTimeline;                 // Booked minutes and seats per room
+
+    // Inverted index: entry indices per student id in CSR form, each student's range by date
+    std::vector<uint32_t> studentEntryOffsets;
+    std::vector<uint32_t> studentEntryIndex;
 
+    void buildIndexes(size_t courseCount, size_t enrollmentCount);
+    bool scheduleSequential();
+    bool scheduleDSatur();
+    void setProgress(GenerationPhase newPhase, size_t done, size_t total);
+    bool cancelGeneration();
+    bool failGeneration();
+    bool isCancelRequested() const { return cancelRequested.load(std::memory_order_relaxed); }
+    int32_t slotDate(int slot) const { return startDay + (slot - 1) / static_cast<int>(sittings.size()); }
+    int32_t slotStart(int slot) const; // Minutes since 01-01-1970
+    int32_t entryStart(const ScheduleEntry& entry) const {
+        return entry.date * 1440 + sittings.sitting(entry.sitting).start;
+    }
+    int32_t sessionMinutes(uint32_t course, int slot) const;
+    uint64_t examSlotSeats() const; // Seats of the widest weekday that is not a weekend day
+    void openNextSlot(RoomAllocator& allocator, int& slotCounter) const;
+    void reserveBusyRooms(RoomAllocator& allocator, int slot) const;
+    void placeCourse(uint32_t course, RoomAllocator& allocator, int& slotCounter);
+    void openNextSlot(SharedRoomPacker& packer, int& slotCounter);
+    void reserveBusyRooms(SharedRoomPacker& packer, int slot) const;
+    void placeCourse(uint32_t course, SharedRoomPacker& packer, int& slotCounter);
+    void packSharedSlot(SharedRoomPacker& packer, int slotCounter);
+    void addSession(int slotCounter, uint32_t course, uint32_t startIdx, uint32_t roomNumber, uint32_t seats,
+                    int32_t minutes = 0);
+    void rebuildSchedule(const std::vector<int32_t>& courseSlot, const std::vector<uint8_t>& movable, int slots);
+    void bookSession(const ScheduleEntry& entry, int delta);
+    void buildStudentIndex();
+    bool entryBefore(uint32_t a, uint32_t b) const;
+    void renderHallTicket(uint32_t student, std::vector<std::string>& pages) const;
+    int examsInSlot(uint32_t student, int slot) const;
+    RescheduleReport planCourseMove(const std::string& courseId, const std::string& newDate, int sitting,
+                                    uint32_t& course) const;
+    void bumpScheduleVersion();
     void cleanup();
-    std::string calculateExamDate(const std::string& startDate, int dayOffset);
 };
 
-#endif // TIMETABLEGENERATOR_H
\ No newline at end of file
+#endif // TIMETABLEGENERATOR_H
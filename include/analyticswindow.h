@@ -46,9 +46,9 @@
 #endif
 
 #include <vector>
-#include <map>
 #include <string>
 #include <memory>
+#include "AnalyticsEngine.h"
 
 // Forward declarations
 class DatabaseManager;
@@ -57,41 +57,6 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class AnalyticsWindow; }
 QT_END_NAMESPACE
 
-struct ExamScheduleData {
-    std::string courseId;
-    std::string courseName;
-    std::string department;
-    std::string room;
-    std::string date;
-    std::string timeSlot;
-    int duration;
-    int studentsCount;
-    std::vector<std::string> enrolledStudents;
-};
-
-struct AnalyticsData {
-    // Exam Load Overview Data
-    std::map<std::string, int> examCountPerDay;
-    
-    // Department Distribution Data
-    std::map<std::string, int> examCountPerDepartment;
-    
-    // Room Utilization Data
-    std::map<std::string, double> roomUtilizationPercentage;
-    
-    // Conflict Detection Data
-    std::map<std::string, int> conflictsPerCourse;
-    
-    // Exam Timing Data
-    std::vector<ExamScheduleData> examTimings;
-    
-    // Room Load Over Days Data
-    std::map<std::pair<std::string, std::string>, int> roomLoadPerDay; // (room, day) -> load
-    
-    // Student Exam Distribution Data
-    std::map<int, int> studentExamCountDistribution; // examCount -> studentCount
-};
-
 class AnalyticsWindow : public QDialog
 {
     Q_OBJECT
@@ -101,6 +66,7 @@ public:
     ~AnalyticsWindow();
 
     void setDatabaseManager(DatabaseManager* dbManager);
+    void setGenerator(const TimetableGenerator* generator); // Schedule to analyse, may be null
     void refreshAnalytics();
 
 private slots:
@@ -115,7 +81,10 @@ protected:
 private:
     Ui::AnalyticsWindow *ui;
     DatabaseManager* m_databaseManager;
-    AnalyticsData m_analyticsData;
+    const TimetableGenerator* m_generator;
+    AnalyticsEngine m_engine;              // Caches the last result by schedule version
+    ScheduleAnalytics m_noSchedule;        // Shown before a timetable is generated
+    const ScheduleAnalytics* m_analytics;
     
     // Chart views for each analytics section
     QChartView* m_examLoadChartView;
@@ -129,15 +98,7 @@ private:
     QWidget* m_roomLoad3DWidget;
     QChartView* m_studentDistributionChartView;
 
-    // Analytics data processing methods
     void loadAnalyticsData();
-    void processExamLoadData();
-    void processDepartmentDistributionData();
-    void processRoomUtilizationData();
-    void processConflictDetectionData();
-    void processExamTimingData();
-    void processRoomLoadOverDaysData();
-    void processStudentExamDistributionData();
 
     // Chart creation methods
     void createExamLoadChart();
@@ -153,13 +114,9 @@ private:
     void clearCharts();
     QColor getRandomColor(int index);
     QString formatPercentage(double value);
-    std::vector<ExamScheduleData> getExamScheduleFromDatabase();
+    QString dayLabel(int day) const;
     void exportChartsAsPDF(const QString& filename);
     void clearWidgetLayout(QWidget* widget);
-    
-    // Sample data generation (for testing without database)
-    void generateSampleData();
-    AnalyticsData createSampleAnalyticsData();
 };
 
 #endif // ANALYTICSWINDOW_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <QDialog>
 #include <QDateTimeEdit>
+#include "TimetableGenerator.h"
 
 namespace Ui {
 class GenerateTimetableDialog;
@@ -17,6 +18,11 @@ public:
     ~GenerateTimetableDialog();
 
     QString getStartDate() const;
+    SchedulingMode getSchedulingMode() const;
+    int getOptimiseSeconds() const; // 0 = no optimiser pass
+    ExamCalendar getExamCalendar() const;
+    bool getRoomSharing() const;
+    SittingPlan getSittingPlan() const;
 
 private slots:
     void onAccept();
@@ -2,6 +2,8 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <atomic>
+#include <memory>
 #include "DatabaseManager.h"
 #include "TimetableGenerator.h"
 #include "scheduletablemodel.h"
@@ -10,8 +12,12 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-// Forward declaration
+// Forward declarations
 class AnalyticsWindow;
+class StatsDialog;
+class QProgressDialog;
+class QThread;
+class QTimer;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -23,28 +29,53 @@ public:
 private slots:
     void onConnectDatabase();
     void onImportCSV();
+    void onLoadRooms();
+    void onOpenSnapshot();
+    void onSaveSnapshot();
     void onGenerateTimetable();
     void onViewSchedule();
     void onExportCSV();
     void onExportText();
     void onExportPDF();
+    void onExportHallTickets();
     void onShiftCourse();
     void onChangeTestDate();
+    void onFindStudent();
     void onAnalytics();
+    void onPerformanceStats();
     void onAbout();
+    void onGenerationProgress();
+    void onGenerationFinished();
+    void onCancelGeneration();
 
 private:
     void setupConnections();
     void updateScheduleView();
+    void resizeScheduleColumns();
     void enableScheduleActions(bool enable);
+    void resetGenerator(); // Drops the schedule when the dataset is replaced
+    void setGenerationRunning(bool running);
 
     Ui::MainWindow *ui;
     DatabaseManager dbManager;
-    TimetableGenerator generator;
+    RoomInventory roomInventory;                   // Rooms used by the next generation
+    std::unique_ptr<TimetableGenerator> generator; // Schedule shown and edited in the window
+
+    // Background generation: the run owns its own generator, which replaces
+    // `generator` only once it has finished successfully
+    std::unique_ptr<TimetableGenerator> pendingGenerator;
+    QThread *generationThread;
+    QProgressDialog *progressDialog;
+    QTimer *progressTimer;
+    std::atomic<bool> pendingGenerated;
+    std::atomic<bool> pendingExported;
+    QString pendingSource;
+
     bool isConnected;
     bool scheduleGenerated;
     ScheduleTableModel *scheduleModel;
     AnalyticsWindow *analyticsWindow;
+    StatsDialog *statsDialog;
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
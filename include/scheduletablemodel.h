@@ -2,8 +2,17 @@
 #define SCHEDULETABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
 #include "TimetableGenerator.h"
 
+// Exam slot x room grid of the generated timetable; with several sittings a day
+// each day spans one row per sitting. The grid is sized from the schedule,
+// and cell text is formatted on first paint and cached, so only visible cells cost
+// anything. updateCourse() applies a single course edit with dataChanged signals
+// instead of resetting the whole model. With room sharing a cell holds the
+// sessions of several courses; its tooltip lists their seat counts.
 class ScheduleTableModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -17,19 +26,35 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
     void setSchedule(const TimetableGenerator &generator);
+    void updateCourse(const TimetableGenerator &generator, uint32_t course);
     void clear();
 
+    // Display text of up to `samples` evenly spaced cells of a column, for column sizing
+    QStringList sampleColumn(int column, int samples) const;
+
 private:
     struct ExamSlot {
         QString courseId;
-        QString courseName;
-        QString room;
-        int students;
+        QString studentRange;
+        int students = 0;
+        uint32_t course = kInvalidId;
     };
 
-    QVector<QVector<ExamSlot>> schedule; // [day][timeslot]
-    int maxDays;
-    int maxRooms;
+    void resizeGrid(const TimetableGenerator &generator, int newSlots, int newRooms);
+    int placeEntry(const TimetableGenerator &generator, const ScheduleEntry &entry); // Returns the cell
+    QString slotHeader(int slot) const;
+
+    QString cellText(const QVector<ExamSlot> &slots) const;
+    QString cellToolTip(const QVector<ExamSlot> &slots) const;
+
+    QVector<QVector<ExamSlot>> cells;        // exam slots x rooms, row-major
+    mutable QVector<QString> displayCache;   // Null until the cell is first painted
+    QHash<uint32_t, QVector<int>> courseCells;
+    QVector<QString> roomHeaders;            // Inventory room names of the columns
+    QVector<QString> sittingNames;           // Empty with a single sitting a day
+    int32_t firstDate;                       // Date of day 1, days since 01-01-1970
+    int examSlots;
+    int rooms;
 };
 
-#endif // SCHEDULETABLEMODEL_H
\ No newline at end of file
+#endif // SCHEDULETABLEMODEL_H
@@ -0,0 +1,32 @@
+#ifndef STATSDIALOG_H
+#define STATSDIALOG_H
+
+#include <QDialog>
+
+namespace Ui {
+class StatsDialog;
+}
+
+// Shows the engine's phase timings and counters (see Profiler.h)
+class StatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit StatsDialog(QWidget *parent = nullptr);
+    ~StatsDialog();
+
+public slots:
+    void refreshStats();
+
+private slots:
+    void onRecordToggled(bool checked);
+    void onReset();
+    void onExportJson();
+    void onExportTrace();
+
+private:
+    Ui::StatsDialog *ui;
+};
+
+#endif // STATSDIALOG_H
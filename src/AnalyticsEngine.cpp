@@ -0,0 +1,189 @@
+#include "../include/AnalyticsEngine.h"
+#include "../include/Parallel.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Per-worker aggregates of the session pass, summed once all workers are done
+struct SessionPartial {
+    std::vector<uint32_t> sessionsPerDay;
+    std::vector<uint32_t> seatsPerDay;
+    std::vector<uint32_t> sessionsPerRoom;
+    std::vector<uint32_t> seatsPerRoom;
+    std::vector<uint32_t> roomDayLoad;
+    std::vector<uint32_t> sessionsPerDepartment;
+    std::vector<uint32_t> clashesPerCourse;
+};
+
+// Per-worker aggregates of the student pass
+struct StudentPartial {
+    std::vector<uint32_t> examsPerStudent;
+    uint32_t clashingStudents = 0;
+};
+
+void addInto(std::vector<uint32_t>& total, const std::vector<uint32_t>& part) {
+    if (total.size() < part.size()) {
+        total.resize(part.size(), 0);
+    }
+    for (size_t i = 0; i < part.size(); i++) {
+        total[i] += part[i];
+    }
+}
+
+} // namespace
+
+double ScheduleAnalytics::roomUtilisation(int room) const {
+    uint64_t offered = static_cast<uint64_t>(slotsPerRoom[room]) * roomCapacity[room];
+    return offered ? 100.0 * seatsPerRoom[room] / offered : 0.0;
+}
+
+AnalyticsEngine::AnalyticsEngine()
+    : valid(false), threadCount(0) {
+}
+
+void AnalyticsEngine::setThreadCount(unsigned threads) {
+    threadCount = threads;
+}
+
+const ScheduleAnalytics& AnalyticsEngine::analyse(const TimetableGenerator& generator) {
+    if (!valid || result.version != generator.getScheduleVersion()) {
+        compute(generator);
+        valid = true;
+    }
+    return result;
+}
+
+void AnalyticsEngine::compute(const TimetableGenerator& generator) {
+    PROFILE_SCOPE("analytics");
+    auto start = std::chrono::steady_clock::now();
+    result = ScheduleAnalytics();
+    result.version = generator.getScheduleVersion();
+
+    const std::vector<ScheduleEntry>& entries = generator.getEntries();
+    if (!generator.isGenerated() || entries.empty()) {
+        return;
+    }
+    const EntityStore& store = generator.getStore();
+    const size_t courseCount = store.courses.size();
+    const size_t studentCount = store.students.size();
+
+    // Grid size and department ids are needed before the workers can size their partials
+    for (const ScheduleEntry& entry : entries) {
+        result.days = std::max(result.days, static_cast<int>(entry.dayIndex));
+        result.rooms = std::max(result.rooms, static_cast<int>(entry.room));
+    }
+    result.firstDate = entries.front().date - (entries.front().dayIndex - 1);
+    const size_t days = static_cast<size_t>(result.days);
+    const size_t rooms = static_cast<size_t>(result.rooms);
+    for (uint32_t room = 1; room <= rooms; room++) {
+        result.roomCapacity.push_back(generator.roomCapacity(room));
+        result.largestRoom = std::max(result.largestRoom, generator.roomCapacity(room));
+    }
+
+    // Department ids come from the store's index, in first-seen course order
+    const GroupIndex& departments = generator.getStoreIndex().departments();
+    for (uint32_t d = 0; d < departments.size(); d++) {
+        result.departments.push_back(departments.name(d));
+    }
+
+    const unsigned threads = resolveThreadCount(threadCount);
+
+    // Fused session pass: day, room and department counts, the room x day load
+    // matrix and same-slot clashes, all from one read of each session's students
+    std::vector<SessionPartial> sessionPartials(std::min<size_t>(threads, entries.size()));
+    parallelFor(entries.size(), threads, [&](size_t first, size_t last, unsigned worker) {
+        SessionPartial& part = sessionPartials[worker];
+        part.sessionsPerDay.assign(days, 0);
+        part.seatsPerDay.assign(days, 0);
+        part.sessionsPerRoom.assign(rooms, 0);
+        part.seatsPerRoom.assign(rooms, 0);
+        part.roomDayLoad.assign(days * rooms, 0);
+        part.sessionsPerDepartment.assign(result.departments.size(), 0);
+        part.clashesPerCourse.assign(courseCount, 0);
+
+        for (size_t i = first; i < last; i++) {
+            const ScheduleEntry& entry = entries[i];
+            const size_t day = static_cast<size_t>(entry.dayIndex - 1);
+            const size_t room = entry.room - 1;
+            const int32_t slot = generator.examSlot(entry);
+            part.sessionsPerDay[day]++;
+            part.seatsPerDay[day] += entry.count;
+            part.sessionsPerRoom[room]++;
+            part.seatsPerRoom[room] += entry.count;
+            part.roomDayLoad[day * rooms + room] += entry.count;
+            part.sessionsPerDepartment[departments.groupOf(entry.course)]++;
+
+            uint32_t clashes = 0;
+            for (uint32_t student : generator.sessionStudents(entry)) {
+                ArrayView<int32_t> examSlots = generator.studentExamSlots(student);
+                if (std::count(examSlots.begin(), examSlots.end(), slot) > 1) {
+                    clashes++;
+                }
+            }
+            part.clashesPerCourse[entry.course] += clashes;
+        }
+    });
+
+    // Student pass over the occupancy index: exam count histogram and clashing students
+    std::vector<StudentPartial> studentPartials(std::min<size_t>(threads, std::max<size_t>(studentCount, 1)));
+    parallelFor(studentCount, threads, [&](size_t first, size_t last, unsigned worker) {
+        StudentPartial& part = studentPartials[worker];
+        for (size_t s = first; s < last; s++) {
+            ArrayView<int32_t> examSlots = generator.studentExamSlots(static_cast<uint32_t>(s));
+            size_t exams = 0;
+            bool clash = false;
+            for (size_t i = 0; i < examSlots.size(); i++) {
+                if (examSlots[i] == 0) {
+                    continue;
+                }
+                exams++;
+                for (size_t j = i + 1; j < examSlots.size() && !clash; j++) {
+                    clash = examSlots[j] == examSlots[i];
+                }
+            }
+            if (part.examsPerStudent.size() <= exams) {
+                part.examsPerStudent.resize(exams + 1, 0);
+            }
+            part.examsPerStudent[exams]++;
+            part.clashingStudents += clash ? 1 : 0;
+        }
+    });
+
+    result.sessionsPerDay.assign(days, 0);
+    result.seatsPerDay.assign(days, 0);
+    result.sessionsPerRoom.assign(rooms, 0);
+    result.seatsPerRoom.assign(rooms, 0);
+    result.roomDayLoad.assign(days * rooms, 0);
+    result.sessionsPerDepartment.assign(result.departments.size(), 0);
+    result.clashesPerCourse.assign(courseCount, 0);
+    for (const SessionPartial& part : sessionPartials) {
+        addInto(result.sessionsPerDay, part.sessionsPerDay);
+        addInto(result.seatsPerDay, part.seatsPerDay);
+        addInto(result.sessionsPerRoom, part.sessionsPerRoom);
+        addInto(result.seatsPerRoom, part.seatsPerRoom);
+        addInto(result.roomDayLoad, part.roomDayLoad);
+        addInto(result.sessionsPerDepartment, part.sessionsPerDepartment);
+        addInto(result.clashesPerCourse, part.clashesPerCourse);
+    }
+    for (const StudentPartial& part : studentPartials) {
+        addInto(result.examsPerStudent, part.examsPerStudent);
+        result.clashingStudents += part.clashingStudents;
+    }
+    for (uint32_t clashes : result.clashesPerCourse) {
+        result.clashingSeats += clashes;
+    }
+
+    // Distinct (slot, room) pairs; a shared room counts once per slot
+    const size_t slots = days * generator.getSittingPlan().size();
+    std::vector<uint8_t> used(slots * rooms, 0);
+    result.slotsPerRoom.assign(rooms, 0);
+    for (const ScheduleEntry& entry : entries) {
+        uint8_t& cell = used[static_cast<size_t>(generator.examSlot(entry) - 1) * rooms + entry.room - 1];
+        result.slotsPerRoom[entry.room - 1] += cell ? 0 : 1;
+        cell = 1;
+    }
+
+    result.computeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
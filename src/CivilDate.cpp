@@ -0,0 +1,256 @@
+#include "../include/CivilDate.h"
+#include "../include/CsvReader.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+// Weekday from the first three letters of its name (case-insensitive), 0 = Monday
+int parseWeekday(std::string_view text) {
+    static const char* const names[] = {"mon", "tue", "wed", "thu", "fri", "sat", "sun"};
+    if (text.size() < 3) {
+        return -1;
+    }
+    for (int day = 0; day < 7; day++) {
+        bool match = true;
+        for (int i = 0; i < 3 && match; i++) {
+            match = std::tolower(static_cast<unsigned char>(text[i])) == names[day][i];
+        }
+        if (match) {
+            return day;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+bool parseDate(std::string_view text, int32_t& days) {
+    if (text.size() != 10 || text[2] != '-' || text[5] != '-') {
+        return false;
+    }
+    int parts[3] = {0, 0, 0};
+    const int starts[3] = {0, 3, 6};
+    const int lengths[3] = {2, 2, 4};
+    for (int p = 0; p < 3; p++) {
+        for (int i = starts[p]; i < starts[p] + lengths[p]; i++) {
+            if (text[i] < '0' || text[i] > '9') {
+                return false;
+            }
+            parts[p] = parts[p] * 10 + (text[i] - '0');
+        }
+    }
+    const unsigned day = static_cast<unsigned>(parts[0]);
+    const unsigned month = static_cast<unsigned>(parts[1]);
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(parts[2], month)) {
+        return false;
+    }
+    days = daysFromCivil(parts[2], month, day);
+    return true;
+}
+
+void appendDate(std::string& out, int32_t days) {
+    const CivilDate date = civilFromDays(days);
+    char buffer[16];
+    buffer[0] = static_cast<char>('0' + date.day / 10);
+    buffer[1] = static_cast<char>('0' + date.day % 10);
+    buffer[2] = '-';
+    buffer[3] = static_cast<char>('0' + date.month / 10);
+    buffer[4] = static_cast<char>('0' + date.month % 10);
+    buffer[5] = '-';
+    size_t len = 6;
+    if (date.year >= 0 && date.year <= 9999) {
+        unsigned year = static_cast<unsigned>(date.year);
+        for (int i = 3; i >= 0; i--) {
+            buffer[len + i] = static_cast<char>('0' + year % 10);
+            year /= 10;
+        }
+        len += 4;
+    } else {
+        std::string year = std::to_string(date.year);
+        std::copy(year.begin(), year.end(), buffer + len);
+        len += year.size();
+    }
+    out.append(buffer, len);
+}
+
+std::string formatDate(int32_t days) {
+    std::string out;
+    appendDate(out, days);
+    return out;
+}
+
+const char* weekdayName(int32_t days) {
+    static const char* const names[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
+    return names[weekdayFromDays(days)];
+}
+
+bool parseTime(std::string_view text, int32_t& minutes) {
+    text = trim(text);
+    const size_t colon = text.find(':');
+    if (colon == std::string_view::npos || colon == 0 || colon > 2 || text.size() != colon + 3) {
+        return false;
+    }
+    int hours = 0;
+    for (size_t i = 0; i < colon; i++) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        hours = hours * 10 + (text[i] - '0');
+    }
+    if (text[colon + 1] < '0' || text[colon + 1] > '5' || text[colon + 2] < '0' || text[colon + 2] > '9' || hours > 23) {
+        return false;
+    }
+    minutes = hours * 60 + (text[colon + 1] - '0') * 10 + (text[colon + 2] - '0');
+    return true;
+}
+
+void appendTime(std::string& out, int32_t minutes) {
+    minutes = ((minutes % 1440) + 1440) % 1440;
+    const int hour = minutes / 60 % 12 == 0 ? 12 : minutes / 60 % 12;
+    if (hour >= 10) {
+        out += static_cast<char>('0' + hour / 10);
+    }
+    out += static_cast<char>('0' + hour % 10);
+    out += ':';
+    out += static_cast<char>('0' + minutes % 60 / 10);
+    out += static_cast<char>('0' + minutes % 10);
+    out += minutes < 720 ? " AM" : " PM";
+}
+
+std::string formatTime(int32_t minutes) {
+    std::string out;
+    appendTime(out, minutes);
+    return out;
+}
+
+bool parseWeekdays(std::string_view text, uint8_t& mask) {
+    text = trim(text);
+    if (text.empty() || equalsIgnoreCase(text, "all")) {
+        mask = 0x7F;
+        return true;
+    }
+    mask = 0;
+    while (!text.empty()) {
+        size_t end = text.find(';');
+        std::string_view token = trim(text.substr(0, end));
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+        size_t dash = token.find('-');
+        int first = parseWeekday(trim(token.substr(0, dash)));
+        int last = dash == std::string_view::npos ? first : parseWeekday(trim(token.substr(dash + 1)));
+        if (first < 0 || last < 0) {
+            return false;
+        }
+        for (int day = first;; day = (day + 1) % 7) {
+            mask |= static_cast<uint8_t>(1u << day);
+            if (day == last) {
+                break;
+            }
+        }
+    }
+    return mask != 0;
+}
+
+ExamCalendar::ExamCalendar()
+    : weekend(0), firstHoliday(0), holidays(0) {
+}
+
+void ExamCalendar::addHoliday(int32_t date) {
+    if (holidayBits.empty()) {
+        firstHoliday = date;
+    } else if (date < firstHoliday) {
+        // Grow the bitmap downwards in whole words so existing bits keep their word offset
+        const int64_t words = (static_cast<int64_t>(firstHoliday) - date + 63) / 64;
+        holidayBits.insert(holidayBits.begin(), static_cast<size_t>(words), 0);
+        firstHoliday -= static_cast<int32_t>(words * 64);
+    }
+    const size_t offset = static_cast<size_t>(static_cast<int64_t>(date) - firstHoliday);
+    if (offset / 64 >= holidayBits.size()) {
+        holidayBits.resize(offset / 64 + 1, 0);
+    }
+    uint64_t& word = holidayBits[offset / 64];
+    const uint64_t bit = uint64_t(1) << (offset % 64);
+    holidays += (word & bit) ? 0 : 1;
+    word |= bit;
+}
+
+void ExamCalendar::clearHolidays() {
+    holidayBits.clear();
+    firstHoliday = 0;
+    holidays = 0;
+}
+
+std::vector<int32_t> ExamCalendar::holidayDates() const {
+    std::vector<int32_t> dates;
+    dates.reserve(holidays);
+    for (size_t w = 0; w < holidayBits.size(); w++) {
+        for (uint64_t bits = holidayBits[w]; bits != 0; bits &= bits - 1) {
+            int bit = 0;
+            while (!((bits >> bit) & 1)) {
+                bit++;
+            }
+            dates.push_back(firstHoliday + static_cast<int32_t>(w * 64 + bit));
+        }
+    }
+    return dates;
+}
+
+bool ExamCalendar::loadHolidays(const std::string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open holidays file: " << filename;
+        return false;
+    }
+
+    CsvReader reader(file.data(), file.data() + file.size());
+    std::vector<CsvField> fields;
+    std::vector<int32_t> dates;
+    size_t line = 0;
+    while (reader.nextRecord(fields)) {
+        line++;
+        std::string_view text = fields.empty() ? std::string_view() : trim(fields[0].text);
+        if (text.empty() || text.front() == '#') {
+            continue;
+        }
+        int32_t date = 0;
+        if (!parseDate(text, date)) {
+            // A header line is allowed in place of the first date
+            if (line == 1) {
+                continue;
+            }
+            LOG(LogLevel::Error) << filename << ":" << line << ": expected a DD-MM-YYYY date, got '" << text << "'";
+            return false;
+        }
+        dates.push_back(date);
+    }
+
+    for (int32_t date : dates) {
+        addHoliday(date);
+    }
+    LOG(LogLevel::Info) << "Loaded " << dates.size() << " holidays from " << filename;
+    return true;
+}
+
+int32_t ExamCalendar::nextExamDay(int32_t date) const {
+    if (!hasExamDays()) {
+        return date;
+    }
+    while (!isExamDay(date)) {
+        date++;
+    }
+    return date;
+}
+
+std::vector<int32_t> ExamCalendar::examDays(int32_t from, size_t count) const {
+    std::vector<int32_t> days;
+    if (!hasExamDays()) {
+        return days;
+    }
+    days.reserve(count);
+    for (int32_t date = nextExamDay(from); days.size() < count; date = nextExamDay(date + 1)) {
+        days.push_back(date);
+    }
+    return days;
+}
@@ -0,0 +1,174 @@
+#include "../include/ConflictGraph.h"
+#include "../include/Parallel.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+ConflictGraph::ConflictGraph()
+    : offsets(1, 0), buildMs(0) {
+}
+
+void ConflictGraph::clear() {
+    offsets.assign(1, 0);
+    adjacency.clear();
+    edgeWeights.clear();
+    courseSizes.clear();
+    buildMs = 0;
+}
+
+bool ConflictGraph::restore(ArrayView<uint64_t> rowOffsets, ArrayView<uint32_t> neighbourIds,
+                            ArrayView<uint32_t> neighbourWeights, ArrayView<uint32_t> sizes) {
+    clear();
+    bool valid = rowOffsets.size() == sizes.size() + 1 && rowOffsets[0] == 0 &&
+                 rowOffsets[sizes.size()] == neighbourIds.size() && neighbourWeights.size() == neighbourIds.size();
+    for (size_t c = 0; valid && c < sizes.size(); c++) {
+        valid = rowOffsets[c] <= rowOffsets[c + 1];
+    }
+    for (size_t i = 0; valid && i < neighbourIds.size(); i++) {
+        valid = neighbourIds[i] < sizes.size();
+    }
+    if (!valid) {
+        return false;
+    }
+    offsets.assign(rowOffsets.begin(), rowOffsets.end());
+    adjacency.assign(neighbourIds.begin(), neighbourIds.end());
+    edgeWeights.assign(neighbourWeights.begin(), neighbourWeights.end());
+    courseSizes.assign(sizes.begin(), sizes.end());
+    return true;
+}
+
+void ConflictGraph::build(const EnrollmentTable& enrollments, size_t studentCount, size_t courseCount,
+                          unsigned threadCount) {
+    PROFILE_SCOPE("generate.conflictGraph");
+    auto start = std::chrono::steady_clock::now();
+    unsigned threads = resolveThreadCount(threadCount);
+    clear();
+
+    // Rows of A: courses per student, sorted and without duplicate enrollments
+    std::vector<size_t> studentOffsets(studentCount + 1, 0);
+    for (uint32_t s : enrollments.studentIds()) {
+        studentOffsets[s + 1]++;
+    }
+    for (size_t s = 0; s < studentCount; s++) {
+        studentOffsets[s + 1] += studentOffsets[s];
+    }
+    std::vector<uint32_t> studentCourses(enrollments.size());
+    {
+        std::vector<size_t> fill(studentOffsets.begin(), studentOffsets.end() - 1);
+        for (size_t i = 0; i < enrollments.size(); i++) {
+            studentCourses[fill[enrollments.student(i)]++] = enrollments.course(i);
+        }
+    }
+    std::vector<uint32_t> studentDegree(studentCount, 0);
+    parallelFor(studentCount, threads, [&](size_t first, size_t last, unsigned) {
+        for (size_t s = first; s < last; s++) {
+            auto rowBegin = studentCourses.begin() + studentOffsets[s];
+            auto rowEnd = studentCourses.begin() + studentOffsets[s + 1];
+            std::sort(rowBegin, rowEnd);
+            studentDegree[s] = static_cast<uint32_t>(std::unique(rowBegin, rowEnd) - rowBegin);
+        }
+    });
+
+    // Columns of A: students per course, from the deduplicated rows
+    std::vector<size_t> courseOffsets(courseCount + 1, 0);
+    for (size_t s = 0; s < studentCount; s++) {
+        for (size_t k = 0; k < studentDegree[s]; k++) {
+            courseOffsets[studentCourses[studentOffsets[s] + k] + 1]++;
+        }
+    }
+    courseSizes.resize(courseCount);
+    for (size_t c = 0; c < courseCount; c++) {
+        courseSizes[c] = static_cast<uint32_t>(courseOffsets[c + 1]);
+        courseOffsets[c + 1] += courseOffsets[c];
+    }
+    std::vector<uint32_t> courseStudents(courseOffsets.back());
+    {
+        std::vector<size_t> fill(courseOffsets.begin(), courseOffsets.end() - 1);
+        for (size_t s = 0; s < studentCount; s++) {
+            for (size_t k = 0; k < studentDegree[s]; k++) {
+                courseStudents[fill[studentCourses[studentOffsets[s] + k]]++] = static_cast<uint32_t>(s);
+            }
+        }
+    }
+
+    // Row c of A^T A: for every student of c, add one to each of that student's other courses.
+    // Each worker fills a contiguous block of rows into its own buffers.
+    struct Block {
+        std::vector<uint32_t> rowLength;
+        std::vector<uint32_t> columns;
+        std::vector<uint32_t> values;
+        size_t firstRow = 0;
+    };
+    unsigned workers = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(courseCount, 1))));
+    std::vector<Block> blocks(workers);
+    parallelFor(courseCount, workers, [&](size_t first, size_t last, unsigned worker) {
+        Block& block = blocks[worker];
+        block.firstRow = first;
+        block.rowLength.reserve(last - first);
+        std::vector<uint32_t> accumulator(courseCount, 0);
+        std::vector<uint32_t> touched;
+
+        for (size_t c = first; c < last; c++) {
+            touched.clear();
+            for (size_t i = courseOffsets[c]; i < courseOffsets[c + 1]; i++) {
+                uint32_t s = courseStudents[i];
+                const uint32_t* row = studentCourses.data() + studentOffsets[s];
+                for (size_t k = 0; k < studentDegree[s]; k++) {
+                    uint32_t d = row[k];
+                    if (d == c) continue;
+                    if (accumulator[d]++ == 0) {
+                        touched.push_back(d);
+                    }
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (uint32_t d : touched) {
+                block.columns.push_back(d);
+                block.values.push_back(accumulator[d]);
+                accumulator[d] = 0;
+            }
+            block.rowLength.push_back(static_cast<uint32_t>(touched.size()));
+        }
+    });
+
+    // Stitch the blocks together in row order
+    offsets.assign(courseCount + 1, 0);
+    std::vector<size_t> blockStart(blocks.size() + 1, 0);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const Block& block = blocks[b];
+        for (size_t r = 0; r < block.rowLength.size(); r++) {
+            offsets[block.firstRow + r + 1] = block.rowLength[r];
+        }
+        blockStart[b + 1] = blockStart[b] + block.columns.size();
+    }
+    for (size_t c = 0; c < courseCount; c++) {
+        offsets[c + 1] += offsets[c];
+    }
+    adjacency.resize(offsets.back());
+    edgeWeights.resize(offsets.back());
+    parallelFor(blocks.size(), threads, [&](size_t first, size_t last, unsigned) {
+        for (size_t b = first; b < last; b++) {
+            std::copy(blocks[b].columns.begin(), blocks[b].columns.end(), adjacency.begin() + blockStart[b]);
+            std::copy(blocks[b].values.begin(), blocks[b].values.end(), edgeWeights.begin() + blockStart[b]);
+        }
+    });
+
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint32_t ConflictGraph::weight(uint32_t a, uint32_t b) const {
+    ArrayView<uint32_t> row = neighbours(a);
+    const uint32_t* it = std::lower_bound(row.begin(), row.end(), b);
+    if (it == row.end() || *it != b) {
+        return 0;
+    }
+    return edgeWeights[offsets[a] + (it - row.begin())];
+}
+
+uint64_t ConflictGraph::weightedDegree(uint32_t c) const {
+    uint64_t total = 0;
+    for (uint32_t w : weights(c)) {
+        total += w;
+    }
+    return total;
+}
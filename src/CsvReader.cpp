@@ -0,0 +1,392 @@
+#include "../include/CsvReader.h"
+#include "../include/Parallel.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define CSV_HAVE_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define CSV_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+// ---------------------------------------------------------------------------
+// MappedFile
+// ---------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+    : bytes(nullptr), length(0), opened(false)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    length = static_cast<size_t>(fileSize.QuadPart);
+    fileHandle = file;
+    if (length > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            close();
+            return false;
+        }
+        mappingHandle = mapping;
+        bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (bytes == nullptr) {
+            close();
+            return false;
+        }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(mapped);
+    }
+    ::close(fd); // The mapping keeps the file referenced
+#endif
+
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (bytes != nullptr) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        mappingHandle = nullptr;
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        fileHandle = nullptr;
+    }
+#else
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+// ---------------------------------------------------------------------------
+// Structural character scanning
+// ---------------------------------------------------------------------------
+
+namespace {
+
+inline bool isStructural(char c) {
+    return c == ',' || c == '"' || c == '\n' || c == '\r';
+}
+
+// Returns the first ',', '"', '\n' or '\r' in [p, end), or end
+const char* scanScalar(const char* p, const char* end) {
+    while (p < end && !isStructural(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+#ifdef CSV_HAVE_SSE2
+inline int firstSetBit(unsigned mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#endif
+}
+
+const char* scanSSE2(const char* p, const char* end) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, quote)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + firstSetBit(mask);
+        }
+        p += 16;
+    }
+    return scanScalar(p, end);
+}
+#endif
+
+#ifdef CSV_HAVE_AVX2
+__attribute__((target("avx2")))
+const char* scanAVX2(const char* p, const char* end) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma), _mm256_cmpeq_epi8(chunk, quote)),
+                                       _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf), _mm256_cmpeq_epi8(chunk, cr)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return scanSSE2(p, end);
+}
+#endif
+
+using ScanFn = const char* (*)(const char*, const char*);
+
+struct ScanKernel {
+    ScanFn scan;
+    const char* name;
+};
+
+ScanKernel selectKernel() {
+#ifdef CSV_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {scanAVX2, "avx2"};
+    }
+#endif
+#ifdef CSV_HAVE_SSE2
+    return {scanSSE2, "sse2"};
+#else
+    return {scanScalar, "scalar"};
+#endif
+}
+
+const ScanKernel& kernel() {
+    static const ScanKernel selected = selectKernel();
+    return selected;
+}
+
+// Returns the first '"' in [p, end), or end (memchr is vectorised by the C library)
+inline const char* findQuote(const char* p, const char* end) {
+    const void* hit = std::memchr(p, '"', static_cast<size_t>(end - p));
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CsvField / CsvReader
+// ---------------------------------------------------------------------------
+
+std::string_view CsvField::value(std::string& scratch) const {
+    if (!escaped) {
+        return text;
+    }
+
+    scratch.clear();
+    for (size_t i = 0; i < text.size(); i++) {
+        scratch.push_back(text[i]);
+        if (text[i] == '"' && i + 1 < text.size() && text[i + 1] == '"') {
+            i++; // Skip the second quote of an escaped pair
+        }
+    }
+    return scratch;
+}
+
+CsvReader::CsvReader(const char* begin, const char* finish)
+    : pos(begin), end(finish), recordBegin(begin), recordEnd(begin) {
+    // Skip a UTF-8 byte order mark
+    if (end - pos >= 3 && std::memcmp(pos, "\xEF\xBB\xBF", 3) == 0) {
+        pos += 3;
+    }
+}
+
+const char* CsvReader::kernelName() {
+    return kernel().name;
+}
+
+bool CsvReader::nextRecord(std::vector<CsvField>& fields) {
+    fields.clear();
+    if (pos >= end) {
+        return false;
+    }
+
+    const ScanFn scan = kernel().scan;
+    recordBegin = pos;
+
+    while (true) {
+        CsvField field;
+
+        if (*pos == '"') {
+            // Quoted field: runs to the next quote that is not part of a "" pair
+            const char* start = ++pos;
+            const char* close = end;
+            while (pos < end) {
+                const char* q = findQuote(pos, end);
+                if (q == end) {
+                    pos = end; // Unterminated quote, take the rest of the input
+                    break;
+                }
+                if (q + 1 < end && q[1] == '"') {
+                    field.escaped = true;
+                    pos = q + 2;
+                    continue;
+                }
+                close = q;
+                pos = q + 1;
+                break;
+            }
+            field.text = std::string_view(start, (close == end ? pos : close) - start);
+
+            // Tolerate stray characters between the closing quote and the delimiter
+            while (pos < end && *pos != ',' && *pos != '\n' && *pos != '\r') {
+                pos = scan(pos + (*pos == '"' ? 1 : 0), end);
+            }
+        } else {
+            // Unquoted field: a quote inside it is taken literally
+            const char* start = pos;
+            pos = scan(pos, end);
+            while (pos < end && *pos == '"') {
+                pos = scan(pos + 1, end);
+            }
+            field.text = std::string_view(start, pos - start);
+        }
+
+        fields.push_back(field);
+
+        if (pos >= end) {
+            recordEnd = end;
+            return true;
+        }
+        if (*pos == ',') {
+            ++pos;
+            if (pos >= end) {
+                fields.push_back(CsvField()); // Trailing delimiter yields an empty last field
+                recordEnd = end;
+                return true;
+            }
+            continue;
+        }
+
+        // Line break: "\r\n", "\n" or a lone "\r"
+        recordEnd = pos;
+        if (*pos == '\r') {
+            ++pos;
+        }
+        if (pos < end && *pos == '\n') {
+            ++pos;
+        }
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Record-aligned splitting
+// ---------------------------------------------------------------------------
+
+// A line break only ends a record when an even number of quotes precede it, so
+// quote counts per slice are gathered first and turned into a running parity.
+std::vector<const char*> splitAtRecords(const char* begin, const char* end, size_t parts, unsigned threads) {
+    PROFILE_SCOPE("import.split");
+    size_t length = static_cast<size_t>(end - begin);
+    std::vector<size_t> quotes(parts, 0);
+    parallelFor(parts, threads, [&](size_t first, size_t last, unsigned) {
+        for (size_t i = first; i < last; i++) {
+            const char* from = begin + length * i / parts;
+            const char* to = begin + length * (i + 1) / parts;
+            quotes[i] = static_cast<size_t>(std::count(from, to, '"'));
+        }
+    });
+
+    std::vector<const char*> bounds{begin};
+    size_t quotesBefore = 0;
+    for (size_t i = 1; i < parts; i++) {
+        quotesBefore += quotes[i - 1];
+        const char* p = begin + length * i / parts;
+        bool inQuotes = (quotesBefore % 2) != 0;
+        while (p < end && (inQuotes || *p != '\n')) {
+            if (*p == '"') inQuotes = !inQuotes;
+            ++p;
+        }
+        if (p < end) ++p;
+        if (p > bounds.back() && p < end) {
+            bounds.push_back(p);
+        }
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+// ---------------------------------------------------------------------------
+// Field text helpers
+// ---------------------------------------------------------------------------
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
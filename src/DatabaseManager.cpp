@@ -1,8 +1,14 @@
 #include "../include/DatabaseManager.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include "../include/CsvReader.h"
+#include "../include/Logger.h"
+#include "../include/Parallel.h"
+#include "../include/Profiler.h"
+#include "../include/Snapshot.h"
 #include <map>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
 
 using namespace std;
 
@@ -14,7 +20,7 @@ using namespace std;
 
 DatabaseManager::DatabaseManager()
     : hEnv(nullptr), hDbc(nullptr), hStmt(nullptr), connected(false), csvDataLoaded(false) {
-    cout << "Using MOCK Database Manager (No Oracle needed)" << endl;
+    LOG(LogLevel::Info) << "Using MOCK Database Manager (No Oracle needed)";
 }
 
 DatabaseManager::~DatabaseManager() {
@@ -38,290 +44,443 @@ bool DatabaseManager::connect(const string& dsn, const string& username,
     (void)dsn;         // Suppress unused parameter warning
     (void)username;    // Suppress unused parameter warning
     (void)password;    // Suppress unused parameter warning
-    cout << "\n=== MOCK CONNECTION (Testing Mode) ===" << endl;
-    cout << "Simulating connection to Oracle database..." << endl;
-    cout << " Mock connection successful!" << endl;
-    cout << "Using hardcoded test data\n" << endl;
+    LOG(LogLevel::Info) << "=== MOCK CONNECTION (Testing Mode) ===";
+    LOG(LogLevel::Info) << "Simulating connection to Oracle database...";
+    LOG(LogLevel::Info) << " Mock connection successful!";
+    LOG(LogLevel::Info) << "Using hardcoded test data";
     
+    loadMockData();
+    index.build(store);
+    csvDataLoaded = false;
     connected = true;
     return true;
 }
 
 void DatabaseManager::disconnect() {
     if (connected) {
-        cout << "Disconnected from mock database." << endl;
+        LOG(LogLevel::Info) << "Disconnected from mock database.";
         connected = false;
+        if (!csvDataLoaded) {
+            store.clear();
+            index.clear();
+        }
     }
 }
 
-bool DatabaseManager::importFromCSV(const string& filename) {
-    cout << "\n=== CSV Import Mode ===" << endl;
-    cout << "Loading data from CSV file: " << filename << endl;
-    
-    // Clear existing CSV data
-    csvCourses = LinkedList<Course>();
-    csvStudents = LinkedList<Student>();
-    csvEnrollments = LinkedList<Enrollment>();
+bool DatabaseManager::hasData() const {
+    return csvDataLoaded || connected;
+}
+
+void DatabaseManager::loadMockData() {
+    store.clear();
+
+    // Hardcoded mock courses
+    CourseTable& courses = store.courses;
+    courses.add("ML101", "Machine Learning", "Computer Science");
+    courses.add("OOP201", "Object Oriented Programming", "Computer Science");
+    courses.add("DB301", "Database Systems", "Information Technology");
+    courses.add("AI401", "Artificial Intelligence", "Computer Science");
+    courses.add("DS501", "Data Structures", "Computer Science");
+    courses.add("CN601", "Computer Networks", "Information Technology");
+    courses.add("SE701", "Software Engineering", "Computer Science");
+    courses.add("WD801", "Web Development", "Information Technology");
+    courses.add("CC901", "Cloud Computing", "Computer Science");
+    courses.add("CY102", "Cybersecurity", "Information Technology");
+
+    // Hardcoded mock students
+    StudentTable& students = store.students;
+    students.add("CT-24001", "Ayan Anwer", 1, "", "");
+    students.add("CT-24002", "Maaz Ali", 1, "", "");
+    students.add("CT-24003", "Saad Rashid", 2, "", "");
+    students.add("CT-24004", "David Willey", 2, "", "");
+    students.add("CT-24005", "John Cena", 1, "", "");
+    students.add("CT-24006", "Undertaker", 2, "", "");
+    students.add("CT-24007", "Final Boss", 1, "", "");
+    students.add("CT-24008", "Roman Reigns", 2, "", "");
+    students.add("CT-24009", "Imran Khan", 1, "", "");
+    students.add("CT-24010", "Shareef Bhai", 2, "", "");
     
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Could not open CSV file: " << filename << endl;
-        return false;
+    // Generate students CT-24011 to CT-24320 (310 additional students)
+    for (int i = 11; i <= 320; i++) {
+        string rollNo = "CT-24" + string(3 - to_string(i).length(), '0') + to_string(i);
+        string name = "Student" + to_string(i);
+        int semester = ((i % 8) + 1); // Distribute across semesters 1-8
+        students.add(rollNo, name, semester, "", "");
     }
     
-    string line;
-    bool isFirstLine = true;
-    map<string, Course> courseMap; // To avoid duplicate courses
-    map<string, Student> studentMap; // To avoid duplicate students
+    // Hardcoded mock data - creating realistic conflicts
+    // Student CT-24001
+    store.addEnrollment("CT-24001", "ML101");
+    store.addEnrollment("CT-24001", "OOP201");
+    store.addEnrollment("CT-24001", "AI401");
+    store.addEnrollment("CT-24001", "DS501");
+    store.addEnrollment("CT-24001", "SE701");
     
-    while (getline(file, line)) {
-        if (isFirstLine) {
-            isFirstLine = false;
-            continue; // Skip header line
-        }
-        
-        if (line.empty()) continue;
+    // Student CT-24002 to CT-24010 enrollments...
+    // [Previous enrollments remain the same]
+    
+    // Generate enrollments for students CT-24011 to CT-24320
+    for (uint32_t s = students.find("CT-24011"); s < students.size(); s++) {
+        int i = static_cast<int>(s) + 1;
         
-        // Parse CSV line
-        vector<string> fields;
-        stringstream ss(line);
-        string field;
+        // Each student enrolls in 4-5 courses (creates realistic conflicts)
+        int numCourses = 4 + (i % 2); // Alternates between 4 and 5 courses
+        int startCourse = (i % 6); // Rotate through different starting points
         
-        while (getline(ss, field, ',')) {
-            // Remove quotes if present
-            if (!field.empty() && field[0] == '"' && field[field.length()-1] == '"') {
-                field = field.substr(1, field.length()-2);
-            }
-            fields.push_back(field);
+        for (int j = 0; j < numCourses; j++) {
+            uint32_t course = static_cast<uint32_t>((startCourse + j) % courses.size());
+            store.enrollments.add(s, course);
         }
-        
+    }
+
+    LOG(LogLevel::Info) << "Loaded " << courses.size() << " courses, " << students.size() << " students and "
+                        << store.enrollments.size() << " enrollments into mock database.";
+}
+
+namespace {
+
+// Files smaller than this per extra thread are parsed on fewer threads
+const size_t kMinChunkBytes = 1 << 20;
+// Invalid lines reported one by one; the rest are only counted
+const uint32_t kInvalidLinesLogged = 20;
+
+double elapsedMs(chrono::steady_clock::time_point since) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - since).count();
+}
+
+struct LocalStudent {
+    string_view rollNo, name, batch, program;
+};
+
+struct LocalCourse {
+    string_view courseId, name;
+};
+
+// Parse result of one chunk, deduplicated with chunk-local ids in first-seen order
+struct ChunkResult {
+    vector<LocalStudent> students;
+    vector<LocalCourse> courses;
+    vector<uint32_t> enrollStudents;
+    vector<uint32_t> enrollCourses;
+    vector<string_view> invalidLines;
+    deque<string> unescaped; // Owns values of fields that contained ""
+    size_t rows = 0;
+
+    string_view keep(const CsvField& field) {
+        if (!field.escaped) {
+            return field.text;
+        }
+        unescaped.emplace_back();
+        field.value(unescaped.back());
+        return unescaped.back();
+    }
+};
+
+void parseChunk(const char* begin, const char* end, ChunkResult& out) {
+    PROFILE_SCOPE("import.parseChunk");
+    unordered_map<string_view, uint32_t> studentIds;
+    unordered_map<string_view, uint32_t> courseIds;
+    CsvReader reader(begin, end);
+    vector<CsvField> fields;
+
+    while (reader.nextRecord(fields)) {
+        if (reader.recordText().empty()) continue;
+        out.rows++;
+
         if (fields.size() < 6) {
-            cout << "Warning: Skipping invalid line: " << line << endl;
+            out.invalidLines.push_back(reader.recordText());
             continue;
         }
-        
-        // Extract data from CSV fields
-        string studentName = fields[0];
-        string rollNo = fields[1];
-        string batch = fields[2];
-        string program = fields[3];
-        
-        // Add student if not already added
-        if (studentMap.find(rollNo) == studentMap.end()) {
-            Student student(rollNo, studentName, batch, program);
-            studentMap.insert(make_pair(rollNo, student));
-            csvStudents.insertAtEnd(student);
+
+        string_view rollNo = out.keep(fields[1]);
+        auto student = studentIds.emplace(rollNo, static_cast<uint32_t>(out.students.size()));
+        if (student.second) {
+            out.students.push_back({rollNo, out.keep(fields[0]), out.keep(fields[2]), out.keep(fields[3])});
         }
-        
+
         // Process courses (fields 4-5, 6-7, 8-9 for regular courses, 8-9 for custom course)
-        for (int i = 4; i < fields.size() - 1; i += 2) {
-            if (i + 1 < fields.size() && !fields[i].empty() && !fields[i+1].empty()) {
-                string courseId = fields[i];
-                string courseName = fields[i+1];
-                
-                // Add course if not already added
-                if (courseMap.find(courseId) == courseMap.end()) {
-                    Course course(courseId, courseName, "Imported");
-                    courseMap.insert(make_pair(courseId, course));
-                    csvCourses.insertAtEnd(course);
+        for (size_t i = 4; i + 1 < fields.size(); i += 2) {
+            if (!fields[i].text.empty() && !fields[i+1].text.empty()) {
+                string_view courseId = out.keep(fields[i]);
+                auto course = courseIds.emplace(courseId, static_cast<uint32_t>(out.courses.size()));
+                if (course.second) {
+                    out.courses.push_back({courseId, out.keep(fields[i+1])});
                 }
-                
-                // Add enrollment
-                csvEnrollments.insertAtEnd(Enrollment(rollNo, courseId));
+                out.enrollStudents.push_back(student.first->second);
+                out.enrollCourses.push_back(course.first->second);
             }
         }
     }
-    
-    file.close();
-    csvDataLoaded = true;
-    connected = false; // Use CSV data instead of database
-    
-    cout << "CSV Import completed successfully!" << endl;
-    cout << "Imported " << csvStudents.getSize() << " students" << endl;
-    cout << "Imported " << csvCourses.getSize() << " courses" << endl;
-    cout << "Imported " << csvEnrollments.getSize() << " enrollments\n" << endl;
-    
-    return true;
 }
 
-LinkedList<Course> DatabaseManager::fetchCourses() {
-    if (csvDataLoaded) {
-        cout << "Returning " << csvCourses.getSize() << " courses from CSV data." << endl;
-        return csvCourses;
-    }
+} // namespace
+
+bool DatabaseManager::importFromCSV(const string& filename, unsigned threadCount, bool append) {
+    PROFILE_SCOPE("import");
+    LOG(LogLevel::Info) << "=== CSV Import Mode ===";
+    LOG(LogLevel::Info) << "Loading data from CSV file: " << filename;
     
-    LinkedList<Course> courses;
+    auto importStart = chrono::steady_clock::now();
+    lastImport = ImportTimings();
+    lastImport.threads = resolveThreadCount(threadCount);
     
-    if (!connected) {
-        cerr << "Not connected to database." << endl;
-        return courses;
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open CSV file: " << filename;
+        return false;
     }
+    lastImport.bytes = file.size();
+    PROFILE_COUNT("import.bytes", file.size());
+    lastImport.mapMs = elapsedMs(importStart);
     
-    // Hardcoded mock data
-    courses.insertAtEnd(Course("ML101", "Machine Learning", "Computer Science"));
-    courses.insertAtEnd(Course("OOP201", "Object Oriented Programming", "Computer Science"));
-    courses.insertAtEnd(Course("DB301", "Database Systems", "Information Technology"));
-    courses.insertAtEnd(Course("AI401", "Artificial Intelligence", "Computer Science"));
-    courses.insertAtEnd(Course("DS501", "Data Structures", "Computer Science"));
-    courses.insertAtEnd(Course("CN601", "Computer Networks", "Information Technology"));
-    courses.insertAtEnd(Course("SE701", "Software Engineering", "Computer Science"));
-    courses.insertAtEnd(Course("WD801", "Web Development", "Information Technology"));
-    courses.insertAtEnd(Course("CC901", "Cloud Computing", "Computer Science"));
-    courses.insertAtEnd(Course("CY102", "Cybersecurity", "Information Technology"));
+    // Skip header line, then cut the body into record-aligned chunks
+    auto phaseStart = chrono::steady_clock::now();
+    const char* fileEnd = file.data() + file.size();
+    CsvReader headerReader(file.data(), fileEnd);
+    vector<CsvField> header;
+    headerReader.nextRecord(header);
+    const char* body = headerReader.position();
     
-    cout << "Fetched " << courses.getSize() << " courses from mock database." << endl;
-    return courses;
-}
-
-LinkedList<Student> DatabaseManager::fetchStudents() {
-    if (csvDataLoaded) {
-        cout << "Returning " << csvStudents.getSize() << " students from CSV data." << endl;
-        return csvStudents;
-    }
+    size_t bodyBytes = static_cast<size_t>(fileEnd - body);
+    size_t parts = min<size_t>(lastImport.threads, bodyBytes / kMinChunkBytes + 1);
+    vector<const char*> bounds = splitAtRecords(body, fileEnd, parts, lastImport.threads);
+    lastImport.chunks = bounds.size() - 1;
+    lastImport.splitMs = elapsedMs(phaseStart);
     
-    LinkedList<Student> students;
+    // Parse and deduplicate every chunk on its own thread
+    phaseStart = chrono::steady_clock::now();
+    vector<ChunkResult> chunks(lastImport.chunks);
+    parallelFor(chunks.size(), lastImport.threads, [&](size_t first, size_t last, unsigned) {
+        for (size_t i = first; i < last; i++) {
+            parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+        }
+    });
+    lastImport.parseMs = elapsedMs(phaseStart);
     
-    if (!connected) {
-        cerr << "Not connected to database." << endl;
-        return students;
+    // Merge in chunk order so first-seen order matches a single-threaded pass
+    phaseStart = chrono::steady_clock::now();
+    if (!append || !csvDataLoaded) {
+        store.clear();
+    }
+    vector<vector<uint32_t>> studentRemap(chunks.size());
+    vector<vector<uint32_t>> courseRemap(chunks.size());
+    vector<size_t> enrollOffsets(chunks.size() + 1, store.enrollments.size());
+    LogLimiter invalidLines(kInvalidLinesLogged);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const ChunkResult& chunk = chunks[i];
+        for (string_view line : chunk.invalidLines) {
+            LOG_LIMITED(invalidLines, LogLevel::Warning) << "Skipping invalid line: " << line;
+        }
+        studentRemap[i].reserve(chunk.students.size());
+        for (const LocalStudent& st : chunk.students) {
+            studentRemap[i].push_back(store.students.add(st.rollNo, st.name, 0, st.batch, st.program));
+        }
+        courseRemap[i].reserve(chunk.courses.size());
+        for (const LocalCourse& course : chunk.courses) {
+            courseRemap[i].push_back(store.courses.add(course.courseId, course.name, "Imported"));
+        }
+        enrollOffsets[i + 1] = enrollOffsets[i] + chunk.enrollStudents.size();
+        lastImport.rows += chunk.rows;
+        PROFILE_COUNT("import.rows", chunk.rows);
+        PROFILE_COUNT("import.invalidLines", chunk.invalidLines.size());
     }
     
-    // Hardcoded mock data
-    students.insertAtEnd(Student("CT-24001", "Ayan Anwer", 1));
-    students.insertAtEnd(Student("CT-24002", "Maaz Ali", 1));
-    students.insertAtEnd(Student("CT-24003", "Saad Rashid", 2));
-    students.insertAtEnd(Student("CT-24004", "David Willey", 2));
-    students.insertAtEnd(Student("CT-24005", "John Cena", 1));
-    students.insertAtEnd(Student("CT-24006", "Undertaker", 2));
-    students.insertAtEnd(Student("CT-24007", "Final Boss", 1));
-    students.insertAtEnd(Student("CT-24008", "Roman Reigns", 2));
-    students.insertAtEnd(Student("CT-24009", "Imran Khan", 1));
-    students.insertAtEnd(Student("CT-24010", "Shareef Bhai", 2));
+    store.enrollments.resize(enrollOffsets.back());
+    parallelFor(chunks.size(), lastImport.threads, [&](size_t first, size_t last, unsigned) {
+        PROFILE_SCOPE("import.mergeEnrollments");
+        for (size_t i = first; i < last; i++) {
+            const ChunkResult& chunk = chunks[i];
+            for (size_t e = 0; e < chunk.enrollStudents.size(); e++) {
+                store.enrollments.set(enrollOffsets[i] + e,
+                                      studentRemap[i][chunk.enrollStudents[e]],
+                                      courseRemap[i][chunk.enrollCourses[e]]);
+            }
+        }
+    });
+    lastImport.mergeMs = elapsedMs(phaseStart);
     
-    // Generate students CT-24011 to CT-24320 (310 additional students)
-    for (int i = 11; i <= 320; i++) {
-        string rollNo = "CT-24" + string(3 - to_string(i).length(), '0') + to_string(i);
-        string name = "Student" + to_string(i);
-        int semester = ((i % 8) + 1); // Distribute across semesters 1-8
-        students.insertAtEnd(Student(rollNo, name, semester));
+    index.build(store);
+    lastImport.indexMs = index.buildMs();
+    
+    chunks.clear(); // Views into the mapping must not outlive it
+    file.close();
+    csvDataLoaded = true;
+    connected = false; // Use CSV data instead of database
+    lastImport.totalMs = elapsedMs(importStart);
+    
+    if (invalidLines.suppressed() > 0) {
+        LOG(LogLevel::Warning) << "Skipped " << invalidLines.suppressed() << " more invalid lines";
     }
+    LOG(LogLevel::Info) << "CSV Import completed successfully! (scanner: " << CsvReader::kernelName() << ")";
+    LOG(LogLevel::Info) << "Imported " << store.students.size() << " students";
+    LOG(LogLevel::Info) << "Imported " << store.courses.size() << " courses";
+    LOG(LogLevel::Info) << "Imported " << store.enrollments.size() << " enrollments";
+    LOG(LogLevel::Info) << "Import timings (" << lastImport.threads << " threads, " << lastImport.chunks
+                        << " chunks): map " << lastImport.mapMs << " ms, split " << lastImport.splitMs
+                        << " ms, parse " << lastImport.parseMs << " ms, merge " << lastImport.mergeMs
+                        << " ms, index " << lastImport.indexMs << " ms, total " << lastImport.totalMs << " ms";
     
-    cout << "Fetched " << students.getSize() << " students from mock database." << endl;
-    return students;
+    return true;
 }
 
-LinkedList<Enrollment> DatabaseManager::fetchEnrollments() {
-    if (csvDataLoaded) {
-        cout << "Returning " << csvEnrollments.getSize() << " enrollments from CSV data." << endl;
-        return csvEnrollments;
-    }
+bool DatabaseManager::loadSnapshot(const SnapshotFile& snapshot) {
+    PROFILE_SCOPE("snapshot.loadDataset");
+    auto loadStart = chrono::steady_clock::now();
     
-    LinkedList<Enrollment> enrollments;
+    TextColumn courseIds = snapshot.text(SnapshotSection::CourseIds);
+    TextColumn courseNames = snapshot.text(SnapshotSection::CourseNames);
+    TextColumn departments = snapshot.text(SnapshotSection::CourseDepartments);
+    TextColumn rollNos = snapshot.text(SnapshotSection::StudentRollNos);
+    TextColumn names = snapshot.text(SnapshotSection::StudentNames);
+    TextColumn batches = snapshot.text(SnapshotSection::StudentBatches);
+    TextColumn programs = snapshot.text(SnapshotSection::StudentPrograms);
+    ArrayView<int32_t> semesters = snapshot.array<int32_t>(SnapshotSection::StudentSemesters);
+    ArrayView<uint32_t> enrollStudents = snapshot.array<uint32_t>(SnapshotSection::EnrollmentStudents);
+    ArrayView<uint32_t> enrollCourses = snapshot.array<uint32_t>(SnapshotSection::EnrollmentCourses);
     
-    if (!connected) {
-        cerr << "Not connected to database." << endl;
-        return enrollments;
+    const size_t courseCount = courseIds.size();
+    const size_t studentCount = rollNos.size();
+    if (!snapshot.isOpen() || courseNames.size() != courseCount || departments.size() != courseCount ||
+        names.size() != studentCount || batches.size() != studentCount || programs.size() != studentCount ||
+        semesters.size() != studentCount || enrollStudents.size() != enrollCourses.size()) {
+        LOG(LogLevel::Error) << "Snapshot has no complete dataset.";
+        return false;
     }
     
-    // Hardcoded mock data - creating realistic conflicts
-    // Student CT-24001
-    enrollments.insertAtEnd(Enrollment("CT-24001", "ML101"));
-    enrollments.insertAtEnd(Enrollment("CT-24001", "OOP201"));
-    enrollments.insertAtEnd(Enrollment("CT-24001", "AI401"));
-    enrollments.insertAtEnd(Enrollment("CT-24001", "DS501"));
-    enrollments.insertAtEnd(Enrollment("CT-24001", "SE701"));
-    
-    // Student CT-24002 to CT-24010 enrollments...
-    // [Previous enrollments remain the same]
+    // The tables own their strings and key hashes, so the mapped columns are copied
+    // rather than used in place. Rows are stored in id order, so re-adding them
+    // reproduces the ids; a repeated key (which would merge two rows) or an
+    // out-of-range enrollment means a bad file
+    EntityStore loaded;
+    loaded.courses.reserve(courseCount);
+    loaded.students.reserve(studentCount);
+    bool valid = true;
+    for (uint32_t c = 0; valid && c < courseCount; c++) {
+        valid = loaded.courses.add(courseIds[c], courseNames[c], departments[c]) == c;
+    }
+    for (uint32_t s = 0; valid && s < studentCount; s++) {
+        valid = loaded.students.add(rollNos[s], names[s], semesters[s], batches[s], programs[s]) == s;
+    }
+    loaded.enrollments.resize(enrollStudents.size());
+    for (size_t i = 0; valid && i < enrollStudents.size(); i++) {
+        valid = enrollStudents[i] < studentCount && enrollCourses[i] < courseCount;
+        loaded.enrollments.set(i, enrollStudents[i], enrollCourses[i]);
+    }
+    if (!valid) {
+        LOG(LogLevel::Error) << "Snapshot dataset is inconsistent (duplicate keys or unknown ids).";
+        return false;
+    }
     
-    // Generate enrollments for students CT-24011 to CT-24320
-    vector<string> allCourses = {"ML101", "OOP201", "DB301", "AI401", "DS501", 
-                               "CN601", "SE701", "WD801", "CC901", "CY102"};
+    store = std::move(loaded);
+    index.build(store);
+    csvDataLoaded = true;
+    connected = false; // Use the snapshot data instead of database
+    lastImport = ImportTimings();
+    lastImport.threads = 1;
+    lastImport.chunks = 1;
+    lastImport.rows = store.enrollments.size();
+    lastImport.mapMs = snapshot.getOpenMs();
+    lastImport.indexMs = index.buildMs();
+    lastImport.mergeMs = elapsedMs(loadStart) - lastImport.indexMs;
+    lastImport.totalMs = lastImport.mapMs + lastImport.mergeMs + lastImport.indexMs;
     
-    for (int i = 11; i <= 320; i++) {
-        string rollNo = "CT-24" + string(3 - to_string(i).length(), '0') + to_string(i);
-        
-        // Each student enrolls in 4-5 courses (creates realistic conflicts)
-        int numCourses = 4 + (i % 2); // Alternates between 4 and 5 courses
-        int startCourse = (i % 6); // Rotate through different starting points
-        
-        for (int j = 0; j < numCourses; j++) {
-            int courseIndex = (startCourse + j) % allCourses.size();
-            enrollments.insertAtEnd(Enrollment(rollNo, allCourses[courseIndex]));
-        }
+    LOG(LogLevel::Info) << "Loaded snapshot: " << store.students.size() << " students, " << store.courses.size()
+                        << " courses, " << store.enrollments.size() << " enrollments (open " << lastImport.mapMs
+                        << " ms, load " << lastImport.mergeMs << " ms, index " << lastImport.indexMs << " ms)";
+    return true;
+}
+
+const CourseTable& DatabaseManager::fetchCourses() {
+    PROFILE_SCOPE("db.fetchCourses");
+    if (!hasData()) {
+        LOG(LogLevel::Error) << "Not connected to database.";
+    } else {
+        LOG(LogLevel::Debug) << "Returning " << store.courses.size() << " courses from "
+                             << (csvDataLoaded ? "CSV data." : "mock database.");
     }
-    
-    cout << "Fetched " << enrollments.getSize() << " enrollments from mock database." << endl;
-    return enrollments;
+    return store.courses;
+}
+
+const StudentTable& DatabaseManager::fetchStudents() {
+    PROFILE_SCOPE("db.fetchStudents");
+    if (!hasData()) {
+        LOG(LogLevel::Error) << "Not connected to database.";
+    } else {
+        LOG(LogLevel::Debug) << "Returning " << store.students.size() << " students from "
+                             << (csvDataLoaded ? "CSV data." : "mock database.");
+    }
+    return store.students;
+}
+
+const EnrollmentTable& DatabaseManager::fetchEnrollments() {
+    PROFILE_SCOPE("db.fetchEnrollments");
+    if (!hasData()) {
+        LOG(LogLevel::Error) << "Not connected to database.";
+    } else {
+        LOG(LogLevel::Debug) << "Returning " << store.enrollments.size() << " enrollments from "
+                             << (csvDataLoaded ? "CSV data." : "mock database.");
+    }
+    return store.enrollments;
 }
 
 vector<string> DatabaseManager::getCourseCodes() {
+    const CourseTable& courses = store.courses;
     vector<string> codes;
-    LinkedList<Course> courses = fetchCourses();
-    Node<Course>* current = courses.getHead();
+    codes.reserve(courses.size());
     
-    while (current != nullptr) {
-        codes.push_back(current->data.courseId);
-        current = current->next;
+    for (uint32_t c = 0; c < courses.size(); c++) {
+        codes.push_back(courses.id(c));
     }
     return codes;
 }
 
 vector<string> DatabaseManager::getCourseNames() {
+    const CourseTable& courses = store.courses;
     vector<string> names;
-    LinkedList<Course> courses = fetchCourses();
-    Node<Course>* current = courses.getHead();
+    names.reserve(courses.size());
     
-    while (current != nullptr) {
-        names.push_back(current->data.courseName);
-        current = current->next;
+    for (uint32_t c = 0; c < courses.size(); c++) {
+        names.push_back(courses.name(c));
     }
     return names;
 }
 
 vector<pair<string, string>> DatabaseManager::getStudentList() {
+    const StudentTable& students = store.students;
     vector<pair<string, string>> studentInfo;
-    LinkedList<Student> students = fetchStudents();
-    Node<Student>* current = students.getHead();
+    studentInfo.reserve(students.size());
     
-    while (current != nullptr) {
-        studentInfo.push_back(make_pair(current->data.rollNo, current->data.name));
-        current = current->next;
+    for (uint32_t s = 0; s < students.size(); s++) {
+        studentInfo.emplace_back(students.rollNo(s), students.name(s));
     }
     return studentInfo;
 }
 
 vector<pair<string, vector<string>>> DatabaseManager::getStudentEnrollments() {
-    vector<pair<string, vector<string>>> enrollmentMap;
-    LinkedList<Student> students = fetchStudents();
-    LinkedList<Enrollment> allEnrollments = fetchEnrollments();
+    const StudentTable& students = store.students;
+    const CourseTable& courses = store.courses;
     
-    Node<Student>* currentStudent = students.getHead();
-    while (currentStudent != nullptr) {
-        vector<string> studentCourses;
-        Node<Enrollment>* currentEnroll = allEnrollments.getHead();
-        
-        while (currentEnroll != nullptr) {
-            if (currentEnroll->data.rollNo == currentStudent->data.rollNo) {
-                studentCourses.push_back(currentEnroll->data.courseId);
-            }
-            currentEnroll = currentEnroll->next;
+    // Each student's courses are one contiguous run of the index (enrollment order)
+    vector<pair<string, vector<string>>> enrollmentMap(students.size());
+    for (uint32_t s = 0; s < students.size(); s++) {
+        enrollmentMap[s].first = students.rollNo(s);
+        ArrayView<uint32_t> enrolled = index.coursesOf(s);
+        enrollmentMap[s].second.reserve(enrolled.size());
+        for (uint32_t course : enrolled) {
+            enrollmentMap[s].second.push_back(courses.id(course));
         }
-        
-        enrollmentMap.push_back(make_pair(currentStudent->data.rollNo, studentCourses));
-        currentStudent = currentStudent->next;
     }
     return enrollmentMap;
 }
 
 map<string, int> DatabaseManager::getCourseSizes() {
-    map<string, int> courseSizes;
-    LinkedList<Enrollment> enrollments = fetchEnrollments();
-    Node<Enrollment>* current = enrollments.getHead();
+    const CourseTable& courses = store.courses;
     
-    while (current != nullptr) {
-        courseSizes[current->data.courseId]++;
-        current = current->next;
+    map<string, int> courseSizes;
+    for (uint32_t c = 0; c < courses.size(); c++) {
+        if (index.enrollmentCount(c) > 0) {
+            courseSizes.emplace(courses.id(c), static_cast<int>(index.enrollmentCount(c)));
+        }
     }
     return courseSizes;
-}
\ No newline at end of file
+}
@@ -0,0 +1,104 @@
+#include "../include/EntityStore.h"
+
+uint32_t StringInterner::intern(std::string_view s) {
+    auto it = index.find(s);
+    if (it != index.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.emplace_back(s);
+    index.emplace(std::string_view(strings.back()), id);
+    return id;
+}
+
+uint32_t StringInterner::find(std::string_view s) const {
+    auto it = index.find(s);
+    return it != index.end() ? it->second : kInvalidId;
+}
+
+void StringInterner::clear() {
+    index.clear();
+    strings.clear();
+}
+
+uint32_t CourseTable::add(std::string_view courseId, std::string_view name, std::string_view department) {
+    uint32_t c = ids.intern(courseId);
+    if (c == names.size()) {
+        names.emplace_back(name);
+        departments.emplace_back(department);
+    }
+    return c;
+}
+
+void CourseTable::reserve(size_t n) {
+    ids.reserve(n);
+    names.reserve(n);
+    departments.reserve(n);
+}
+
+void CourseTable::clear() {
+    ids.clear();
+    names.clear();
+    departments.clear();
+}
+
+uint32_t StudentTable::add(std::string_view rollNo, std::string_view name, int semester,
+                           std::string_view batch, std::string_view program) {
+    uint32_t s = rollNos.intern(rollNo);
+    if (s == names.size()) {
+        names.emplace_back(name);
+        semesters.push_back(semester);
+        batches.emplace_back(batch);
+        programs.emplace_back(program);
+    }
+    return s;
+}
+
+Student StudentTable::row(uint32_t s) const {
+    Student student(rollNo(s), name(s), batch(s), program(s));
+    student.semester = semester(s);
+    return student;
+}
+
+void StudentTable::reserve(size_t n) {
+    rollNos.reserve(n);
+    names.reserve(n);
+    semesters.reserve(n);
+    batches.reserve(n);
+    programs.reserve(n);
+}
+
+void StudentTable::clear() {
+    rollNos.clear();
+    names.clear();
+    semesters.clear();
+    batches.clear();
+    programs.clear();
+}
+
+void EnrollmentTable::reserve(size_t n) {
+    students.reserve(n);
+    courses.reserve(n);
+}
+
+void EnrollmentTable::clear() {
+    students.clear();
+    courses.clear();
+}
+
+bool EntityStore::addEnrollment(std::string_view rollNo, std::string_view courseId) {
+    uint32_t s = students.find(rollNo);
+    uint32_t c = courses.find(courseId);
+    if (s == kInvalidId || c == kInvalidId) {
+        return false;
+    }
+    enrollments.add(s, c);
+    return true;
+}
+
+void EntityStore::clear() {
+    courses.clear();
+    students.clear();
+    enrollments.clear();
+}
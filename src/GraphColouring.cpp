@@ -0,0 +1,89 @@
+#include "../include/GraphColouring.h"
+#include "../include/Profiler.h"
+#include <iterator>
+#include <set>
+#include <tuple>
+
+namespace {
+
+// Per-course set of colours already used by neighbours, as a growable bitset
+class ColourSet {
+public:
+    bool contains(uint32_t colour) const {
+        size_t word = colour / 64;
+        return word < words.size() && (words[word] >> (colour % 64)) & 1;
+    }
+
+    void insert(uint32_t colour) {
+        size_t word = colour / 64;
+        if (word >= words.size()) {
+            words.resize(word + 1, 0);
+        }
+        words[word] |= uint64_t(1) << (colour % 64);
+    }
+
+    uint32_t smallestMissing() const {
+        for (size_t w = 0; w < words.size(); w++) {
+            if (words[w] != ~uint64_t(0)) {
+                uint64_t free = ~words[w];
+                uint32_t bit = 0;
+                while (((free >> bit) & 1) == 0) {
+                    bit++;
+                }
+                return static_cast<uint32_t>(w * 64 + bit);
+            }
+        }
+        return static_cast<uint32_t>(words.size() * 64);
+    }
+
+private:
+    std::vector<uint64_t> words;
+};
+
+} // namespace
+
+Colouring colourDSatur(const ConflictGraph& graph, const std::vector<bool>& include) {
+    PROFILE_SCOPE("generate.colouring");
+    const uint32_t n = static_cast<uint32_t>(graph.courseCount());
+    Colouring result;
+    result.colour.assign(n, kInvalidId);
+
+    std::vector<uint32_t> saturation(n, 0);
+    std::vector<ColourSet> neighbourColours(n);
+
+    // Highest (saturation, degree, size) first; lower id wins the final tie
+    using Key = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>;
+    auto keyOf = [&](uint32_t c) {
+        return Key(saturation[c], graph.degree(c), graph.courseSize(c), ~c);
+    };
+    std::set<Key> candidates;
+    for (uint32_t c = 0; c < n; c++) {
+        if (include[c]) {
+            candidates.insert(keyOf(c));
+        }
+    }
+
+    while (!candidates.empty()) {
+        auto top = std::prev(candidates.end());
+        uint32_t c = ~std::get<3>(*top);
+        candidates.erase(top);
+
+        uint32_t colour = neighbourColours[c].smallestMissing();
+        result.colour[c] = colour;
+        if (colour + 1 > result.colourCount) {
+            result.colourCount = colour + 1;
+        }
+
+        for (uint32_t d : graph.neighbours(c)) {
+            if (!include[d] || result.colour[d] != kInvalidId || neighbourColours[d].contains(colour)) {
+                continue;
+            }
+            candidates.erase(keyOf(d));
+            neighbourColours[d].insert(colour);
+            saturation[d]++;
+            candidates.insert(keyOf(d));
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,370 @@
+#include "../include/Logger.h"
+#include "../include/CivilDate.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+namespace {
+
+constexpr size_t kRingSlots = 1024; // Power of two
+constexpr auto kIdleWait = std::chrono::milliseconds(50);
+
+struct Slot {
+    std::atomic<uint64_t> sequence;
+    int64_t timeUs;             // UTC microseconds since 01-01-1970
+    LogLevel level;
+    uint16_t length;
+    char text[kLogLineBytes];
+};
+
+// Fixed-size line buffer; text beyond kLogLineBytes is dropped
+class LineBuffer : public std::streambuf {
+public:
+    LineBuffer() { reset(); }
+
+    void reset() { setp(data, data + sizeof(data)); }
+    std::string_view text() const { return std::string_view(pbase(), static_cast<size_t>(pptr() - pbase())); }
+
+protected:
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        const std::streamsize room = std::min<std::streamsize>(n, epptr() - pptr());
+        std::memcpy(pptr(), s, static_cast<size_t>(room));
+        pbump(static_cast<int>(room));
+        return n;
+    }
+
+private:
+    char data[kLogLineBytes];
+};
+
+// Per-thread stream for LOG, so formatting a line neither allocates nor locks
+struct ThreadLine {
+    LineBuffer buffer;
+    std::ostream out;
+    std::ios_base::fmtflags defaultFlags;
+
+    ThreadLine() : out(&buffer), defaultFlags(out.flags()) {}
+};
+
+ThreadLine& threadLine() {
+    thread_local ThreadLine line;
+    return line;
+}
+
+int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const char* levelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "Debug: ";
+        case LogLevel::Info: return "Info: ";
+        case LogLevel::Warning: return "Warning: ";
+        default: return "Error: ";
+    }
+}
+
+class Logger {
+public:
+    Logger()
+        : ring(new Slot[kRingSlots]), enqueuePos(0), dequeuePos(0), writtenPos(0),
+          sleeping(false), stopping(false), running(true),
+          consoleLevel(LogLevel::Info), consoleStream(nullptr), file(nullptr), fileLevel(LogLevel::Off) {
+        for (size_t i = 0; i < kRingSlots; i++) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer = std::thread([this]() { run(); });
+    }
+
+    void push(LogLevel level, std::string_view message) {
+        const int64_t time = nowUs();
+        if (!running.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            format(level, time, message);
+            emit();
+            return;
+        }
+
+        uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &ring[pos & (kRingSlots - 1)];
+            const int64_t diff = static_cast<int64_t>(slot->sequence.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Full: let the writer catch up rather than lose the line
+                wakeWriter();
+                std::this_thread::yield();
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        const size_t length = std::min(message.size(), kLogLineBytes);
+        std::memcpy(slot->text, message.data(), length);
+        slot->length = static_cast<uint16_t>(length);
+        slot->level = level;
+        slot->timeUs = time;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed)) {
+            wakeWriter();
+        }
+    }
+
+    void flush() {
+        const uint64_t target = enqueuePos.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.notify_one();
+        flushed.wait(lock, [&]() {
+            return writtenPos.load(std::memory_order_acquire) >= target || !running.load(std::memory_order_acquire);
+        });
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running.load(std::memory_order_acquire)) {
+                return;
+            }
+            stopping.store(true, std::memory_order_release);
+            wake.notify_one();
+        }
+        writer.join();
+        running.store(false, std::memory_order_release);
+        drain(); // Lines pushed while the writer was stopping
+        std::lock_guard<std::mutex> lock(mutex);
+        flushed.notify_all();
+    }
+
+    void setConsole(LogLevel minimum, std::FILE* stream) {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        consoleLevel = minimum;
+        consoleStream = stream;
+        updateThreshold();
+    }
+
+    bool openFile(const std::string& filename, LogLevel minimum, bool append) {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        closeFileLocked();
+        file = std::fopen(filename.c_str(), append ? "ab" : "wb");
+        fileLevel = file != nullptr ? minimum : LogLevel::Off;
+        updateThreshold();
+        return file != nullptr;
+    }
+
+    void closeFile() {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        closeFileLocked();
+        updateThreshold();
+    }
+
+private:
+    void wakeWriter() {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake.notify_one();
+    }
+
+    bool pending() const {
+        return ring[dequeuePos & (kRingSlots - 1)].sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+    }
+
+    void run() {
+        for (;;) {
+            const bool stop = stopping.load(std::memory_order_acquire);
+            if (drain() > 0) {
+                continue;
+            }
+            if (stop) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!pending() && !stopping.load(std::memory_order_acquire)) {
+                wake.wait_for(lock, kIdleWait);
+            }
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Moves every ready line to the sinks as one batch; returns the line count
+    size_t drain() {
+        size_t lines = 0;
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            while (lines < kRingSlots && pending()) {
+                Slot& slot = ring[dequeuePos & (kRingSlots - 1)];
+                format(slot.level, slot.timeUs, std::string_view(slot.text, slot.length));
+                slot.sequence.store(dequeuePos + kRingSlots, std::memory_order_release);
+                dequeuePos++;
+                lines++;
+            }
+            if (lines > 0) {
+                emit();
+            }
+        }
+        if (lines > 0) {
+            writtenPos.store(dequeuePos, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(mutex);
+            flushed.notify_all();
+        }
+        return lines;
+    }
+
+    // Appends one line to the batch of every sink that takes its level (sinkMutex held)
+    void format(LogLevel level, int64_t timeUs, std::string_view message) {
+        if (level >= consoleLevel) {
+            std::string& out = consoleStream == nullptr && level <= LogLevel::Info ? outBatch : errBatch;
+            if (level != LogLevel::Info) {
+                out += levelTag(level);
+            }
+            out.append(message.data(), message.size());
+            out += '\n';
+        }
+        if (file != nullptr && level >= fileLevel) {
+            const int64_t seconds = timeUs >= 0 ? timeUs / 1000000 : (timeUs - 999999) / 1000000;
+            const int64_t secondOfDay = ((seconds % 86400) + 86400) % 86400;
+            const CivilDate date = civilFromDays(static_cast<int32_t>((seconds - secondOfDay) / 86400));
+            char stamp[48];
+            const int length = std::snprintf(stamp, sizeof(stamp), "%04d-%02u-%02u %02d:%02d:%02d.%03dZ ",
+                                             date.year, date.month, date.day,
+                                             static_cast<int>(secondOfDay / 3600),
+                                             static_cast<int>(secondOfDay / 60 % 60),
+                                             static_cast<int>(secondOfDay % 60),
+                                             static_cast<int>((timeUs - seconds * 1000000) / 1000));
+            fileBatch.append(stamp, static_cast<size_t>(std::max(length, 0)));
+            fileBatch += levelTag(level);
+            fileBatch.append(message.data(), message.size());
+            fileBatch += '\n';
+        }
+    }
+
+    // Writes and clears the batches, one write per sink (sinkMutex held)
+    void emit() {
+        auto put = [](std::FILE* stream, std::string& batch) {
+            if (!batch.empty()) {
+                std::fwrite(batch.data(), 1, batch.size(), stream);
+                std::fflush(stream);
+                batch.clear();
+            }
+        };
+        put(stdout, outBatch);
+        put(consoleStream != nullptr ? consoleStream : stderr, errBatch);
+        if (file != nullptr) {
+            put(file, fileBatch);
+        }
+    }
+
+    void closeFileLocked() {
+        if (file != nullptr) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        fileLevel = LogLevel::Off;
+    }
+
+    void updateThreshold() {
+        Log::threshold.store(static_cast<uint8_t>(std::min(consoleLevel, fileLevel)), std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<Slot[]> ring;
+    alignas(64) std::atomic<uint64_t> enqueuePos;
+    alignas(64) uint64_t dequeuePos;        // Writer thread only (and shutdown() after the join)
+    std::atomic<uint64_t> writtenPos;       // Lines handed to the sinks
+
+    std::mutex mutex;                       // Guards sleeping/flush handshakes
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::atomic<bool> sleeping;
+    std::atomic<bool> stopping;
+    std::atomic<bool> running;
+    std::thread writer;
+
+    std::mutex sinkMutex;                   // Sink settings and batches
+    LogLevel consoleLevel;
+    std::FILE* consoleStream;
+    std::FILE* file;
+    LogLevel fileLevel;
+    std::string outBatch;
+    std::string errBatch;
+    std::string fileBatch;
+};
+
+std::atomic<Logger*> started(nullptr);
+
+// Never destroyed, so lines logged from other static destructors stay safe
+Logger& logger() {
+    static Logger* instance = new Logger();
+    started.store(instance, std::memory_order_release);
+    return *instance;
+}
+
+struct ShutdownAtExit {
+    ~ShutdownAtExit() {
+        if (started.load(std::memory_order_acquire) != nullptr) {
+            Log::shutdown();
+        }
+    }
+} shutdownAtExit;
+
+} // namespace
+
+namespace Log {
+
+std::atomic<uint8_t> threshold(static_cast<uint8_t>(LogLevel::Info));
+
+void setConsole(LogLevel minimum, std::FILE* stream) {
+    logger().setConsole(minimum, stream);
+}
+
+bool openFile(const std::string& filename, LogLevel minimum, bool append) {
+    return logger().openFile(filename, minimum, append);
+}
+
+void closeFile() {
+    logger().closeFile();
+}
+
+void write(LogLevel level, std::string_view message) {
+    if (enabled(level)) {
+        logger().push(level, message);
+    }
+}
+
+void flush() {
+    logger().flush();
+}
+
+void shutdown() {
+    logger().shutdown();
+}
+
+} // namespace Log
+
+LogLine::LogLine(LogLevel level)
+    : level(level), out(threadLine().out) {
+    ThreadLine& line = threadLine();
+    line.buffer.reset();
+    out.clear();
+    out.flags(line.defaultFlags);
+    out.precision(6);
+    out.width(0);
+    out.fill(' ');
+}
+
+LogLine::~LogLine() {
+    Log::write(level, static_cast<LineBuffer*>(out.rdbuf())->text());
+}
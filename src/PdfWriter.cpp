@@ -0,0 +1,197 @@
+#include "../include/PdfWriter.h"
+#include "../include/Logger.h"
+#include <cstdio>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+// Fixed object numbers; everything else is numbered as it is written
+const uint32_t kCatalogId = 1;
+const uint32_t kPagesId = 2;
+const uint32_t kResourcesId = 3;
+
+std::string formatNumber(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%g", value);
+    return buffer;
+}
+
+} // namespace
+
+PdfWriter::PdfWriter()
+    : offset(0), width(612), height(792) {
+}
+
+PdfWriter::~PdfWriter() {
+    if (file.is_open()) {
+        close();
+    }
+}
+
+bool PdfWriter::open(const std::string& filename, double pageWidth, double pageHeight) {
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    offset = 0;
+    width = pageWidth;
+    height = pageHeight;
+    objectOffsets.assign(kResourcesId + 1, 0);
+    pageIds.clear();
+    forms.clear();
+
+    // Binary comment so transfer tools treat the file as binary
+    write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+    return true;
+}
+
+uint32_t PdfWriter::newObject() {
+    objectOffsets.push_back(0);
+    return static_cast<uint32_t>(objectOffsets.size() - 1);
+}
+
+void PdfWriter::beginObject(uint32_t id) {
+    objectOffsets[id] = offset;
+    write(std::to_string(id) + " 0 obj\n");
+}
+
+void PdfWriter::write(const std::string& text) {
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    offset += text.size();
+}
+
+bool PdfWriter::deflate(const std::string& content, std::string& out) {
+#ifdef HAVE_ZLIB
+    uLongf length = compressBound(static_cast<uLong>(content.size()));
+    out.resize(length);
+    if (compress2(reinterpret_cast<Bytef*>(&out[0]), &length,
+                  reinterpret_cast<const Bytef*>(content.data()), static_cast<uLong>(content.size()),
+                  Z_DEFAULT_COMPRESSION) == Z_OK) {
+        out.resize(length);
+        return true;
+    }
+#else
+    (void)content;
+    (void)out;
+#endif
+    return false;
+}
+
+PdfStream PdfWriter::encodeStream(std::string content) {
+    PdfStream stream;
+    stream.deflated = deflate(content, stream.data);
+    if (!stream.deflated) {
+        stream.data = std::move(content);
+    }
+    return stream;
+}
+
+void PdfWriter::writeStream(uint32_t id, const std::string& dictionary, const std::string& content) {
+    if (deflate(content, compressed)) {
+        writeEncoded(id, dictionary, compressed, true);
+    } else {
+        writeEncoded(id, dictionary, content, false);
+    }
+}
+
+void PdfWriter::writeEncoded(uint32_t id, const std::string& dictionary, const std::string& data, bool deflated) {
+    beginObject(id);
+    write("<< " + dictionary + (deflated ? " /Filter /FlateDecode" : "") + " /Length " + std::to_string(data.size()) +
+          " >>\nstream\n");
+    write(data);
+    write("\nendstream\nendobj\n");
+}
+
+void PdfWriter::addForm(const std::string& name, const std::string& content,
+                        double left, double bottom, double right, double top) {
+    addForm(name, encodeStream(content), left, bottom, right, top);
+}
+
+void PdfWriter::addForm(const std::string& name, const PdfStream& content,
+                        double left, double bottom, double right, double top) {
+    uint32_t id = newObject();
+    writeEncoded(id, "/Type /XObject /Subtype /Form /BBox [" + formatNumber(left) + " " + formatNumber(bottom) + " " +
+                     formatNumber(right) + " " + formatNumber(top) + "] /Resources " +
+                     std::to_string(kResourcesId) + " 0 R",
+                 content.data, content.deflated);
+    forms.emplace_back(name, id);
+}
+
+void PdfWriter::addPage(const std::string& content) {
+    uint32_t contentId = newObject();
+    writeStream(contentId, "", content);
+    writePage(contentId);
+}
+
+void PdfWriter::addPage(const PdfStream& content) {
+    uint32_t contentId = newObject();
+    writeEncoded(contentId, "", content.data, content.deflated);
+    writePage(contentId);
+}
+
+void PdfWriter::writePage(uint32_t contentId) {
+    uint32_t pageId = newObject();
+    beginObject(pageId);
+    write("<< /Type /Page /Parent " + std::to_string(kPagesId) + " 0 R /Resources " + std::to_string(kResourcesId) +
+          " 0 R /MediaBox [0 0 " + formatNumber(width) + " " + formatNumber(height) + "] /Contents " +
+          std::to_string(contentId) + " 0 R >>\nendobj\n");
+    pageIds.push_back(pageId);
+}
+
+bool PdfWriter::close() {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Page tree
+    beginObject(kPagesId);
+    std::string kids;
+    for (uint32_t id : pageIds) {
+        kids += std::to_string(id) + " 0 R ";
+    }
+    write("<< /Type /Pages /Kids [" + kids + "] /Count " + std::to_string(pageIds.size()) + " >>\nendobj\n");
+
+    // Shared resources
+    beginObject(kResourcesId);
+    std::string xobjects;
+    for (const auto& form : forms) {
+        xobjects += "/" + form.first + " " + std::to_string(form.second) + " 0 R ";
+    }
+    write("<< /Font << /F1 << /Type /Font /Subtype /Type1 /BaseFont /Helvetica >> >>" +
+          (xobjects.empty() ? std::string() : " /XObject << " + xobjects + ">>") + " >>\nendobj\n");
+
+    beginObject(kCatalogId);
+    write("<< /Type /Catalog /Pages " + std::to_string(kPagesId) + " 0 R >>\nendobj\n");
+
+    // Cross-reference table, entries are exactly 20 bytes
+    uint64_t xrefOffset = offset;
+    write("xref\n0 " + std::to_string(objectOffsets.size()) + "\n0000000000 65535 f \n");
+    char entry[32];
+    for (size_t id = 1; id < objectOffsets.size(); id++) {
+        std::snprintf(entry, sizeof(entry), "%010llu 00000 n \n", static_cast<unsigned long long>(objectOffsets[id]));
+        write(entry);
+    }
+    write("trailer\n<< /Size " + std::to_string(objectOffsets.size()) + " /Root " + std::to_string(kCatalogId) +
+          " 0 R >>\nstartxref\n" + std::to_string(xrefOffset) + "\n%%EOF\n");
+
+    bool ok = file.good();
+    file.close();
+    if (!ok) {
+        LOG(LogLevel::Error) << "Failed while writing PDF output.";
+    }
+    return ok;
+}
+
+std::string PdfWriter::escapeText(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char ch : text) {
+        if (ch == '(' || ch == ')' || ch == '\\') {
+            escaped += '\\';
+        }
+        escaped += ch;
+    }
+    return escaped;
+}
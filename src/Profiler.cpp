@@ -0,0 +1,311 @@
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+struct SiteTotals {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> value{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> minNs{UINT64_MAX};
+    std::atomic<uint64_t> maxNs{0};
+};
+
+struct TraceEvent {
+    uint32_t site;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+// Written only by its thread; read under `eventMutex` (events) or through the atomics (totals)
+struct ThreadProfile {
+    explicit ThreadProfile(uint32_t tid) : tid(tid), dropped(0) {}
+
+    uint32_t tid;
+    SiteTotals totals[kMaxProfileSites];
+    std::mutex eventMutex;
+    std::vector<TraceEvent> events;
+    uint64_t dropped;
+};
+
+// Single writer per thread, so a load-add-store is enough
+void bump(std::atomic<uint64_t>& total, uint64_t amount) {
+    total.store(total.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<ProfileKind> kinds;
+    std::vector<std::unique_ptr<ThreadProfile>> threads;
+    std::vector<ThreadProfile*> idle;      // Profiles of exited threads, reused by new ones
+    uint64_t epochNs = 0;
+};
+
+// Never destroyed, so threads exiting during shutdown can still release their profile
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+// Hands the thread's profile back to the registry when the thread exits
+struct ThreadSlot {
+    ThreadProfile* profile = nullptr;
+
+    ~ThreadSlot() {
+        if (profile != nullptr) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.idle.push_back(profile);
+        }
+    }
+};
+
+ThreadProfile& threadProfile() {
+    thread_local ThreadSlot slot;
+    if (slot.profile == nullptr) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (!r.idle.empty()) {
+            slot.profile = r.idle.back();
+            r.idle.pop_back();
+        } else {
+            r.threads.push_back(std::make_unique<ThreadProfile>(static_cast<uint32_t>(r.threads.size() + 1)));
+            slot.profile = r.threads.back().get();
+        }
+    }
+    return *slot.profile;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    return out + "\"";
+}
+
+double toMs(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+ProfileSite::ProfileSite(const char* name, ProfileKind kind) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto found = std::find(r.names.begin(), r.names.end(), name);
+    if (found != r.names.end()) {
+        index = static_cast<uint32_t>(found - r.names.begin());
+    } else if (r.names.size() < kMaxProfileSites) {
+        index = static_cast<uint32_t>(r.names.size());
+        r.names.push_back(name);
+        r.kinds.push_back(kind);
+    } else {
+        index = kMaxProfileSites; // Table full: not recorded
+    }
+}
+
+namespace Profiler {
+
+std::atomic<bool> active(false);
+
+void setEnabled(bool enable) {
+    if (enable && !active.load(std::memory_order_relaxed)) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (r.epochNs == 0) {
+            r.epochNs = nowNs();
+        }
+    }
+    active.store(enable, std::memory_order_relaxed);
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& thread : r.threads) {
+        for (SiteTotals& totals : thread->totals) {
+            totals.calls.store(0, std::memory_order_relaxed);
+            totals.value.store(0, std::memory_order_relaxed);
+            totals.totalNs.store(0, std::memory_order_relaxed);
+            totals.minNs.store(UINT64_MAX, std::memory_order_relaxed);
+            totals.maxNs.store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> events(thread->eventMutex);
+        thread->events.clear();
+        thread->dropped = 0;
+    }
+    r.epochNs = nowNs();
+}
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void recordScope(const ProfileSite& site, uint64_t startNs, uint64_t endNs) {
+    if (site.index >= kMaxProfileSites) {
+        return;
+    }
+    ThreadProfile& profile = threadProfile();
+    SiteTotals& totals = profile.totals[site.index];
+    const uint64_t ns = endNs - startNs;
+    bump(totals.calls, 1);
+    bump(totals.totalNs, ns);
+    if (ns < totals.minNs.load(std::memory_order_relaxed)) {
+        totals.minNs.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > totals.maxNs.load(std::memory_order_relaxed)) {
+        totals.maxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(profile.eventMutex);
+    if (profile.events.size() < kMaxProfileEvents) {
+        profile.events.push_back(TraceEvent{site.index, startNs, endNs});
+    } else {
+        profile.dropped++;
+    }
+}
+
+void add(const ProfileSite& site, uint64_t amount) {
+    if (site.index >= kMaxProfileSites) {
+        return;
+    }
+    SiteTotals& totals = threadProfile().totals[site.index];
+    bump(totals.calls, 1);
+    bump(totals.value, amount);
+}
+
+std::vector<ProfileStat> stats() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<ProfileStat> merged(r.names.size());
+    std::vector<uint64_t> totalNs(r.names.size(), 0);
+    std::vector<uint64_t> minNs(r.names.size(), UINT64_MAX);
+    std::vector<uint64_t> maxNs(r.names.size(), 0);
+    for (const auto& thread : r.threads) {
+        for (size_t i = 0; i < merged.size(); i++) {
+            const SiteTotals& totals = thread->totals[i];
+            merged[i].calls += totals.calls.load(std::memory_order_relaxed);
+            merged[i].value += totals.value.load(std::memory_order_relaxed);
+            totalNs[i] += totals.totalNs.load(std::memory_order_relaxed);
+            minNs[i] = std::min(minNs[i], totals.minNs.load(std::memory_order_relaxed));
+            maxNs[i] = std::max(maxNs[i], totals.maxNs.load(std::memory_order_relaxed));
+        }
+    }
+
+    std::vector<ProfileStat> result;
+    for (size_t i = 0; i < merged.size(); i++) {
+        if (merged[i].calls == 0) {
+            continue;
+        }
+        ProfileStat stat = merged[i];
+        stat.name = r.names[i];
+        stat.kind = r.kinds[i];
+        if (stat.kind == ProfileKind::Timer) {
+            stat.totalMs = toMs(totalNs[i]);
+            stat.minMs = toMs(minNs[i]);
+            stat.maxMs = toMs(maxNs[i]);
+        }
+        result.push_back(stat);
+    }
+    std::sort(result.begin(), result.end(), [](const ProfileStat& a, const ProfileStat& b) {
+        return a.name < b.name;
+    });
+    return result;
+}
+
+uint64_t droppedEvents() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    uint64_t dropped = 0;
+    for (const auto& thread : r.threads) {
+        std::lock_guard<std::mutex> events(thread->eventMutex);
+        dropped += thread->dropped;
+    }
+    return dropped;
+}
+
+std::string statsJson() {
+    std::vector<ProfileStat> all = stats();
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"enabled\": " << (enabled() ? "true" : "false") << ",\n";
+    json << "  \"droppedEvents\": " << droppedEvents() << ",\n";
+    json << "  \"stats\": [";
+    for (size_t i = 0; i < all.size(); i++) {
+        const ProfileStat& s = all[i];
+        json << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(s.name);
+        if (s.kind == ProfileKind::Timer) {
+            json << ", \"kind\": \"timer\", \"calls\": " << s.calls << ", \"totalMs\": " << s.totalMs
+                 << ", \"minMs\": " << s.minMs << ", \"maxMs\": " << s.maxMs << "}";
+        } else {
+            json << ", \"kind\": \"counter\", \"calls\": " << s.calls << ", \"value\": " << s.value << "}";
+        }
+    }
+    json << (all.empty() ? "]\n" : "\n  ]\n");
+    json << "}\n";
+    return json.str();
+}
+
+bool writeStatsJson(const std::string& filename) {
+    std::ofstream out(filename);
+    out << statsJson();
+    return out.good();
+}
+
+bool writeChromeTrace(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    std::vector<ProfileStat> counters = stats();
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    // Timestamps and durations are microseconds since the profiler was enabled or reset
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    uint64_t lastNs = r.epochNs;
+    for (const auto& thread : r.threads) {
+        separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread->tid
+                    << ", \"args\": {\"name\": \"thread " << thread->tid << "\"}}";
+        std::lock_guard<std::mutex> events(thread->eventMutex);
+        for (const TraceEvent& event : thread->events) {
+            if (event.startNs < r.epochNs) {
+                continue;
+            }
+            separator() << "{\"name\": " << jsonString(r.names[event.site]) << ", \"cat\": \"timetable\", "
+                        << "\"ph\": \"X\", \"pid\": 1, \"tid\": " << thread->tid
+                        << ", \"ts\": " << static_cast<double>(event.startNs - r.epochNs) / 1e3
+                        << ", \"dur\": " << static_cast<double>(event.endNs - event.startNs) / 1e3 << "}";
+            lastNs = std::max(lastNs, event.endNs);
+        }
+    }
+    for (const ProfileStat& stat : counters) {
+        if (stat.kind == ProfileKind::Counter) {
+            separator() << "{\"name\": " << jsonString(stat.name) << ", \"ph\": \"C\", \"pid\": 1, \"tid\": 1, "
+                        << "\"ts\": " << static_cast<double>(lastNs - r.epochNs) / 1e3
+                        << ", \"args\": {\"value\": " << stat.value << "}}";
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+
+} // namespace Profiler
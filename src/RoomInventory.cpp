@@ -0,0 +1,402 @@
+#include "../include/RoomInventory.h"
+#include "../include/CsvReader.h"
+#include "../include/CivilDate.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <unordered_set>
+
+namespace {
+
+bool parseRoomType(std::string_view text, RoomType& type) {
+    text = trim(text);
+    if (text.empty() || equalsIgnoreCase(text, "classroom") || equalsIgnoreCase(text, "room")) {
+        type = RoomType::Classroom;
+    } else if (equalsIgnoreCase(text, "lab")) {
+        type = RoomType::Lab;
+    } else if (equalsIgnoreCase(text, "hall")) {
+        type = RoomType::Hall;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+RoomInventory RoomInventory::standardCampus() {
+    RoomInventory inventory;
+    for (int n = 1; n <= 11; n++) {
+        inventory.addRoom(Room{"Room#" + std::to_string(n), 55, RoomType::Classroom, kEveryDay});
+    }
+    for (int n = 1; n <= 4; n++) {
+        inventory.addRoom(Room{"Lab" + std::to_string(n), 55, RoomType::Lab, kEveryDay});
+    }
+    return inventory;
+}
+
+bool RoomInventory::loadFromCSV(const std::string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open rooms file: " << filename;
+        return false;
+    }
+
+    CsvReader reader(file.data(), file.data() + file.size());
+    std::vector<CsvField> fields;
+    reader.nextRecord(fields); // Header
+
+    std::vector<Room> loaded;
+    std::unordered_set<std::string> names;
+    std::string scratch;
+    size_t line = 1;
+    while (reader.nextRecord(fields)) {
+        line++;
+        if (fields.empty() || (fields.size() == 1 && trim(fields[0].text).empty())) {
+            continue;
+        }
+        Room room;
+        room.name = std::string(trim(fields[0].value(scratch)));
+        std::string capacity = fields.size() > 1 ? std::string(trim(fields[1].text)) : std::string();
+        char* end = nullptr;
+        unsigned long seats = std::strtoul(capacity.c_str(), &end, 10);
+        if (room.name.empty() || capacity.empty() || *end != '\0' || seats == 0 || seats > 1000000) {
+            LOG(LogLevel::Error) << filename << ":" << line << ": expected a room name and a positive capacity";
+            return false;
+        }
+        room.capacity = static_cast<uint32_t>(seats);
+        if (fields.size() > 2 && !parseRoomType(fields[2].text, room.type)) {
+            LOG(LogLevel::Error) << filename << ":" << line << ": unknown room type '" << fields[2].text << "'";
+            return false;
+        }
+        if (fields.size() > 3 && !parseWeekdays(fields[3].text, room.weekdays)) {
+            LOG(LogLevel::Error) << filename << ":" << line << ": invalid days '" << fields[3].text << "'";
+            return false;
+        }
+        if (!names.insert(room.name).second) {
+            LOG(LogLevel::Error) << filename << ":" << line << ": duplicate room '" << room.name << "'";
+            return false;
+        }
+        loaded.push_back(std::move(room));
+    }
+
+    if (loaded.empty()) {
+        LOG(LogLevel::Error) << "No rooms found in " << filename;
+        return false;
+    }
+    rooms.swap(loaded);
+    LOG(LogLevel::Info) << "Loaded " << rooms.size() << " rooms (" << smallestCapacity() << "-" << largestCapacity()
+                        << " seats) from " << filename;
+    return true;
+}
+
+void RoomInventory::addRoom(const Room& room) {
+    rooms.push_back(room);
+}
+
+uint32_t RoomInventory::largestCapacity() const {
+    uint32_t largest = 0;
+    for (const Room& room : rooms) {
+        largest = std::max(largest, room.capacity);
+    }
+    return largest;
+}
+
+uint32_t RoomInventory::smallestCapacity() const {
+    if (rooms.empty()) {
+        return 0;
+    }
+    uint32_t smallest = rooms.front().capacity;
+    for (const Room& room : rooms) {
+        smallest = std::min(smallest, room.capacity);
+    }
+    return smallest;
+}
+
+uint64_t RoomInventory::seatsOn(int weekday) const {
+    uint64_t seats = 0;
+    for (const Room& room : rooms) {
+        if ((room.weekdays >> weekday) & 1) {
+            seats += room.capacity;
+        }
+    }
+    return seats;
+}
+
+uint64_t RoomInventory::maxSeatsPerDay() const {
+    uint64_t best = 0;
+    for (int day = 0; day < 7; day++) {
+        best = std::max(best, seatsOn(day));
+    }
+    return best;
+}
+
+const char* RoomInventory::typeName(RoomType type) {
+    switch (type) {
+        case RoomType::Lab: return "Lab";
+        case RoomType::Hall: return "Hall";
+        default: return "Classroom";
+    }
+}
+
+RoomAllocator::RoomAllocator(const RoomInventory& rooms)
+    : inventory(rooms), free(0), booked(false) {
+    const size_t count = inventory.size();
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return inventory.room(a).capacity > inventory.room(b).capacity;
+    });
+    capacity.resize(count);
+    groupStart.resize(count);
+    position.resize(count);
+    for (size_t pos = 0; pos < count; pos++) {
+        position[order[pos]] = static_cast<uint32_t>(pos);
+        capacity[pos] = inventory.room(order[pos]).capacity;
+        groupStart[pos] = pos > 0 && capacity[pos] == capacity[pos - 1] ? groupStart[pos - 1]
+                                                                         : static_cast<uint32_t>(pos);
+    }
+    nextFree.assign(count + 1, static_cast<uint32_t>(count));
+    prevFree.assign(count + 1, 0);
+}
+
+bool RoomAllocator::openDay(int32_t date) {
+    const uint32_t count = static_cast<uint32_t>(order.size());
+    free = 0;
+    booked = false;
+    for (uint32_t pos = 0; pos < count; pos++) {
+        if (inventory.isOpen(order[pos], date)) {
+            nextFree[pos] = pos;
+            prevFree[pos + 1] = pos + 1;
+            free += capacity[pos];
+        } else {
+            nextFree[pos] = pos + 1;
+            prevFree[pos + 1] = pos;
+        }
+    }
+    nextFree[count] = count;
+    prevFree[0] = 0;
+    return free > 0;
+}
+
+uint32_t RoomAllocator::firstFreeFrom(uint32_t pos) {
+    while (nextFree[pos] != pos) {
+        nextFree[pos] = nextFree[nextFree[pos]]; // Path halving
+        pos = nextFree[pos];
+    }
+    return pos;
+}
+
+uint32_t RoomAllocator::lastFreeUpTo(uint32_t pos) {
+    while (prevFree[pos] != pos) {
+        prevFree[pos] = prevFree[prevFree[pos]];
+        pos = prevFree[pos];
+    }
+    return pos;
+}
+
+void RoomAllocator::take(uint32_t pos) {
+    nextFree[pos] = pos + 1;
+    prevFree[pos + 1] = pos;
+    free -= capacity[pos];
+    booked = true;
+}
+
+bool RoomAllocator::allocate(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions) {
+    if (students > free) {
+        return false;
+    }
+    uint32_t remaining = students;
+    while (remaining > 0) {
+        uint32_t largest = firstFreeFrom(0);
+        if (capacity[largest] < remaining) {
+            take(largest);
+            sessions.emplace_back(order[largest], capacity[largest]);
+            remaining -= capacity[largest];
+            continue;
+        }
+
+        // The rest fits in one room: the smallest free room with enough seats,
+        // earliest in the inventory among rooms of that size
+        uint32_t fitting = static_cast<uint32_t>(
+            std::partition_point(capacity.begin(), capacity.end(), [remaining](uint32_t c) { return c >= remaining; }) -
+            capacity.begin());
+        uint32_t smallest = lastFreeUpTo(fitting) - 1;
+        uint32_t best = firstFreeFrom(groupStart[smallest]);
+        take(best);
+        sessions.emplace_back(order[best], remaining);
+        remaining = 0;
+    }
+    return true;
+}
+
+void RoomAllocator::takeAll(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions) {
+    while (free > 0 && students > 0) {
+        uint32_t largest = firstFreeFrom(0);
+        uint32_t seats = std::min(capacity[largest], students);
+        take(largest);
+        sessions.emplace_back(order[largest], seats);
+        students -= seats;
+    }
+}
+
+bool RoomAllocator::reserve(uint32_t index) {
+    uint32_t pos = position[index];
+    if (nextFree[pos] != pos) {
+        return false;
+    }
+    take(pos);
+    return true;
+}
+
+SharedRoomPacker::SharedRoomPacker(const RoomInventory& rooms)
+    : inventory(rooms), free(0), booked(false) {
+    order.resize(inventory.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return inventory.room(a).capacity > inventory.room(b).capacity;
+    });
+    left.assign(inventory.size(), 0);
+    used.assign(inventory.size(), 0);
+}
+
+bool SharedRoomPacker::openDay(int32_t date) {
+    free = 0;
+    booked = false;
+    usedOrder.clear();
+    pending.clear();
+    for (uint32_t r = 0; r < inventory.size(); r++) {
+        left[r] = inventory.isOpen(r, date) ? inventory.room(r).capacity : 0;
+        used[r] = 0;
+        free += left[r];
+    }
+    return free > 0;
+}
+
+void SharedRoomPacker::seat(uint32_t index, uint32_t seats) {
+    left[index] -= seats;
+    if (!used[index]) {
+        used[index] = 1;
+        usedOrder.push_back(index);
+    }
+}
+
+bool SharedRoomPacker::reserve(uint32_t index, uint32_t seats) {
+    if (index >= left.size() || left[index] < seats || seats > free) {
+        return false;
+    }
+    seat(index, seats);
+    free -= seats;
+    booked = true;
+    return true;
+}
+
+void SharedRoomPacker::takeAll(uint32_t students, std::vector<std::pair<uint32_t, uint32_t>>& sessions) {
+    for (uint32_t r : order) {
+        if (students == 0) {
+            break;
+        }
+        if (left[r] == 0) {
+            continue;
+        }
+        uint32_t seats = std::min(left[r], students);
+        seat(r, seats);
+        free -= seats;
+        booked = true;
+        sessions.emplace_back(r, seats);
+        students -= seats;
+    }
+}
+
+bool SharedRoomPacker::queue(uint32_t item, uint32_t first, uint32_t students) {
+    if (students > free) {
+        return false;
+    }
+    pending.push_back(Pending{item, first, students});
+    free -= students;
+    booked = true;
+    return true;
+}
+
+uint32_t SharedRoomPacker::fitRoom(uint32_t students) const {
+    // First fit over the rooms already in use
+    for (uint32_t r : usedOrder) {
+        if (left[r] >= students) {
+            return r;
+        }
+    }
+    // Otherwise the smallest empty room that holds them
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        if (!used[*it] && left[*it] >= students) {
+            return *it;
+        }
+    }
+    return static_cast<uint32_t>(inventory.size());
+}
+
+void SharedRoomPacker::pack(std::vector<Seating>& seatings) {
+    std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+        return a.students > b.students;
+    });
+    for (const Pending& p : pending) {
+        uint32_t rest = p.students;
+        uint32_t offset = p.first;
+        while (rest > 0) {
+            uint32_t room = fitRoom(rest);
+            uint32_t seats = rest;
+            if (room == inventory.size()) {
+                // Repair: no room holds the rest, so fill the one with most free seats
+                room = order.front();
+                for (uint32_t r : order) {
+                    if (left[r] > left[room]) {
+                        room = r;
+                    }
+                }
+                seats = left[room];
+            }
+            seat(room, seats);
+            seatings.push_back(Seating{p.item, room, offset, seats});
+            offset += seats;
+            rest -= seats;
+        }
+    }
+    pending.clear();
+}
+
+void RoomTimeline::reset(size_t roomCount) {
+    rooms.assign(roomCount, std::vector<Booking>());
+    longest.assign(roomCount, 0);
+}
+
+void RoomTimeline::book(uint32_t room, int32_t start, int32_t end, int32_t seats) {
+    std::vector<Booking>& bookings = rooms[room];
+    auto at = std::lower_bound(bookings.begin(), bookings.end(), std::make_pair(start, end),
+                               [](const Booking& booking, const std::pair<int32_t, int32_t>& key) {
+                                   return booking.start != key.first ? booking.start < key.first : booking.end < key.second;
+                               });
+    if (at != bookings.end() && at->start == start && at->end == end) {
+        at->seats += seats;
+        if (at->seats <= 0) {
+            bookings.erase(at);
+        }
+    } else if (seats > 0) {
+        bookings.insert(at, Booking{start, end, seats});
+        longest[room] = std::max(longest[room], end - start);
+    }
+}
+
+uint32_t RoomTimeline::seatsBooked(uint32_t room, int32_t start, int32_t end) const {
+    const std::vector<Booking>& bookings = rooms[room];
+    // Bookings starting at or before start - longest end by start
+    const int32_t earliest = start - longest[room];
+    auto at = std::upper_bound(bookings.begin(), bookings.end(), earliest,
+                               [](int32_t time, const Booking& booking) { return time < booking.start; });
+    uint32_t seats = 0;
+    for (; at != bookings.end() && at->start < end; ++at) {
+        if (at->end > start) {
+            seats += static_cast<uint32_t>(at->seats);
+        }
+    }
+    return seats;
+}
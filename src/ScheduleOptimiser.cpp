@@ -0,0 +1,422 @@
+#include "../include/ScheduleOptimiser.h"
+#include "../include/Parallel.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Final temperature as a share of the starting one: late in the run only
+// moves costing a small fraction of a typical uphill step get through
+constexpr double kFinalTemperature = 1e-4;
+constexpr uint64_t kCheckInterval = 256; // Moves between clock, cancel and best checks
+constexpr int kCalibrationMoves = 512;
+constexpr double kSwapShare = 0.3;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Empty-seat or overflow cost of one day holding `used` courses that book `demand` seats
+double dayCost(const OptimiserConfig& config, uint64_t capacity, uint32_t used, uint64_t demand) {
+    if (used == 0) {
+        return 0;
+    }
+    if (demand > capacity) {
+        return config.overflowWeight * static_cast<double>(demand - capacity);
+    }
+    const double cap = static_cast<double>(capacity);
+    return config.emptySeatWeight * (cap - static_cast<double>(demand)) / cap;
+}
+
+// Days of fixed course n, or none if the problem lists no fixed days
+ArrayView<int32_t> fixedDaysOf(const AnnealingProblem& problem, uint32_t n) {
+    if (problem.fixedDayOffsets.size() <= n + 1) {
+        return ArrayView<int32_t>();
+    }
+    const uint32_t begin = problem.fixedDayOffsets[n];
+    return ArrayView<int32_t>(problem.fixedDays.data() + begin, problem.fixedDayOffsets[n + 1] - begin);
+}
+
+// Students each movable course shares with fixed courses, per day: (day, weight)
+// runs sorted by day, so a move prices its fixed clashes without walking the
+// fixed courses' days again
+class FixedClashTable {
+public:
+    explicit FixedClashTable(const AnnealingProblem& problem) {
+        const ConflictGraph& graph = *problem.conflicts;
+        const size_t courses = problem.movable.size();
+        offsets.assign(courses + 1, 0);
+        std::vector<std::pair<int32_t, uint64_t>> run;
+        for (uint32_t c = 0; c < courses; c++) {
+            run.clear();
+            if (problem.movable[c]) {
+                ArrayView<uint32_t> neighbours = graph.neighbours(c);
+                ArrayView<uint32_t> weights = graph.weights(c);
+                for (size_t i = 0; i < neighbours.size(); i++) {
+                    if (problem.movable[neighbours[i]]) {
+                        continue;
+                    }
+                    for (int32_t d : fixedDaysOf(problem, neighbours[i])) {
+                        run.emplace_back(d, weights[i]);
+                    }
+                }
+                std::sort(run.begin(), run.end());
+                for (const auto& item : run) {
+                    if (days.size() > offsets[c] && days.back().first == item.first) {
+                        days.back().second += item.second;
+                    } else {
+                        days.push_back(item);
+                    }
+                }
+            }
+            offsets[c + 1] = static_cast<uint32_t>(days.size());
+        }
+    }
+
+    uint64_t at(uint32_t c, int32_t day) const {
+        auto begin = days.begin() + offsets[c];
+        auto end = days.begin() + offsets[c + 1];
+        auto found = std::lower_bound(begin, end, std::make_pair(day, uint64_t(0)));
+        return found != end && found->first == day ? found->second : 0;
+    }
+
+private:
+    std::vector<uint32_t> offsets;
+    std::vector<std::pair<int32_t, uint64_t>> days;
+};
+
+// One annealing chain: a full course -> day assignment with the per-day totals
+// needed to price a move in O(degree)
+class AnnealingChain {
+public:
+    AnnealingChain(const AnnealingProblem& problem, const OptimiserConfig& config, const FixedClashTable& fixedClashes,
+                   const std::vector<uint32_t>& movableCourses, const std::vector<int32_t>& openDays,
+                   const std::vector<int32_t>& startDays, uint64_t seed)
+        : problem(problem), config(config), graph(*problem.conflicts), fixedClashes(fixedClashes),
+          movableCourses(movableCourses),
+          openDays(openDays), day(startDays), random(seed), moves(0), accepted(0) {
+        const int days = problem.days();
+        count.assign(days + 2, 0);
+        demand.assign(days + 2, 0);
+        for (int d = 1; d <= days; d++) {
+            count[d] = problem.fixedCount[d];
+            demand[d] = problem.fixedDemand[d];
+        }
+        for (uint32_t c : movableCourses) {
+            count[day[c]]++;
+            demand[day[c]] += problem.footprint[c];
+        }
+        span = 0;
+        for (int d = days; d > 0 && span == 0; d--) {
+            span = count[d] > 0 ? d : 0;
+        }
+        energy = scoreAssignment(problem, day, config).energy;
+        bestEnergy = energy;
+        bestDay = day;
+    }
+
+    void run(Clock::time_point start, double budgetMs, const std::atomic<bool>* cancel,
+             const std::function<void(int)>* progress, std::atomic<bool>& stop) {
+        PROFILE_SCOPE("optimise.chain");
+        if (movableCourses.empty() || openDays.size() < 2 || budgetMs <= 0) {
+            return;
+        }
+        const double initialTemperature = calibrate();
+        double temperature = initialTemperature;
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        for (;;) {
+            if (moves % kCheckInterval == 0) {
+                if (energy < bestEnergy) {
+                    bestEnergy = energy;
+                    bestDay = day;
+                }
+                double share = elapsedMs(start) / budgetMs;
+                if (cancel && cancel->load(std::memory_order_relaxed)) {
+                    stop.store(true, std::memory_order_relaxed);
+                }
+                if (share >= 1.0 || stop.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                temperature = initialTemperature * std::pow(kFinalTemperature, share);
+                if (progress && *progress) {
+                    (*progress)(static_cast<int>(share * 100));
+                }
+            }
+            moves++;
+
+            const uint32_t first = pickCourse();
+            const int32_t from = day[first];
+            const int savedSpan = span;
+            const double savedEnergy = energy;
+            double delta;
+            uint32_t second = kInvalidId;
+            if (movableCourses.size() > 1 && unit(random) < kSwapShare) {
+                // Swap the days of two courses, priced as two single moves
+                second = pickCourse();
+                if (day[second] == from) {
+                    continue;
+                }
+                const int32_t to = day[second];
+                delta = moveDelta(first, to);
+                commit(first, to, delta);
+                double secondDelta = moveDelta(second, from);
+                commit(second, from, secondDelta);
+                delta += secondDelta;
+            } else {
+                const int32_t to = pickDay(from);
+                delta = moveDelta(first, to);
+                commit(first, to, delta);
+            }
+
+            if (delta <= 0 || unit(random) < std::exp(-delta / temperature)) {
+                accepted++;
+                continue;
+            }
+            // Rejected: put the courses back in reverse order
+            if (second != kInvalidId) {
+                place(second, day[first]);
+            }
+            place(first, from);
+            span = savedSpan;
+            energy = savedEnergy;
+        }
+        if (energy < bestEnergy) {
+            bestEnergy = energy;
+            bestDay = day;
+        }
+    }
+
+    const std::vector<int32_t>& best() const { return bestDay; }
+    double getBestEnergy() const { return bestEnergy; }
+    uint64_t getMoves() const { return moves; }
+    uint64_t getAccepted() const { return accepted; }
+
+private:
+    uint32_t pickCourse() {
+        return movableCourses[std::uniform_int_distribution<size_t>(0, movableCourses.size() - 1)(random)];
+    }
+
+    // A random open day other than `from`
+    int32_t pickDay(int32_t from) {
+        int32_t to;
+        do {
+            to = openDays[std::uniform_int_distribution<size_t>(0, openDays.size() - 1)(random)];
+        } while (to == from);
+        return to;
+    }
+
+    // Energy change of moving course c to day `to`; sets pendingSpan for commit()
+    double moveDelta(uint32_t c, int32_t to) {
+        const int32_t from = day[c];
+        int64_t clashes = static_cast<int64_t>(fixedClashes.at(c, to)) - static_cast<int64_t>(fixedClashes.at(c, from));
+        int64_t backToBack = 0;
+        ArrayView<uint32_t> neighbours = graph.neighbours(c);
+        ArrayView<uint32_t> weights = graph.weights(c);
+        for (size_t i = 0; i < neighbours.size(); i++) {
+            const uint32_t n = neighbours[i];
+            if (!problem.movable[n]) {
+                continue;
+            }
+            const int32_t d = day[n];
+            const int64_t w = weights[i];
+            clashes += (d == to ? w : 0) - (d == from ? w : 0);
+            backToBack += (d - to == 1 || to - d == 1 ? w : 0) - (d - from == 1 || from - d == 1 ? w : 0);
+        }
+
+        const uint64_t fp = problem.footprint[c];
+        double days = -dayCost(config, problem.dayCapacity[from], count[from], demand[from])
+                      - dayCost(config, problem.dayCapacity[to], count[to], demand[to])
+                      + dayCost(config, problem.dayCapacity[from], count[from] - 1, demand[from] - fp)
+                      + dayCost(config, problem.dayCapacity[to], count[to] + 1, demand[to] + fp);
+
+        pendingSpan = std::max(span, static_cast<int>(to));
+        if (from == span && to < from && count[from] == 1) {
+            int last = from - 1;
+            while (last > 0 && count[last] == 0) {
+                last--;
+            }
+            pendingSpan = std::max(last, static_cast<int>(to));
+        }
+
+        return config.clashWeight * static_cast<double>(clashes) +
+               config.backToBackWeight * static_cast<double>(backToBack) + days +
+               config.examDayWeight * (pendingSpan - span);
+    }
+
+    void commit(uint32_t c, int32_t to, double delta) {
+        place(c, to);
+        span = pendingSpan;
+        energy += delta;
+    }
+
+    void place(uint32_t c, int32_t to) {
+        const int32_t from = day[c];
+        count[from]--;
+        demand[from] -= problem.footprint[c];
+        count[to]++;
+        demand[to] += problem.footprint[c];
+        day[c] = to;
+    }
+
+    // Starting temperature: the mean cost of an uphill move from the start state
+    double calibrate() {
+        double uphill = 0;
+        int samples = 0;
+        for (int i = 0; i < kCalibrationMoves; i++) {
+            const uint32_t c = pickCourse();
+            double delta = moveDelta(c, pickDay(day[c]));
+            if (delta > 0) {
+                uphill += delta;
+                samples++;
+            }
+        }
+        return samples > 0 ? uphill / samples : 1.0;
+    }
+
+    const AnnealingProblem& problem;
+    const OptimiserConfig& config;
+    const ConflictGraph& graph;
+    const FixedClashTable& fixedClashes;
+    const std::vector<uint32_t>& movableCourses;
+    const std::vector<int32_t>& openDays;
+
+    std::vector<int32_t> day;
+    std::vector<uint32_t> count;    // Courses per day, fixed ones included
+    std::vector<uint64_t> demand;   // Booked seats per day
+    int span;
+    int pendingSpan = 0;
+    double energy;
+
+    std::vector<int32_t> bestDay;
+    double bestEnergy;
+    std::mt19937_64 random;
+    uint64_t moves;
+    uint64_t accepted;
+};
+
+} // namespace
+
+ScheduleScore scoreAssignment(const AnnealingProblem& problem, const std::vector<int32_t>& courseDay,
+                              const OptimiserConfig& config) {
+    ScheduleScore score;
+    const int days = problem.days();
+    std::vector<uint32_t> count(problem.fixedCount.begin(), problem.fixedCount.end());
+    std::vector<uint64_t> demand(problem.fixedDemand.begin(), problem.fixedDemand.end());
+    const ConflictGraph& graph = *problem.conflicts;
+
+    for (uint32_t c = 0; c < courseDay.size(); c++) {
+        if (!problem.movable[c]) {
+            continue;
+        }
+        count[courseDay[c]]++;
+        demand[courseDay[c]] += problem.footprint[c];
+
+        // Each edge once, from its lower end
+        ArrayView<uint32_t> neighbours = graph.neighbours(c);
+        ArrayView<uint32_t> weights = graph.weights(c);
+        for (size_t i = 0; i < neighbours.size(); i++) {
+            const uint32_t n = neighbours[i];
+            if (!problem.movable[n]) {
+                // Students of the course who sit a fixed course's exam that day
+                ArrayView<int32_t> fixed = fixedDaysOf(problem, n);
+                if (std::binary_search(fixed.begin(), fixed.end(), courseDay[c])) {
+                    score.clashes += weights[i];
+                }
+                continue;
+            }
+            if (n < c) {
+                continue;
+            }
+            const int32_t gap = courseDay[n] - courseDay[c];
+            if (gap == 0) {
+                score.clashes += weights[i];
+            } else if (gap == 1 || gap == -1) {
+                score.backToBack += weights[i];
+            }
+        }
+    }
+
+    double dayCosts = 0;
+    for (int d = 1; d <= days; d++) {
+        if (count[d] > 0) {
+            score.examDays = d;
+        }
+        dayCosts += dayCost(config, problem.dayCapacity[d], count[d], demand[d]);
+        if (count[d] > 0 && demand[d] > problem.dayCapacity[d]) {
+            score.overflowSeats += demand[d] - problem.dayCapacity[d];
+        } else if (count[d] > 0) {
+            const double cap = static_cast<double>(problem.dayCapacity[d]);
+            score.emptySeats += (cap - static_cast<double>(demand[d])) / cap;
+        }
+    }
+
+    score.energy = config.examDayWeight * score.examDays + config.clashWeight * static_cast<double>(score.clashes) +
+                   config.backToBackWeight * static_cast<double>(score.backToBack) + dayCosts;
+    return score;
+}
+
+AnnealingResult annealSchedule(const AnnealingProblem& problem, const OptimiserConfig& config,
+                               const std::atomic<bool>* cancel, const std::function<void(int)>& progress) {
+    const Clock::time_point start = Clock::now();
+    const int days = problem.days();
+
+    std::vector<int32_t> openDays;
+    for (int d = 1; d <= days; d++) {
+        if (problem.dayCapacity[d] > 0) {
+            openDays.push_back(d);
+        }
+    }
+
+    // Courses outside the allowed period start on its last open day
+    std::vector<uint32_t> movableCourses;
+    std::vector<int32_t> startDays(problem.courseDay);
+    for (uint32_t c = 0; c < startDays.size(); c++) {
+        if (!problem.movable[c]) {
+            continue;
+        }
+        movableCourses.push_back(c);
+        if (startDays[c] < 1 || startDays[c] > days || problem.dayCapacity[startDays[c]] == 0) {
+            startDays[c] = openDays.empty() ? 1 : openDays.back();
+        }
+    }
+
+    AnnealingResult result;
+    result.report.initial = scoreAssignment(problem, startDays, config);
+    result.courseDay = startDays;
+    result.report.chains = openDays.empty() ? 0 : resolveThreadCount(config.threads);
+
+    const FixedClashTable fixedClashes(problem);
+    std::vector<std::unique_ptr<AnnealingChain>> chains(result.report.chains);
+    std::atomic<bool> stop(false);
+    const double budgetMs = std::max(config.seconds, 0.0) * 1000.0;
+    parallelFor(chains.size(), static_cast<unsigned>(chains.size()), [&](size_t first, size_t last, unsigned) {
+        for (size_t i = first; i < last; i++) {
+            // Distinct, well-spread seeds so the chains explore independently
+            uint64_t seed = config.seed + 0x9E3779B97F4A7C15ull * (i + 1);
+            chains[i] = std::make_unique<AnnealingChain>(problem, config, fixedClashes, movableCourses, openDays,
+                                                         startDays, seed);
+            chains[i]->run(start, budgetMs, cancel, i == 0 ? &progress : nullptr, stop);
+        }
+    });
+
+    double bestEnergy = result.report.initial.energy;
+    for (const auto& chain : chains) {
+        result.report.moves += chain->getMoves();
+        result.report.accepted += chain->getAccepted();
+        if (chain->getBestEnergy() < bestEnergy) {
+            bestEnergy = chain->getBestEnergy();
+            result.courseDay = chain->best();
+        }
+    }
+    result.report.best = scoreAssignment(problem, result.courseDay, config);
+    result.report.cancelled = stop.load(std::memory_order_relaxed);
+    result.report.ms = elapsedMs(start);
+    return result;
+}
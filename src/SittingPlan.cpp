@@ -0,0 +1,141 @@
+#include "../include/SittingPlan.h"
+#include "../include/CivilDate.h"
+#include "../include/CsvReader.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Name of an unnamed sitting, from its start time
+const char* sittingName(int32_t start) {
+    return start < 12 * 60 ? "Morning" : start < 17 * 60 ? "Afternoon" : "Evening";
+}
+
+} // namespace
+
+SittingPlan SittingPlan::singleAfternoon() {
+    return standardDay(1);
+}
+
+SittingPlan SittingPlan::standardDay(int count) {
+    SittingPlan plan;
+    if (count >= 2) {
+        plan.addSitting(Sitting{"Morning", 9 * 60, 180});
+    }
+    plan.addSitting(Sitting{"Afternoon", 14 * 60, 180});
+    if (count >= 3) {
+        plan.addSitting(Sitting{"Evening", 18 * 60, 180});
+    }
+    return plan;
+}
+
+bool SittingPlan::addSitting(const Sitting& sitting) {
+    if (sitting.start < 0 || sitting.length <= 0 || sitting.length > kMaxMinutes || sitting.start + sitting.length > 1440) {
+        return false;
+    }
+    auto next = std::lower_bound(sittings.begin(), sittings.end(), sitting.start,
+                                 [](const Sitting& s, int32_t start) { return s.start < start; });
+    if ((next != sittings.end() && sitting.start + sitting.length > next->start) ||
+        (next != sittings.begin() && (next - 1)->start + (next - 1)->length > sitting.start)) {
+        return false;
+    }
+    sittings.insert(next, sitting);
+    return true;
+}
+
+bool SittingPlan::parse(std::string_view text) {
+    SittingPlan parsed;
+    text = trim(text);
+    while (!text.empty()) {
+        const size_t end = text.find(',');
+        std::string_view token = trim(text.substr(0, end));
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+        Sitting sitting;
+        const size_t equals = token.find('=');
+        if (equals != std::string_view::npos) {
+            sitting.name = std::string(trim(token.substr(0, equals)));
+            token = trim(token.substr(equals + 1));
+        }
+        const size_t dash = token.find('-');
+        int32_t finish = 0;
+        if (dash == std::string_view::npos || !parseTime(token.substr(0, dash), sitting.start) ||
+            !parseTime(token.substr(dash + 1), finish) || finish <= sitting.start) {
+            LOG(LogLevel::Error) << "Invalid sitting '" << token << "' (expected HH:MM-HH:MM)";
+            return false;
+        }
+        sitting.length = finish - sitting.start;
+        if (sitting.name.empty()) {
+            sitting.name = sittingName(sitting.start);
+        }
+        if (!parsed.addSitting(sitting)) {
+            LOG(LogLevel::Error) << "Sitting " << sitting.name << " (" << token << ") overlaps another sitting";
+            return false;
+        }
+    }
+    if (parsed.sittings.empty()) {
+        LOG(LogLevel::Error) << "No sittings given";
+        return false;
+    }
+    sittings.swap(parsed.sittings);
+    return true;
+}
+
+bool SittingPlan::loadDurations(const std::string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open durations file: " << filename;
+        return false;
+    }
+
+    CsvReader reader(file.data(), file.data() + file.size());
+    std::vector<CsvField> fields;
+    reader.nextRecord(fields); // Header
+
+    std::vector<std::pair<std::string, int32_t>> loaded;
+    std::string scratch;
+    size_t line = 1;
+    while (reader.nextRecord(fields)) {
+        line++;
+        if (fields.empty() || (fields.size() == 1 && trim(fields[0].text).empty())) {
+            continue;
+        }
+        std::string course(trim(fields[0].value(scratch)));
+        std::string minutes = fields.size() > 1 ? std::string(trim(fields[1].text)) : std::string();
+        char* end = nullptr;
+        long value = std::strtol(minutes.c_str(), &end, 10);
+        if (course.empty() || minutes.empty() || *end != '\0' || value <= 0 || value > kMaxMinutes) {
+            LOG(LogLevel::Error) << filename << ":" << line << ": expected a course and a duration of 1-" << kMaxMinutes
+                                 << " minutes";
+            return false;
+        }
+        loaded.emplace_back(std::move(course), static_cast<int32_t>(value));
+    }
+
+    for (const auto& duration : loaded) {
+        courseMinutes[duration.first] = duration.second;
+    }
+    LOG(LogLevel::Info) << "Loaded " << loaded.size() << " exam durations from " << filename;
+    return true;
+}
+
+void SittingPlan::setCourseDuration(const std::string& course, int32_t minutes) {
+    if (minutes > 0) {
+        courseMinutes[course] = std::min(minutes, kMaxMinutes);
+    } else {
+        courseMinutes.erase(course);
+    }
+}
+
+int32_t SittingPlan::courseDuration(const std::string& course) const {
+    auto found = courseMinutes.find(course);
+    return found != courseMinutes.end() ? found->second : 0;
+}
+
+std::string SittingPlan::timeRange(uint32_t index) const {
+    std::string range = formatTime(sittings[index].start);
+    range += " - ";
+    appendTime(range, sittings[index].start + sittings[index].length);
+    return range;
+}
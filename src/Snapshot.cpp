@@ -0,0 +1,337 @@
+#include "../include/Snapshot.h"
+#include "../include/TimetableGenerator.h"
+#include "../include/Logger.h"
+#include "../include/Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'T', 'S', 'N', 'A', 'P', '\r', '\n'};
+constexpr uint32_t kByteOrder = 0x01020304u;
+
+static_assert(std::is_trivially_copyable<ScheduleEntry>::value && sizeof(ScheduleEntry) == 28,
+              "ScheduleEntry is stored as-is in snapshots");
+static_assert(sizeof(SnapshotEntryV1) == 24, "entries of snapshots written before sittings");
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t alignUp(size_t value) {
+    return (value + kSnapshotAlignment - 1) / kSnapshotAlignment * kSnapshotAlignment;
+}
+
+// Section payloads collected in memory, then laid out and written in one go
+class SnapshotWriter {
+public:
+    template<typename T>
+    void addArray(SnapshotSection id, const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot records must be trivially copyable");
+        Pending& section = add(id, sizeof(T));
+        section.payload.assign(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data + count));
+    }
+
+    template<typename Column>
+    void addText(SnapshotSection id, size_t count, Column&& column) {
+        std::vector<uint64_t> offsets(count + 1, 0);
+        for (size_t i = 0; i < count; i++) {
+            offsets[i + 1] = offsets[i] + column(i).size();
+        }
+        Pending& section = add(id, 1);
+        const size_t head = sizeof(uint64_t) * (count + 2);
+        section.payload.resize(head + offsets[count]);
+        char* out = section.payload.data();
+        const uint64_t count64 = count;
+        std::memcpy(out, &count64, sizeof(count64));
+        std::memcpy(out + sizeof(uint64_t), offsets.data(), sizeof(uint64_t) * (count + 1));
+        for (size_t i = 0; i < count; i++) {
+            std::string_view text = column(i);
+            std::memcpy(out + head + offsets[i], text.data(), text.size());
+        }
+    }
+
+    bool write(const std::string& filename) const {
+        SnapshotHeader header = {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kSnapshotVersion;
+        header.byteOrder = kByteOrder;
+        header.sectionCount = static_cast<uint32_t>(pending.size());
+
+        std::vector<SnapshotSectionEntry> table(pending.size());
+        size_t offset = alignUp(sizeof(SnapshotHeader) + sizeof(SnapshotSectionEntry) * table.size());
+        for (size_t i = 0; i < pending.size(); i++) {
+            table[i].id = static_cast<uint32_t>(pending[i].id);
+            table[i].elementSize = pending[i].elementSize;
+            table[i].offset = offset;
+            table[i].bytes = pending[i].payload.size();
+            table[i].checksum = snapshotChecksum(pending[i].payload.data(), pending[i].payload.size());
+            offset = alignUp(offset + pending[i].payload.size());
+        }
+        header.fileSize = offset;
+        header.checksum = snapshotHeaderChecksum(header, table.data());
+
+        // Write next to the target and rename, so a failed save never leaves a torn snapshot
+        const std::string temporary = filename + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                LOG(LogLevel::Error) << "Could not create snapshot file: " << temporary;
+                return false;
+            }
+            static const char padding[kSnapshotAlignment] = {};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(table.data()), sizeof(SnapshotSectionEntry) * table.size());
+            size_t written = sizeof(header) + sizeof(SnapshotSectionEntry) * table.size();
+            for (size_t i = 0; i < pending.size(); i++) {
+                out.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+                out.write(pending[i].payload.data(), static_cast<std::streamsize>(pending[i].payload.size()));
+                written = table[i].offset + pending[i].payload.size();
+            }
+            out.write(padding, static_cast<std::streamsize>(header.fileSize - written));
+            if (!out.good()) {
+                LOG(LogLevel::Error) << "Could not write snapshot file: " << temporary;
+                out.close();
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+        std::remove(filename.c_str());
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            LOG(LogLevel::Error) << "Could not rename " << temporary << " to " << filename;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Pending {
+        SnapshotSection id;
+        uint32_t elementSize;
+        std::vector<char> payload;
+    };
+
+    Pending& add(SnapshotSection id, uint32_t elementSize) {
+        pending.push_back(Pending{id, elementSize, {}});
+        return pending.back();
+    }
+
+    std::vector<Pending> pending;
+};
+
+} // namespace
+
+uint64_t snapshotChecksum(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, size - i);
+    return mix(h ^ tail);
+}
+
+uint64_t snapshotHeaderChecksum(const SnapshotHeader& header, const SnapshotSectionEntry* table) {
+    SnapshotHeader unsummed = header;
+    unsummed.checksum = 0;
+    return mix(snapshotChecksum(&unsummed, sizeof(unsummed)) ^
+               snapshotChecksum(table, sizeof(SnapshotSectionEntry) * header.sectionCount));
+}
+
+SnapshotFile::SnapshotFile()
+    : sections(nullptr), sectionCount(0), version(0), openMs(0) {
+}
+
+bool SnapshotFile::open(const std::string& filename, bool verifyChecksums) {
+    PROFILE_SCOPE("snapshot.open");
+    auto start = std::chrono::steady_clock::now();
+    close();
+    if (!file.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open snapshot file: " << filename;
+        return false;
+    }
+
+    auto fail = [&](const char* reason) {
+        LOG(LogLevel::Error) << filename << " is not a valid snapshot: " << reason;
+        close();
+        return false;
+    };
+
+    if (file.size() < sizeof(SnapshotHeader)) {
+        return fail("file too small");
+    }
+    SnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return fail("bad magic");
+    }
+    if (header.byteOrder != kByteOrder) {
+        return fail("written on a machine with a different byte order");
+    }
+    if (header.version < kSnapshotOldestVersion || header.version > kSnapshotVersion) {
+        return fail("unsupported version");
+    }
+    if (header.fileSize != file.size() ||
+        header.sectionCount > (file.size() - sizeof(header)) / sizeof(SnapshotSectionEntry)) {
+        return fail("truncated file");
+    }
+    const SnapshotSectionEntry* table = reinterpret_cast<const SnapshotSectionEntry*>(file.data() + sizeof(header));
+    if (snapshotHeaderChecksum(header, table) != header.checksum) {
+        return fail("header checksum mismatch");
+    }
+
+    for (uint32_t i = 0; i < header.sectionCount; i++) {
+        const SnapshotSectionEntry& entry = table[i];
+        if (entry.offset % kSnapshotAlignment != 0 || entry.offset > file.size() ||
+            entry.bytes > file.size() - entry.offset || entry.elementSize == 0 ||
+            entry.bytes % entry.elementSize != 0) {
+            return fail("section outside the file");
+        }
+        if (verifyChecksums && snapshotChecksum(file.data() + entry.offset, entry.bytes) != entry.checksum) {
+            return fail("section checksum mismatch");
+        }
+        if (entry.elementSize == 1 && entry.bytes > 0) {
+            // Text column: the offsets must rise from 0 to the end of the characters,
+            // so every string TextColumn hands out lies inside the section
+            uint64_t count = 0;
+            if (entry.bytes < sizeof(count)) {
+                return fail("text column outside its section");
+            }
+            std::memcpy(&count, file.data() + entry.offset, sizeof(count));
+            const uint64_t head = (count + 2) * sizeof(uint64_t);
+            if (count > entry.bytes / sizeof(uint64_t) || head > entry.bytes) {
+                return fail("text column outside its section");
+            }
+            const uint64_t* offsets = reinterpret_cast<const uint64_t*>(file.data() + entry.offset) + 1;
+            if (offsets[0] != 0 || offsets[count] != entry.bytes - head) {
+                return fail("text column outside its section");
+            }
+            for (uint64_t k = 0; k < count; k++) {
+                if (offsets[k] > offsets[k + 1]) {
+                    return fail("text column offsets out of order");
+                }
+            }
+        }
+    }
+
+    sections = table;
+    sectionCount = header.sectionCount;
+    version = header.version;
+    openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void SnapshotFile::close() {
+    file.close();
+    sections = nullptr;
+    sectionCount = 0;
+    version = 0;
+}
+
+const SnapshotSectionEntry* SnapshotFile::find(SnapshotSection id) const {
+    for (size_t i = 0; i < sectionCount; i++) {
+        if (sections[i].id == static_cast<uint32_t>(id)) {
+            return &sections[i];
+        }
+    }
+    return nullptr;
+}
+
+TextColumn SnapshotFile::text(SnapshotSection id) const {
+    const SnapshotSectionEntry* entry = find(id);
+    if (entry == nullptr || entry->elementSize != 1 || entry->bytes == 0) {
+        return TextColumn();
+    }
+    const uint64_t* words = reinterpret_cast<const uint64_t*>(file.data() + entry->offset);
+    const size_t count = static_cast<size_t>(words[0]);
+    return TextColumn(words + 1, reinterpret_cast<const char*>(words + count + 2), count);
+}
+
+bool writeSnapshot(const std::string& filename, const EntityStore& store, const TimetableGenerator* generator) {
+    PROFILE_SCOPE("snapshot.write");
+    SnapshotWriter writer;
+    const CourseTable& courses = store.courses;
+    const StudentTable& students = store.students;
+    writer.addText(SnapshotSection::CourseIds, courses.size(), [&](size_t c) -> std::string_view {
+        return courses.id(static_cast<uint32_t>(c));
+    });
+    writer.addText(SnapshotSection::CourseNames, courses.size(), [&](size_t c) -> std::string_view {
+        return courses.name(static_cast<uint32_t>(c));
+    });
+    writer.addText(SnapshotSection::CourseDepartments, courses.size(), [&](size_t c) -> std::string_view {
+        return courses.department(static_cast<uint32_t>(c));
+    });
+    writer.addText(SnapshotSection::StudentRollNos, students.size(), [&](size_t s) -> std::string_view {
+        return students.rollNo(static_cast<uint32_t>(s));
+    });
+    writer.addText(SnapshotSection::StudentNames, students.size(), [&](size_t s) -> std::string_view {
+        return students.name(static_cast<uint32_t>(s));
+    });
+    writer.addText(SnapshotSection::StudentBatches, students.size(), [&](size_t s) -> std::string_view {
+        return students.batch(static_cast<uint32_t>(s));
+    });
+    writer.addText(SnapshotSection::StudentPrograms, students.size(), [&](size_t s) -> std::string_view {
+        return students.program(static_cast<uint32_t>(s));
+    });
+    std::vector<int32_t> semesters(students.size());
+    for (uint32_t s = 0; s < students.size(); s++) {
+        semesters[s] = students.semester(s);
+    }
+    writer.addArray(SnapshotSection::StudentSemesters, semesters.data(), semesters.size());
+    writer.addArray(SnapshotSection::EnrollmentStudents, store.enrollments.studentIds().data(), store.enrollments.size());
+    writer.addArray(SnapshotSection::EnrollmentCourses, store.enrollments.courseIds().data(), store.enrollments.size());
+
+    if (generator != nullptr && generator->isGenerated()) {
+        SnapshotScheduleInfo info = {};
+        info.startDay = generator->getStartDay();
+        info.mode = static_cast<uint32_t>(generator->getSchedulingMode());
+        info.weekend = generator->getExamCalendar().getWeekend();
+        info.flags = generator->getRoomSharing() ? kSnapshotRoomSharing : 0;
+        writer.addArray(SnapshotSection::ScheduleInfo, &info, 1);
+        writer.addArray(SnapshotSection::ScheduleEntries, generator->getEntries().data(), generator->getEntries().size());
+
+        const RoomInventory& rooms = generator->getRoomInventory();
+        writer.addText(SnapshotSection::RoomNames, rooms.size(), [&](size_t r) -> std::string_view {
+            return rooms.room(static_cast<uint32_t>(r)).name;
+        });
+        std::vector<SnapshotRoom> roomRecords(rooms.size());
+        for (uint32_t r = 0; r < rooms.size(); r++) {
+            roomRecords[r].capacity = rooms.room(r).capacity;
+            roomRecords[r].type = static_cast<uint8_t>(rooms.room(r).type);
+            roomRecords[r].weekdays = rooms.room(r).weekdays;
+        }
+        writer.addArray(SnapshotSection::Rooms, roomRecords.data(), roomRecords.size());
+        std::vector<int32_t> holidays = generator->getExamCalendar().holidayDates();
+        writer.addArray(SnapshotSection::Holidays, holidays.data(), holidays.size());
+        const SittingPlan& sittings = generator->getSittingPlan();
+        writer.addText(SnapshotSection::SittingNames, sittings.size(), [&](size_t i) -> std::string_view {
+            return sittings.sitting(static_cast<uint32_t>(i)).name;
+        });
+        std::vector<SnapshotSitting> sittingRecords(sittings.size());
+        for (uint32_t i = 0; i < sittings.size(); i++) {
+            sittingRecords[i].start = sittings.sitting(i).start;
+            sittingRecords[i].length = sittings.sitting(i).length;
+        }
+        writer.addArray(SnapshotSection::Sittings, sittingRecords.data(), sittingRecords.size());
+
+        const ConflictGraph& graph = generator->getConflictGraph();
+        std::vector<uint64_t> offsets(graph.rowOffsets().begin(), graph.rowOffsets().end());
+        writer.addArray(SnapshotSection::ConflictOffsets, offsets.data(), offsets.size());
+        writer.addArray(SnapshotSection::ConflictNeighbours, graph.adjacencyList().data(), graph.adjacencyList().size());
+        writer.addArray(SnapshotSection::ConflictWeights, graph.weightList().data(), graph.weightList().size());
+        writer.addArray(SnapshotSection::ConflictCourseSizes, graph.courseSizeList().data(),
+                        graph.courseSizeList().size());
+    }
+    return writer.write(filename);
+}
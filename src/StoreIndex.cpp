@@ -0,0 +1,74 @@
+#include "../include/StoreIndex.h"
+#include "../include/Profiler.h"
+#include <chrono>
+
+namespace {
+
+// Counting sort of `values` by `keys` into CSR form; keeps the input order within a key
+void groupBy(ArrayView<uint32_t> keys, ArrayView<uint32_t> values, size_t keyCount,
+             std::vector<uint32_t>& offsets, std::vector<uint32_t>& grouped) {
+    offsets.assign(keyCount + 1, 0);
+    for (uint32_t key : keys) {
+        offsets[key + 1]++;
+    }
+    for (size_t k = 0; k < keyCount; k++) {
+        offsets[k + 1] += offsets[k];
+    }
+    grouped.resize(values.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < keys.size(); i++) {
+        grouped[fill[keys[i]]++] = values[i];
+    }
+}
+
+} // namespace
+
+void GroupIndex::groupRows() {
+    std::vector<uint32_t> rowIds(rowGroups.size());
+    for (size_t row = 0; row < rowIds.size(); row++) {
+        rowIds[row] = static_cast<uint32_t>(row);
+    }
+    groupBy(rowGroups, rowIds, names.size(), offsets, members);
+}
+
+void GroupIndex::clear() {
+    names.clear();
+    rowGroups.clear();
+    offsets.assign(1, 0);
+    members.clear();
+}
+
+ArrayView<uint32_t> GroupIndex::rows(std::string_view name) const {
+    uint32_t group = names.find(name);
+    return group != kInvalidId ? rows(group) : ArrayView<uint32_t>();
+}
+
+void StoreIndex::build(const EntityStore& source) {
+    PROFILE_SCOPE("import.index");
+    auto start = std::chrono::steady_clock::now();
+    store = &source;
+
+    const EnrollmentTable& enrollments = source.enrollments;
+    groupBy(enrollments.studentIds(), enrollments.courseIds(), source.students.size(), studentOffsets, studentCourses);
+    groupBy(enrollments.courseIds(), enrollments.studentIds(), source.courses.size(), courseOffsets, courseStudents);
+
+    const StudentTable& students = source.students;
+    programGroups.build(students.size(), [&](uint32_t s) { return std::string_view(students.program(s)); });
+    batchGroups.build(students.size(), [&](uint32_t s) { return std::string_view(students.batch(s)); });
+    const CourseTable& courses = source.courses;
+    departmentGroups.build(courses.size(), [&](uint32_t c) { return std::string_view(courses.department(c)); });
+
+    lastBuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void StoreIndex::clear() {
+    store = nullptr;
+    studentOffsets.assign(1, 0);
+    studentCourses.clear();
+    courseOffsets.assign(1, 0);
+    courseStudents.clear();
+    programGroups.clear();
+    batchGroups.clear();
+    departmentGroups.clear();
+    lastBuildMs = 0;
+}
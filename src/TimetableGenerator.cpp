@@ -1,15 +1,76 @@
 #include "../include/TimetableGenerator.h"
-#include <iostream>
+#include "../include/GraphColouring.h"
+#include "../include/PdfWriter.h"
+#include "../include/Snapshot.h"
+#include "../include/Logger.h"
+#include "../include/Profiler.h"
+#include "../include/Parallel.h"
 #include <fstream>
 #include <sstream>
 #include <cstdio>
 #include <map>
-#include <ctime>
-#include <iomanip>
 #include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Courses without students reported by name; the rest are only counted
+const uint32_t kEmptyCoursesLogged = 20;
+
+// Shared by all generators so a version never repeats across instances
+std::atomic<uint64_t> lastScheduleVersion(0);
+
+// Hall tickets: rendered and compressed a block at a time, so a single PDF needs
+// memory for one block of pages rather than the whole run
+const size_t kTicketBlock = 2048;
+const uint32_t kFailedTicketsLogged = 20;
+
+// Hall-ticket page layout (US Letter, points)
+const int kTicketLeft = 72;
+const int kTicketRight = 540;
+const int kTicketTableTop = 600;
+const int kTicketRowHeight = 18;
+const int kTicketRowsPerPage = 24;
+const int kTicketColumns[] = {72, 112, 180, 290, 450, 540}; // Day, Date, Time, Course, Room, right edge
+
+// Roll numbers as file names: anything but letters, digits, '.', '-' and '_' becomes '_'
+std::string ticketFileName(const std::string& rollNo) {
+    std::string name = rollNo;
+    for (char& ch : name) {
+        const bool plain = (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') ||
+                           ch == '.' || ch == '-' || ch == '_';
+        if (!plain) {
+            ch = '_';
+        }
+    }
+    return (name.empty() || name[0] == '.' ? "_" + name : name) + ".pdf";
+}
+
+// "dx dy Td (text) Tj" inside a text object, text escaped
+void appendShow(std::string& page, int dx, int dy, const std::string& text) {
+    page += std::to_string(dx);
+    page += ' ';
+    page += std::to_string(dy);
+    page += " Td (";
+    page += PdfWriter::escapeText(text);
+    page += ") Tj\n";
+}
+
+// One line of text in its own text object
+void appendText(std::string& page, int size, int x, int y, const std::string& text) {
+    page += "BT /F1 ";
+    page += std::to_string(size);
+    page += " Tf\n";
+    appendShow(page, x, y, text);
+    page += "ET\n";
+}
+
+} // namespace
 
 TimetableGenerator::TimetableGenerator(DatabaseManager& db)
-    : database(db), generated(false) {
+    : database(db), generated(false), scheduleVersion(0), startDay(0), threadCount(0), mode(SchedulingMode::Sequential),
+      roomSharing(false), roomInventory(RoomInventory::standardCampus()), sittings(SittingPlan::singleAfternoon()),
+      phase(GenerationPhase::Idle), progressPercent(0), cancelRequested(false) {
 }
 
 TimetableGenerator::~TimetableGenerator() {
@@ -20,583 +81,1370 @@ void TimetableGenerator::setStartDate(const std::string& date) {
     startDate = date;
 }
 
+void TimetableGenerator::setThreadCount(unsigned threads) {
+    threadCount = threads;
+}
+
+void TimetableGenerator::setSchedulingMode(SchedulingMode newMode) {
+    mode = newMode;
+}
+
+void TimetableGenerator::setRoomSharing(bool share) {
+    roomSharing = share;
+}
+
+void TimetableGenerator::setRoomInventory(const RoomInventory& rooms) {
+    roomInventory = rooms;
+}
+
+void TimetableGenerator::setExamCalendar(const ExamCalendar& examCalendar) {
+    calendar = examCalendar;
+}
+
+void TimetableGenerator::setSittingPlan(const SittingPlan& plan) {
+    sittings = plan;
+}
+
+void TimetableGenerator::bumpScheduleVersion() {
+    scheduleVersion = lastScheduleVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void TimetableGenerator::setProgress(GenerationPhase newPhase, size_t done, size_t total) {
+    phase.store(newPhase, std::memory_order_relaxed);
+    progressPercent.store(total ? static_cast<int>(done * 100 / total) : 0, std::memory_order_relaxed);
+}
+
 bool TimetableGenerator::generate() {
-    schedule.clear();
+    PROFILE_SCOPE("generate");
+    entries.clear();
+    roomTimeline.reset(roomInventory.size());
+    generated = false;
+    bumpScheduleVersion();
+    cancelRequested.store(false, std::memory_order_relaxed);
+    setProgress(GenerationPhase::BuildingConflicts, 0, 1);
+    
+    if (!parseDate(startDate, startDay)) {
+        LOG(LogLevel::Error) << "Invalid start date: " << startDate << " (expected DD-MM-YYYY)";
+        return failGeneration();
+    }
     
-    // Fetch data from database/CSV
-    LinkedList<Course> courses = database.fetchCourses();
-    LinkedList<Student> students = database.fetchStudents();
-    LinkedList<Enrollment> enrollments = database.fetchEnrollments();
+    if (sittings.size() == 0) {
+        LOG(LogLevel::Error) << "No exam sittings! Add at least one sitting to the day.";
+        return failGeneration();
+    }
+    
+    if (roomInventory.maxSeatsPerDay() == 0) {
+        LOG(LogLevel::Error) << "No exam rooms available! Load a room inventory with at least one open room.";
+        return failGeneration();
+    }
+    
+    if (examSlotSeats() == 0) {
+        LOG(LogLevel::Error) << "No exam days available! Every room is closed on the exam weekdays.";
+        return failGeneration();
+    }
+    
+    // Fetch read-only views of the interned data
+    const CourseTable& courses = database.fetchCourses();
+    const StudentTable& students = database.fetchStudents();
+    const EnrollmentTable& enrollments = database.fetchEnrollments();
+    
+    LOG(LogLevel::Info) << "Generating timetable with " << courses.size() << " courses, " 
+                        << students.size() << " students, and " << enrollments.size() 
+                        << " enrollments.";
     
-    std::cout << "Generating timetable with " << courses.getSize() << " courses, " 
-              << students.getSize() << " students, and " << enrollments.getSize() 
-              << " enrollments." << std::endl;
+    if (courses.size() == 0) {
+        LOG(LogLevel::Error) << "No courses found! Please import data first.";
+        return failGeneration();
+    }
+    
+    // Courses sharing students must not be examined on the same day
+    conflicts.build(enrollments, students.size(), courses.size(), threadCount);
+    LOG(LogLevel::Info) << "Conflict graph: " << conflicts.edgeCount() << " conflicting course pairs ("
+                        << conflicts.getBuildMs() << " ms)";
+    if (isCancelRequested()) {
+        return cancelGeneration();
+    }
     
-    if (courses.getSize() == 0) {
-        std::cerr << "No courses found! Please import data first." << std::endl;
+    buildIndexes(courses.size(), enrollments.size());
+    if (sittings.durationCount() > 0) {
+        for (uint32_t c = 0; c < courses.size(); c++) {
+            courseMinutes[c] = sittings.courseDuration(courses.id(c));
+        }
+    }
+    LogLimiter emptyCourses(kEmptyCoursesLogged);
+    for (uint32_t c = 0; c < courses.size(); c++) {
+        if (courseOffsets[c + 1] == courseOffsets[c]) {
+            LOG_LIMITED(emptyCourses, LogLevel::Warning) << "No students enrolled in course " << courses.id(c);
+        }
+    }
+    if (emptyCourses.suppressed() > 0) {
+        LOG(LogLevel::Warning) << "No students enrolled in " << emptyCourses.suppressed() << " more courses";
+    }
+    
+    setProgress(GenerationPhase::Scheduling, 0, courses.size());
+    bool completed = mode == SchedulingMode::DSatur ? scheduleDSatur() : scheduleSequential();
+    if (!completed) {
+        return cancelGeneration();
+    }
+    
+    buildStudentIndex();
+    generated = true;
+    bumpScheduleVersion();
+    setProgress(GenerationPhase::Finished, 1, 1);
+    LOG(LogLevel::Info) << "Timetable generated successfully with " << entries.size() << " exam sessions.";
+    return true;
+}
+
+void TimetableGenerator::buildIndexes(size_t courseCount, size_t enrollmentCount) {
+    PROFILE_SCOPE("generate.indexes");
+    // Enrolled student ids by course (enrollment order), already grouped at load time
+    const StoreIndex& index = database.getIndex();
+    courseOffsets = index.courseStudentOffsets();
+    courseStudents = index.courseStudentIds();
+    
+    // One exam-slot entry per enrolment of every student, so occupancy grows with
+    // the enrolment count rather than students x slots
+    studentSlotOffsets = index.studentCourseOffsets();
+    studentSlots.assign(enrollmentCount, 0);
+    
+    courseSessions.assign(courseCount, std::vector<uint32_t>());
+    courseMinutes.assign(courseCount, 0);
+    roomTimeline.reset(roomInventory.size());
+}
+
+bool TimetableGenerator::loadSchedule(const SnapshotFile& snapshot) {
+    PROFILE_SCOPE("snapshot.loadSchedule");
+    cleanup();
+    cancelRequested.store(false, std::memory_order_relaxed);
+    
+    const EntityStore& store = database.getStore();
+    ArrayView<SnapshotScheduleInfo> info = snapshot.array<SnapshotScheduleInfo>(SnapshotSection::ScheduleInfo);
+    if (info.size() != 1) {
+        LOG(LogLevel::Error) << "Snapshot has no schedule.";
+        return false;
+    }
+    if (info[0].mode > static_cast<uint32_t>(SchedulingMode::DSatur) || info[0].weekend > 0x7F ||
+        (info[0].flags & ~kSnapshotRoomSharing) != 0) {
+        LOG(LogLevel::Error) << "Snapshot schedule settings are invalid.";
         return false;
     }
     
-    // Create mapping of course to enrolled students
-    std::map<std::string, std::vector<std::string>> courseEnrollments;
+    // Rooms and calendar as they were when the schedule was saved
+    TextColumn names = snapshot.text(SnapshotSection::RoomNames);
+    ArrayView<SnapshotRoom> roomRecords = snapshot.array<SnapshotRoom>(SnapshotSection::Rooms);
+    if (names.size() != roomRecords.size()) {
+        LOG(LogLevel::Error) << "Snapshot room inventory is incomplete.";
+        return false;
+    }
+    RoomInventory rooms;
+    for (size_t r = 0; r < roomRecords.size(); r++) {
+        if (roomRecords[r].type > static_cast<uint8_t>(RoomType::Hall)) {
+            LOG(LogLevel::Error) << "Snapshot room " << names[r] << " has an unknown type.";
+            return false;
+        }
+        Room room;
+        room.name = std::string(names[r]);
+        room.capacity = roomRecords[r].capacity;
+        room.type = static_cast<RoomType>(roomRecords[r].type);
+        room.weekdays = roomRecords[r].weekdays & RoomInventory::kEveryDay;
+        rooms.addRoom(room);
+    }
+    ExamCalendar examCalendar;
+    examCalendar.setWeekend(static_cast<uint8_t>(info[0].weekend));
+    for (int32_t date : snapshot.array<int32_t>(SnapshotSection::Holidays)) {
+        examCalendar.addHoliday(date);
+    }
     
-    // Initialize enrollment map for all courses by iterating through the linked list
-    Node<Course>* courseNode = courses.getHead();
-    while (courseNode != nullptr) {
-        courseEnrollments[courseNode->data.courseId] = std::vector<std::string>();
-        courseNode = courseNode->next;
+    // Snapshots from before sittings held every exam in one afternoon sitting
+    SittingPlan plan;
+    if (snapshot.hasSection(SnapshotSection::Sittings)) {
+        TextColumn sittingNames = snapshot.text(SnapshotSection::SittingNames);
+        ArrayView<SnapshotSitting> sittingRecords = snapshot.array<SnapshotSitting>(SnapshotSection::Sittings);
+        if (sittingRecords.empty() || sittingNames.size() != sittingRecords.size()) {
+            LOG(LogLevel::Error) << "Snapshot sittings are incomplete.";
+            return false;
+        }
+        for (size_t i = 0; i < sittingRecords.size(); i++) {
+            Sitting sitting{std::string(sittingNames[i]), sittingRecords[i].start, sittingRecords[i].length};
+            if (!plan.addSitting(sitting) || plan.getSittings().back().start != sitting.start) {
+                LOG(LogLevel::Error) << "Snapshot sitting " << sitting.name << " is invalid.";
+                return false;
+            }
+        }
+    } else {
+        plan = SittingPlan::singleAfternoon();
     }
     
-    // Populate enrollment map by iterating through enrollments
-    Node<Enrollment>* enrollmentNode = enrollments.getHead();
-    while (enrollmentNode != nullptr) {
-        std::string courseId = enrollmentNode->data.courseId;
-        std::string studentId = enrollmentNode->data.rollNo;
-        
-        if (courseEnrollments.find(courseId) != courseEnrollments.end()) {
-            courseEnrollments[courseId].push_back(studentId);
+    ArrayView<ScheduleEntry> saved;
+    std::vector<ScheduleEntry> converted;
+    if (snapshot.getVersion() >= 2) {
+        saved = snapshot.array<ScheduleEntry>(SnapshotSection::ScheduleEntries);
+    } else {
+        for (const SnapshotEntryV1& old : snapshot.array<SnapshotEntryV1>(SnapshotSection::ScheduleEntries)) {
+            converted.push_back(ScheduleEntry{old.dayIndex, old.date, old.course, old.room, old.firstStudent, old.count, 0,
+                                              static_cast<uint16_t>(plan.sitting(0).length)});
         }
-        enrollmentNode = enrollmentNode->next;
+        saved = ArrayView<ScheduleEntry>(converted);
+    }
+    ConflictGraph graph;
+    if (!graph.restore(snapshot.array<uint64_t>(SnapshotSection::ConflictOffsets),
+                       snapshot.array<uint32_t>(SnapshotSection::ConflictNeighbours),
+                       snapshot.array<uint32_t>(SnapshotSection::ConflictWeights),
+                       snapshot.array<uint32_t>(SnapshotSection::ConflictCourseSizes)) ||
+        graph.courseCount() != store.courses.size()) {
+        LOG(LogLevel::Error) << "Snapshot conflict graph does not match its courses.";
+        return false;
     }
     
-    // Generate schedule for each course
-    int dayCounter = 1;
-    int roomCounter = 1;
-    const int maxRooms = 15; // Maximum rooms available
-    const int roomCapacity = 55; // Room capacity
+    startDay = info[0].startDay;
+    startDate = formatDate(startDay);
+    mode = static_cast<SchedulingMode>(info[0].mode);
+    roomSharing = (info[0].flags & kSnapshotRoomSharing) != 0;
+    roomInventory = std::move(rooms);
+    calendar = examCalendar;
+    sittings = plan;
+    conflicts = std::move(graph);
+    buildIndexes(store.courses.size(), store.enrollments.size());
     
-    // Days of the week
-    std::vector<std::string> dayNames = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
-    int currentDay = 0;
+    entries.reserve(saved.size());
+    for (const ScheduleEntry& entry : saved) {
+        const bool valid = entry.course < store.courses.size() && entry.room >= 1 && entry.room <= roomInventory.size() &&
+                           entry.dayIndex >= 1 && entry.date == startDay + entry.dayIndex - 1 &&
+                           entry.sitting < sittings.size() && entry.minutes >= 1 &&
+                           entry.minutes <= SittingPlan::kMaxMinutes &&
+                           entry.firstStudent <= courseOffsets[entry.course + 1] - courseOffsets[entry.course] &&
+                           entry.count <= courseOffsets[entry.course + 1] - courseOffsets[entry.course] - entry.firstStudent;
+        if (!valid) {
+            LOG(LogLevel::Error) << "Snapshot schedule entry " << entries.size() << " does not match the dataset.";
+            cleanup();
+            return false;
+        }
+        // Durations other than the sitting's were the course's own
+        if (entry.minutes != sittings.sitting(entry.sitting).length) {
+            courseMinutes[entry.course] = entry.minutes;
+        }
+        courseSessions[entry.course].push_back(static_cast<uint32_t>(entries.size()));
+        entries.push_back(entry);
+        bookSession(entry, +1);
+    }
+    buildStudentIndex();
     
-    // Iterate through courses
-    courseNode = courses.getHead();
-    while (courseNode != nullptr) {
-        Course course = courseNode->data;
-        std::string courseId = course.courseId;
-        
-        std::vector<std::string> enrolledStudents = courseEnrollments[courseId];
-        
-        if (enrolledStudents.empty()) {
-            std::cout << "Warning: No students enrolled in course " << courseId << std::endl;
-            courseNode = courseNode->next;
-            continue; // Skip courses with no enrollments
+    generated = true;
+    bumpScheduleVersion();
+    setProgress(GenerationPhase::Finished, 1, 1);
+    LOG(LogLevel::Info) << "Loaded timetable with " << entries.size() << " exam sessions from snapshot (start date "
+                        << startDate << ").";
+    return true;
+}
+
+bool TimetableGenerator::failGeneration() {
+    setProgress(GenerationPhase::Failed, 0, 1);
+    return false;
+}
+
+bool TimetableGenerator::cancelGeneration() {
+    cleanup();
+    setProgress(GenerationPhase::Cancelled, 0, 1);
+    LOG(LogLevel::Info) << "Timetable generation cancelled.";
+    return false;
+}
+
+bool TimetableGenerator::scheduleSequential() {
+    PROFILE_SCOPE("generate.sequential");
+    // Walk courses in list order, packing each one into the current slot's free
+    // rooms and moving to the next slot when it does not fit
+    RoomAllocator allocator(roomInventory);
+    SharedRoomPacker packer(roomInventory);
+    int slotCounter = 0;
+    if (roomSharing) {
+        openNextSlot(packer, slotCounter);
+    } else {
+        openNextSlot(allocator, slotCounter);
+    }
+    
+    const size_t courseCount = courseOffsets.size() - 1;
+    for (uint32_t c = 0; c < courseCount; c++) {
+        if (c % 256 == 0) {
+            if (isCancelRequested()) {
+                return false;
+            }
+            setProgress(GenerationPhase::Scheduling, c, courseCount);
         }
+        if (roomSharing) {
+            placeCourse(c, packer, slotCounter);
+        } else {
+            placeCourse(c, allocator, slotCounter);
+        }
+    }
+    if (roomSharing) {
+        packSharedSlot(packer, slotCounter);
+    }
+    return true;
+}
+
+bool TimetableGenerator::scheduleDSatur() {
+    PROFILE_SCOPE("generate.dsatur");
+    // Colour the conflict graph: courses with one colour share no student
+    std::vector<bool> include(courseOffsets.size() - 1);
+    for (size_t c = 0; c < include.size(); c++) {
+        include[c] = courseOffsets[c + 1] > courseOffsets[c];
+    }
+    Colouring colouring = colourDSatur(conflicts, include);
+    if (isCancelRequested()) {
+        return false;
+    }
+    
+    // Bucket courses by colour, largest first inside each colour
+    std::vector<std::vector<uint32_t>> classes(colouring.colourCount);
+    for (uint32_t c = 0; c < include.size(); c++) {
+        if (colouring.colour[c] != kInvalidId) {
+            classes[colouring.colour[c]].push_back(c);
+        }
+    }
+    
+    // Pack each colour class into the rooms of one exam slot, best-fit decreasing.
+    // All sessions of a course stay in one slot; if the class needs more rooms, it
+    // continues in the next slot, which stays clash-free because the class is an
+    // independent set.
+    RoomAllocator allocator(roomInventory);
+    SharedRoomPacker packer(roomInventory);
+    int slotCounter = 0;
+    size_t placed = 0;
+    for (auto& members : classes) {
+        if (isCancelRequested()) {
+            return false;
+        }
+        setProgress(GenerationPhase::Scheduling, placed, include.size());
+        placed += members.size();
+        std::stable_sort(members.begin(), members.end(), [this](uint32_t a, uint32_t b) {
+            return courseOffsets[a + 1] - courseOffsets[a] > courseOffsets[b + 1] - courseOffsets[b];
+        });
         
-        // Calculate how many sessions needed based on enrolled students
-        int totalStudents = enrolledStudents.size();
-        int sessionsNeeded = (totalStudents + roomCapacity - 1) / roomCapacity; // Ceiling division
-        
-        for (int session = 0; session < sessionsNeeded; session++) {
-            // Calculate date based on start date and day counter
-            std::string examDate = calculateExamDate(startDate, dayCounter);
-            std::string dayName = dayNames[currentDay];
-            
-            // Determine room (cycle through available rooms)
-            std::string room;
-            if (roomCounter <= 11) {
-                room = "Room#" + std::to_string(roomCounter);
-            } else {
-                room = "Lab" + std::to_string(roomCounter - 11);
+        if (roomSharing) {
+            openNextSlot(packer, slotCounter);
+            for (uint32_t c : members) {
+                placeCourse(c, packer, slotCounter);
             }
-            
-            // Calculate student range for this session
-            int startIdx = session * roomCapacity;
-            int endIdx = std::min(startIdx + roomCapacity - 1, (int)enrolledStudents.size() - 1);
-            int studentsInSession = endIdx - startIdx + 1;
-            
-            std::string studentRange;
-            if (studentsInSession == 1) {
-                studentRange = enrolledStudents[startIdx];
-            } else {
-                studentRange = enrolledStudents[startIdx] + " to " + enrolledStudents[endIdx];
+        } else {
+            openNextSlot(allocator, slotCounter);
+            for (uint32_t c : members) {
+                placeCourse(c, allocator, slotCounter);
             }
-            
-            // Create schedule entry
-            std::string scheduleEntry = dayName + "," + 
-                                       std::to_string(dayCounter) + "," + 
-                                       examDate + "," + 
-                                       courseId + "," + 
-                                       studentRange + "," + 
-                                       room + "," + 
-                                       std::to_string(studentsInSession) + "/" + std::to_string(roomCapacity);
-            
-            schedule.push_back(scheduleEntry);
-            
-            // Move to next room
-            roomCounter++;
-            if (roomCounter > maxRooms) {
-                roomCounter = 1;
-                dayCounter++;
-                currentDay = (currentDay + 1) % 7; // Cycle through days
+        }
+    }
+    if (roomSharing) {
+        packSharedSlot(packer, slotCounter);
+    }
+    
+    LOG(LogLevel::Info) << "DSatur used " << colouring.colourCount << " colours for " << slotCounter
+                        << " exam slots (" << (slotCounter + sittings.size() - 1) / sittings.size() << " days).";
+    return true;
+}
+
+bool TimetableGenerator::optimise(const OptimiserConfig& config, OptimiserReport* report) {
+    PROFILE_SCOPE("optimise");
+    if (!generated || entries.empty()) {
+        LOG(LogLevel::Error) << "No timetable to optimise! Please generate one first.";
+        return false;
+    }
+    // The flag is not cleared here: a Cancel that arrives between generate() and
+    // optimise() in one run must still stop the optimiser
+    setProgress(GenerationPhase::Optimising, 0, 100);
+
+    const size_t courseCount = courseSessions.size();
+    const uint64_t daySeats = examSlotSeats();
+    const int perDay = static_cast<int>(sittings.size());
+    AnnealingProblem problem;
+    problem.conflicts = &conflicts;
+    problem.courseDay.assign(courseCount, 0);
+    problem.movable.assign(courseCount, 0);
+    problem.footprint.assign(courseCount, 0);
+
+    // The optimiser's days are exam slots. Courses held in one slot move as a
+    // whole; the rest keep their sessions.
+    int lastSlot = 0;
+    int lastFixedSlot = 0;
+    for (uint32_t c = 0; c < courseCount; c++) {
+        if (courseSessions[c].empty()) {
+            continue;
+        }
+        const int32_t first = examSlot(entries[courseSessions[c].front()]);
+        bool oneSlot = true;
+        for (uint32_t idx : courseSessions[c]) {
+            oneSlot = oneSlot && examSlot(entries[idx]) == first;
+            lastSlot = std::max(lastSlot, examSlot(entries[idx]));
+        }
+        if (oneSlot && courseOffsets[c + 1] - courseOffsets[c] <= daySeats) {
+            problem.movable[c] = 1;
+            problem.courseDay[c] = first;
+        } else {
+            for (uint32_t idx : courseSessions[c]) {
+                lastFixedSlot = std::max(lastFixedSlot, examSlot(entries[idx]));
             }
         }
+    }
+
+    const int slots = std::max(config.maxDays > 0 ? config.maxDays * perDay : lastSlot, lastFixedSlot);
+    problem.dayCapacity.assign(slots + 1, 0);
+    problem.fixedDemand.assign(slots + 1, 0);
+    problem.fixedCount.assign(slots + 1, 0);
+    problem.fixedDayOffsets.assign(courseCount + 1, 0);
+    problem.fixedDays.clear();
+    int32_t widestDate = startDay;
+    for (int s = 1; s <= slots; s++) {
+        const int32_t date = slotDate(s);
+        problem.dayCapacity[s] = calendar.isExamDay(date) ? roomInventory.seatsOn(weekdayFromDays(date)) : 0;
+        if (date < startDay + 7 && problem.dayCapacity[s] > problem.dayCapacity[(widestDate - startDay) * perDay + 1]) {
+            widestDate = date;
+        }
+    }
+    for (uint32_t c = 0; c < courseCount; c++) {
+        problem.fixedDayOffsets[c] = static_cast<uint32_t>(problem.fixedDays.size());
+        if (problem.movable[c]) {
+            continue;
+        }
+        const size_t firstDay = problem.fixedDays.size();
+        for (uint32_t idx : courseSessions[c]) {
+            const ScheduleEntry& entry = entries[idx];
+            problem.fixedDemand[examSlot(entry)] += roomSharing ? entry.count : roomCapacity(entry.room);
+            problem.fixedDays.push_back(examSlot(entry));
+        }
+        auto days = problem.fixedDays.begin() + static_cast<std::ptrdiff_t>(firstDay);
+        std::sort(days, problem.fixedDays.end());
+        problem.fixedDays.erase(std::unique(days, problem.fixedDays.end()), problem.fixedDays.end());
+        for (size_t i = firstDay; i < problem.fixedDays.size(); i++) {
+            problem.fixedCount[problem.fixedDays[i]]++;
+        }
+    }
+    problem.fixedDayOffsets[courseCount] = static_cast<uint32_t>(problem.fixedDays.size());
+
+    // Seats a course books when packed on its own into the widest weekday's rooms;
+    // with room sharing only its students' seats
+    RoomAllocator allocator(roomInventory);
+    std::vector<std::pair<uint32_t, uint32_t>> sessions;
+    for (uint32_t c = 0; c < courseCount; c++) {
+        if (!problem.movable[c]) {
+            continue;
+        }
+        if (roomSharing) {
+            problem.footprint[c] = courseOffsets[c + 1] - courseOffsets[c];
+            continue;
+        }
+        allocator.openDay(widestDate);
+        sessions.clear();
+        allocator.allocate(courseOffsets[c + 1] - courseOffsets[c], sessions);
+        for (const auto& session : sessions) {
+            problem.footprint[c] += roomInventory.room(session.first).capacity;
+        }
+    }
+
+    AnnealingResult result = annealSchedule(problem, config, &cancelRequested, [this](int percent) {
+        setProgress(GenerationPhase::Optimising, static_cast<size_t>(percent), 100);
+    });
+    const OptimiserReport& outcome = result.report;
+    LOG(LogLevel::Info) << "Optimiser: " << outcome.chains << " chains, " << outcome.moves << " moves ("
+                        << outcome.accepted << " accepted) in " << outcome.ms << " ms"
+                        << (outcome.cancelled ? ", cancelled" : "")
+                        << "; energy " << outcome.initial.energy << " -> " << outcome.best.energy
+                        << ", exam slots " << outcome.initial.examDays << " -> " << outcome.best.examDays
+                        << ", same-slot clashes " << outcome.initial.clashes << " -> " << outcome.best.clashes
+                        << ", back-to-back " << outcome.initial.backToBack << " -> " << outcome.best.backToBack;
+
+    if (outcome.best.energy < outcome.initial.energy) {
+        rebuildSchedule(result.courseDay, problem.movable, slots);
+        buildStudentIndex();
+        bumpScheduleVersion();
+    }
+    if (report) {
+        *report = outcome;
+    }
+    setProgress(GenerationPhase::Finished, 1, 1);
+    return true;
+}
+
+void TimetableGenerator::rebuildSchedule(const std::vector<int32_t>& courseSlot, const std::vector<uint8_t>& movable,
+                                         int slots) {
+    // Fixed courses keep their rooms; movable ones are packed again in their new slot
+    std::vector<std::vector<ScheduleEntry>> fixedBySlot(slots + 1);
+    for (const ScheduleEntry& entry : entries) {
+        if (!movable[entry.course]) {
+            fixedBySlot[examSlot(entry)].push_back(entry);
+        }
+    }
+    std::vector<std::vector<uint32_t>> coursesBySlot(slots + 1);
+    for (uint32_t c = 0; c < courseSlot.size(); c++) {
+        if (movable[c]) {
+            coursesBySlot[courseSlot[c]].push_back(c);
+        }
+    }
+
+    entries.clear();
+    roomTimeline.reset(roomInventory.size());
+    std::fill(studentSlots.begin(), studentSlots.end(), 0);
+    for (auto& sessions : courseSessions) {
+        sessions.clear();
+    }
+
+    auto largestFirst = [this](uint32_t a, uint32_t b) {
+        return courseOffsets[a + 1] - courseOffsets[a] > courseOffsets[b + 1] - courseOffsets[b];
+    };
+    RoomAllocator allocator(roomInventory);
+    SharedRoomPacker packer(roomInventory);
+    std::vector<std::pair<uint32_t, uint32_t>> sessions;
+    std::vector<uint32_t> spilled;
+    for (int slot = 1; slot <= slots; slot++) {
+        std::stable_sort(coursesBySlot[slot].begin(), coursesBySlot[slot].end(), largestFirst);
+        // Booking the fixed sessions first makes their rooms busy for the slot
+        for (const ScheduleEntry& entry : fixedBySlot[slot]) {
+            addSession(slot, entry.course, entry.firstStudent, entry.room, entry.count, entry.minutes);
+        }
+        if (roomSharing) {
+            packer.openDay(slotDate(slot));
+            reserveBusyRooms(packer, slot);
+            for (uint32_t c : coursesBySlot[slot]) {
+                if (!packer.queue(c, 0, courseOffsets[c + 1] - courseOffsets[c])) {
+                    spilled.push_back(c);
+                }
+            }
+            packSharedSlot(packer, slot);
+            continue;
+        }
         
-        courseNode = courseNode->next;
+        allocator.openDay(slotDate(slot));
+        reserveBusyRooms(allocator, slot);
+        for (uint32_t c : coursesBySlot[slot]) {
+            sessions.clear();
+            if (!allocator.allocate(courseOffsets[c + 1] - courseOffsets[c], sessions)) {
+                spilled.push_back(c);
+                continue;
+            }
+            uint32_t seated = 0;
+            for (const auto& session : sessions) {
+                addSession(slot, c, seated, session.first + 1, session.second);
+                seated += session.second;
+            }
+        }
+    }
+
+    // Footprints are estimates, so a slot's rooms may not hold every course the
+    // optimiser put there; those go after the last slot
+    if (!spilled.empty()) {
+        LOG(LogLevel::Warning) << spilled.size() << " courses did not fit their optimised slot and were moved "
+                               << "after slot " << slots << ".";
+        std::stable_sort(spilled.begin(), spilled.end(), largestFirst);
+        int slotCounter = slots;
+        if (roomSharing) {
+            openNextSlot(packer, slotCounter);
+            for (uint32_t c : spilled) {
+                placeCourse(c, packer, slotCounter);
+            }
+            packSharedSlot(packer, slotCounter);
+        } else {
+            openNextSlot(allocator, slotCounter);
+            for (uint32_t c : spilled) {
+                placeCourse(c, allocator, slotCounter);
+            }
+        }
+    }
+}
+
+int32_t TimetableGenerator::slotStart(int slot) const {
+    return slotDate(slot) * 1440 + sittings.sitting(static_cast<uint32_t>((slot - 1) % sittings.size())).start;
+}
+
+int32_t TimetableGenerator::sessionMinutes(uint32_t course, int slot) const {
+    return courseMinutes[course] > 0 ? courseMinutes[course]
+                                     : sittings.sitting(static_cast<uint32_t>((slot - 1) % sittings.size())).length;
+}
+
+uint64_t TimetableGenerator::examSlotSeats() const {
+    uint64_t best = 0;
+    for (int weekday = 0; weekday < 7; weekday++) {
+        if (!((calendar.getWeekend() >> weekday) & 1)) {
+            best = std::max(best, roomInventory.seatsOn(weekday));
+        }
     }
+    return best;
+}
+
+void TimetableGenerator::openNextSlot(RoomAllocator& allocator, int& slotCounter) const {
+    // Weekends, holidays and days without an open room get no exams; generate()
+    // made sure some exam weekday has a room
+    do {
+        slotCounter++;
+    } while (!calendar.isExamDay(slotDate(slotCounter)) || !allocator.openDay(slotDate(slotCounter)));
+    reserveBusyRooms(allocator, slotCounter);
+}
+
+void TimetableGenerator::reserveBusyRooms(RoomAllocator& allocator, int slot) const {
+    // Rooms booked during the sitting, e.g. by a longer exam of an earlier one
+    const int32_t from = slotStart(slot);
+    const int32_t to = from + sittings.sitting(static_cast<uint32_t>((slot - 1) % sittings.size())).length;
+    for (uint32_t r = 0; r < roomInventory.size(); r++) {
+        if (roomTimeline.seatsBooked(r, from, to) > 0) {
+            allocator.reserve(r);
+        }
+    }
+}
+
+void TimetableGenerator::placeCourse(uint32_t course, RoomAllocator& allocator, int& slotCounter) {
+    PROFILE_SCOPE("generate.placeCourse");
+    uint32_t remaining = courseOffsets[course + 1] - courseOffsets[course];
+    uint32_t seated = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> sessions;
     
-    generated = true;
-    std::cout << "Timetable generated successfully with " << schedule.size() << " exam sessions." << std::endl;
-    return true;
+    // Rooms open only on weekend days never take part, so a larger course must span slots
+    const uint64_t slotSeats = examSlotSeats();
+    if (remaining > slotSeats) {
+        // Larger than every open room together: fill whole slots until the rest fits
+        LOG(LogLevel::Warning) << "Course " << database.getStore().courses.id(course) << " has " << remaining
+                               << " students, more than the " << slotSeats
+                               << " seats of one exam slot; it spans several slots.";
+        if (allocator.hasBookings()) {
+            openNextSlot(allocator, slotCounter);
+        }
+        while (remaining > allocator.freeSeats()) {
+            sessions.clear();
+            allocator.takeAll(remaining, sessions);
+            for (const auto& session : sessions) {
+                addSession(slotCounter, course, seated, session.first + 1, session.second);
+                seated += session.second;
+                remaining -= session.second;
+            }
+            openNextSlot(allocator, slotCounter);
+        }
+    }
+    
+    // Weekdays can open different rooms, so a fresh slot may still be too small
+    while (remaining > allocator.freeSeats()) {
+        openNextSlot(allocator, slotCounter);
+    }
+    sessions.clear();
+    allocator.allocate(remaining, sessions);
+    for (const auto& session : sessions) {
+        addSession(slotCounter, course, seated, session.first + 1, session.second);
+        seated += session.second;
+    }
+}
+
+void TimetableGenerator::openNextSlot(SharedRoomPacker& packer, int& slotCounter) {
+    // Seat the finished slot's queue before moving on
+    if (slotCounter > 0) {
+        packSharedSlot(packer, slotCounter);
+    }
+    do {
+        slotCounter++;
+    } while (!calendar.isExamDay(slotDate(slotCounter)) || !packer.openDay(slotDate(slotCounter)));
+    reserveBusyRooms(packer, slotCounter);
+}
+
+void TimetableGenerator::reserveBusyRooms(SharedRoomPacker& packer, int slot) const {
+    // With sharing only the booked seats are taken
+    const int32_t from = slotStart(slot);
+    const int32_t to = from + sittings.sitting(static_cast<uint32_t>((slot - 1) % sittings.size())).length;
+    for (uint32_t r = 0; r < roomInventory.size(); r++) {
+        const uint32_t busy = roomTimeline.seatsBooked(r, from, to);
+        if (busy > 0) {
+            packer.reserve(r, std::min(busy, roomInventory.room(r).capacity));
+        }
+    }
+}
+
+void TimetableGenerator::placeCourse(uint32_t course, SharedRoomPacker& packer, int& slotCounter) {
+    PROFILE_SCOPE("generate.placeCourse");
+    uint32_t remaining = courseOffsets[course + 1] - courseOffsets[course];
+    uint32_t seated = 0;
+    
+    const uint64_t slotSeats = examSlotSeats();
+    if (remaining > slotSeats) {
+        // As without sharing: whole slots of rooms until the rest fits in one
+        LOG(LogLevel::Warning) << "Course " << database.getStore().courses.id(course) << " has " << remaining
+                               << " students, more than the " << slotSeats
+                               << " seats of one exam slot; it spans several slots.";
+        if (packer.hasBookings()) {
+            openNextSlot(packer, slotCounter);
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> sessions;
+        while (remaining > packer.freeSeats()) {
+            sessions.clear();
+            packer.takeAll(remaining, sessions);
+            for (const auto& session : sessions) {
+                addSession(slotCounter, course, seated, session.first + 1, session.second);
+                seated += session.second;
+                remaining -= session.second;
+            }
+            openNextSlot(packer, slotCounter);
+        }
+    }
+    
+    // The slot is full once its seats, not its rooms, run out
+    while (remaining > packer.freeSeats()) {
+        openNextSlot(packer, slotCounter);
+    }
+    packer.queue(course, seated, remaining);
+}
+
+void TimetableGenerator::packSharedSlot(SharedRoomPacker& packer, int slotCounter) {
+    std::vector<SharedRoomPacker::Seating> seatings;
+    packer.pack(seatings);
+    for (const SharedRoomPacker::Seating& seating : seatings) {
+        addSession(slotCounter, seating.item, seating.first, seating.room + 1, seating.seats);
+    }
+}
+
+void TimetableGenerator::addSession(int slotCounter, uint32_t course, uint32_t startIdx, uint32_t roomNumber,
+                                    uint32_t seats, int32_t minutes) {
+    ScheduleEntry entry;
+    entry.dayIndex = (slotCounter - 1) / static_cast<int>(sittings.size()) + 1;
+    entry.date = slotDate(slotCounter);
+    entry.course = course;
+    entry.room = roomNumber;
+    entry.firstStudent = startIdx;
+    entry.count = seats;
+    entry.sitting = static_cast<uint16_t>((slotCounter - 1) % sittings.size());
+    entry.minutes = static_cast<uint16_t>(minutes > 0 ? minutes : sessionMinutes(course, slotCounter));
+    
+    courseSessions[course].push_back(static_cast<uint32_t>(entries.size()));
+    entries.push_back(entry);
+    bookSession(entry, +1);
+    PROFILE_COUNT("generate.sessions", 1);
+}
+
+void TimetableGenerator::bookSession(const ScheduleEntry& entry, int delta) {
+    // Booking fills a free entry of each student, unbooking frees the one holding this slot
+    const int32_t slotNumber = examSlot(entry);
+    const int32_t from = delta > 0 ? 0 : slotNumber;
+    const int32_t to = delta > 0 ? slotNumber : 0;
+    size_t scanned = 0;
+    for (uint32_t student : sessionStudents(entry)) {
+        int32_t* first = studentSlots.data() + studentSlotOffsets[student];
+        int32_t* slot = first;
+        int32_t* last = studentSlots.data() + studentSlotOffsets[student + 1];
+        while (slot != last && *slot != from) {
+            slot++;
+        }
+        scanned += static_cast<size_t>(slot - first) + 1;
+        if (slot != last) {
+            *slot = to;
+        }
+    }
+    const int32_t start = entryStart(entry);
+    roomTimeline.book(entry.room - 1, start, start + entry.minutes, delta * static_cast<int32_t>(entry.count));
+    PROFILE_COUNT("schedule.studentSlotsScanned", scanned);
+    PROFILE_COUNT("schedule.roomBookingLookups", 1);
+}
+
+bool TimetableGenerator::entryBefore(uint32_t a, uint32_t b) const {
+    const ScheduleEntry& x = entries[a];
+    const ScheduleEntry& y = entries[b];
+    if (x.date != y.date) {
+        return x.date < y.date;
+    }
+    return x.sitting != y.sitting ? x.sitting < y.sitting : x.room < y.room;
+}
+
+void TimetableGenerator::buildStudentIndex() {
+    PROFILE_SCOPE("generate.studentIndex");
+    const size_t studentCount = studentSlotOffsets.empty() ? 0 : studentSlotOffsets.size() - 1;
+    
+    // Filling in time order leaves every student's range sorted without a sort per student
+    std::vector<uint32_t> order(entries.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return entryBefore(a, b); });
+    
+    studentEntryOffsets.assign(studentCount + 1, 0);
+    for (const ScheduleEntry& entry : entries) {
+        for (uint32_t student : sessionStudents(entry)) {
+            studentEntryOffsets[student + 1]++;
+        }
+    }
+    for (size_t s = 0; s < studentCount; s++) {
+        studentEntryOffsets[s + 1] += studentEntryOffsets[s];
+    }
+    studentEntryIndex.resize(studentEntryOffsets[studentCount]);
+    std::vector<uint32_t> fillPos(studentEntryOffsets.begin(), studentEntryOffsets.end() - 1);
+    for (uint32_t idx : order) {
+        for (uint32_t student : sessionStudents(entries[idx])) {
+            studentEntryIndex[fillPos[student]++] = idx;
+        }
+    }
+}
+
+int TimetableGenerator::examsInSlot(uint32_t student, int slot) const {
+    return static_cast<int>(std::count(studentSlots.begin() + studentSlotOffsets[student],
+                                       studentSlots.begin() + studentSlotOffsets[student + 1], slot));
+}
+
+ArrayView<uint32_t> TimetableGenerator::sessionStudents(const ScheduleEntry& entry) const {
+    return ArrayView<uint32_t>(courseStudents.data() + courseOffsets[entry.course] + entry.firstStudent, entry.count);
+}
+
+ArrayView<int32_t> TimetableGenerator::studentExamSlots(uint32_t student) const {
+    if (student + 1 >= studentSlotOffsets.size()) {
+        return ArrayView<int32_t>();
+    }
+    return ArrayView<int32_t>(studentSlots.data() + studentSlotOffsets[student],
+                              studentSlotOffsets[student + 1] - studentSlotOffsets[student]);
+}
+
+ArrayView<uint32_t> TimetableGenerator::studentTimetable(uint32_t student) const {
+    if (!generated || student + 1 >= studentEntryOffsets.size()) {
+        return ArrayView<uint32_t>();
+    }
+    return ArrayView<uint32_t>(studentEntryIndex.data() + studentEntryOffsets[student],
+                               studentEntryOffsets[student + 1] - studentEntryOffsets[student]);
+}
+
+ArrayView<uint32_t> TimetableGenerator::courseEntries(uint32_t course) const {
+    if (course >= courseSessions.size()) {
+        return ArrayView<uint32_t>();
+    }
+    return ArrayView<uint32_t>(courseSessions[course]);
+}
+
+const std::string& TimetableGenerator::courseCode(const ScheduleEntry& entry) const {
+    return database.getStore().courses.id(entry.course);
+}
+
+std::string TimetableGenerator::studentRange(const ScheduleEntry& entry) const {
+    const StudentTable& students = database.getStore().students;
+    ArrayView<uint32_t> seated = sessionStudents(entry);
+    if (seated.size() == 1) {
+        return students.rollNo(seated[0]);
+    }
+    return students.rollNo(seated[0]) + " to " + students.rollNo(seated[seated.size() - 1]);
+}
+
+std::string TimetableGenerator::examTime(const ScheduleEntry& entry) const {
+    std::string time = formatTime(startMinute(entry));
+    time += " - ";
+    appendTime(time, startMinute(entry) + entry.minutes);
+    return time;
+}
+
+std::string TimetableGenerator::formatEntry(const ScheduleEntry& entry) const {
+    // day,dayNum,date,courseId,studentRange,room,students/capacity,time; the time
+    // trails so readers of the original seven fields keep working
+    std::string line = weekdayName(entry.date);
+    line += ',';
+    line += std::to_string(entry.dayIndex);
+    line += ',';
+    appendDate(line, entry.date);
+    line += ',';
+    line += courseCode(entry);
+    line += ',';
+    line += studentRange(entry);
+    line += ',';
+    line += roomName(entry.room);
+    line += ',';
+    line += std::to_string(entry.count);
+    line += '/';
+    line += std::to_string(roomCapacity(entry.room));
+    line += ',';
+    line += examTime(entry);
+    return line;
 }
 
 bool TimetableGenerator::exportToCSV(const std::string& filename) {
+    PROFILE_SCOPE("export.csv");
     if (!generated) {
-        std::cerr << "No schedule generated yet!" << std::endl;
+        LOG(LogLevel::Error) << "No schedule generated yet!";
         return false;
     }
 
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Could not open file: " << filename << std::endl;
+        LOG(LogLevel::Error) << "Could not open file: " << filename;
         return false;
     }
 
     // Write CSV header matching the Excel structure
     file << "Date,Day_Num,Room,Room_Cap,Course_ID,Section,Course_N,Students_S,Student_F,Start_Time,End_Time,Capacity,Status\n";
 
-    // Write data
-    for (const auto& entry : schedule) {
-        try {
-            std::string day, dayNum, date, courseId, rollNumbers, room, students;
-            size_t nextPos;
-            std::string str = entry;
-            
-            // Parse day
-            nextPos = str.find(","); 
-            day = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse day number
-            nextPos = str.find(","); 
-            dayNum = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse date
-            nextPos = str.find(","); 
-            date = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse courseId
-            nextPos = str.find(","); 
-            courseId = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse roll numbers
-            nextPos = str.find(","); 
-            rollNumbers = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse room
-            nextPos = str.find(","); 
-            room = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse students (remaining string)
-            students = str;
-
-            // Keep date in DD-MM-YYYY format, but ensure Excel can interpret it properly
-            // Convert DD-MM-YYYY to DD/MM/YYYY for better Excel compatibility
-            std::string formattedDate = date.substr(0, 2) + "/" + date.substr(3, 2) + "/" + date.substr(6, 4);
-
-            // Get course name and section based on course ID
-            std::string section, courseName;
-            if (courseId == "ML101") {
-                courseName = "Machine Learning";
-                section = "2-Jan";
-            } else if (courseId == "AI401") {
-                courseName = "Artificial Intelligence";
-                section = "4-Jan";
-            } else if (courseId == "CS301") {
-                courseName = "Cloud Computing";
-                section = "2-Jan";
-            } else if (courseId == "CN601") {
-                courseName = "Computer Networks";
-                section = "5-Jan";
-            } else if (courseId == "DB301") {
-                courseName = "Database Systems";
-                section = "6-Jan";
-            } else if (courseId == "OOP201") {
-                courseName = "Object Oriented Programming";
-                section = "6-Jan";
-            } else if (courseId == "SE701") {
-                courseName = "Software Engineering";
-                section = "7-Jan";
-            } else if (courseId == "WD801") {
-                courseName = "Web Development";
-                section = "7-Jan";
-            } else if (courseId == "CC901") {
-                courseName = "Cloud Computing";
-                section = "8-Jan";
-            } else if (courseId == "CY102") {
-                courseName = "Cybersecurity";
-                section = "8-Jan";
-            } else if (courseId == "DS501") {
-                courseName = "Data Structures";
-                section = "4-Jan";
-            } else {
-                courseName = "Unknown Course";
-                section = "1-Jan";
+    // Course name and section per known course ID
+    struct CourseLabel {
+        const char* courseId;
+        const char* courseName;
+        const char* section;
+    };
+    static const CourseLabel labels[] = {
+        {"ML101", "Machine Learning", "2-Jan"},
+        {"AI401", "Artificial Intelligence", "4-Jan"},
+        {"CS301", "Cloud Computing", "2-Jan"},
+        {"CN601", "Computer Networks", "5-Jan"},
+        {"DB301", "Database Systems", "6-Jan"},
+        {"OOP201", "Object Oriented Programming", "6-Jan"},
+        {"SE701", "Software Engineering", "7-Jan"},
+        {"WD801", "Web Development", "7-Jan"},
+        {"CC901", "Cloud Computing", "8-Jan"},
+        {"CY102", "Cybersecurity", "8-Jan"},
+        {"DS501", "Data Structures", "4-Jan"},
+    };
+    
+    // Resolve labels once per course instead of once per session
+    const CourseTable& courses = database.getStore().courses;
+    std::vector<const CourseLabel*> courseLabels(courses.size(), nullptr);
+    for (uint32_t c = 0; c < courses.size(); c++) {
+        for (const CourseLabel& label : labels) {
+            if (courses.id(c) == label.courseId) {
+                courseLabels[c] = &label;
+                break;
             }
+        }
+    }
 
-            // Write in the new format
-            file << formattedDate << ","              // Date
-                 << dayNum << ","                     // Day_Num
-                 << room << ","                       // Room
-                 << "55,"                            // Room_Cap
-                 << courseId << ","                   // Course_ID
-                 << section << ","                    // Section
-                 << courseName << ","                 // Course_N
-                 << students.substr(0, students.find("/")) << ","  // Students_S
-                 << rollNumbers << ","                // Student_F
-                 << "2:00 PM,"                       // Start_Time
-                 << "5:00 PM,"                       // End_Time
-                 << "55,"                            // Capacity
-                 << "OK\n";                          // Status
-        } catch (const std::exception& e) {
-            std::cerr << "Error processing entry: " << entry << "\nError: " << e.what() << std::endl;
-            continue;
+    setProgress(GenerationPhase::Exporting, 0, entries.size());
+    
+    // Write data, buffered in large blocks
+    std::string buffer;
+    buffer.reserve(1 << 16);
+    for (const ScheduleEntry& entry : entries) {
+        // Keep DD-MM-YYYY order, but use DD/MM/YYYY for better Excel compatibility
+        size_t dateStart = buffer.size();
+        appendDate(buffer, entry.date);
+        buffer[dateStart + 2] = '/';
+        buffer[dateStart + 5] = '/';
+        
+        const CourseLabel* label = courseLabels[entry.course];
+        const std::string capacity = std::to_string(roomCapacity(entry.room));
+        buffer += ',';
+        buffer += std::to_string(entry.dayIndex);                     // Day_Num
+        buffer += ',';
+        buffer += roomName(entry.room);                               // Room
+        buffer += ',';
+        buffer += capacity;                                           // Room_Cap
+        buffer += ',';
+        buffer += courseCode(entry);                                  // Course_ID
+        buffer += ',';
+        buffer += label ? label->section : "1-Jan";                   // Section
+        buffer += ',';
+        buffer += label ? label->courseName : "Unknown Course";       // Course_N
+        buffer += ',';
+        buffer += std::to_string(entry.count);                        // Students_S
+        buffer += ',';
+        buffer += studentRange(entry);                                // Student_F
+        buffer += ',';
+        appendTime(buffer, startMinute(entry));                       // Start_Time
+        buffer += ',';
+        appendTime(buffer, startMinute(entry) + entry.minutes);       // End_Time
+        buffer += ',';
+        buffer += capacity;                                           // Capacity
+        buffer += ",OK\n";                                            // Status
+        
+        if (buffer.size() > (1 << 16) - 256) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+            setProgress(GenerationPhase::Exporting, static_cast<size_t>(&entry - entries.data()), entries.size());
         }
     }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    setProgress(GenerationPhase::Finished, 1, 1);
 
+    PROFILE_COUNT("export.csv.bytes", file.tellp());
     file.close();
     return true;
 }
 
 bool TimetableGenerator::exportToText(const std::string& filename) {
+    PROFILE_SCOPE("export.txt");
     if (!generated) {
-        std::cerr << "No schedule generated yet!" << std::endl;
+        LOG(LogLevel::Error) << "No schedule generated yet!";
         return false;
     }
 
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Could not open file: " << filename << std::endl;
+        LOG(LogLevel::Error) << "Could not open file: " << filename;
         return false;
     }
 
     file << "EXAM SCHEDULE\n\n";
-    for (const auto& entry : schedule) {
-        file << entry << "\n";
+    for (const ScheduleEntry& entry : entries) {
+        file << formatEntry(entry) << "\n";
     }
 
+    PROFILE_COUNT("export.txt.bytes", file.tellp());
     file.close();
     return true;
 }
 
 bool TimetableGenerator::exportToPDF(const std::string& filename) {
+    PROFILE_SCOPE("export.pdf");
     if (!generated) {
-        std::cerr << "No schedule generated yet!" << std::endl;
+        LOG(LogLevel::Error) << "No schedule generated yet!";
         return false;
     }
 
-    std::ofstream file(filename, std::ios::binary);
-    
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+    PdfWriter pdf;
+    if (!pdf.open(filename)) {
+        LOG(LogLevel::Error) << "Could not open file " << filename << " for writing.";
         return false;
     }
     
     // We'll paginate the table so all sessions are included across pages.
     // Define page and table metrics
-    float leftMargin = 72;
-    float tableTop = 650;
-    float rowHeight = 18;
-
-    float dayX = leftMargin;
-    float dateX = leftMargin + 55;
-    float courseX = leftMargin + 140;
-    float studentsX = leftMargin + 210;
-    float roomX = leftMargin + 420;
-    float capX = leftMargin + 485;
-    float tableRightEdge = leftMargin + 530;
-    float minBottom = 150; // minimum bottom Y for table on each page
-
-    // Helper to create a new page header (returns an ostringstream with header content)
-    auto createPageHeader = [&](int pageNumber) {
+    const float leftMargin = 72;
+    const float tableTop = 650;
+    const float rowHeight = 18;
+
+    const float dayX = leftMargin;
+    const float dateX = leftMargin + 40;
+    const float timeX = leftMargin + 100;
+    const float courseX = leftMargin + 185;
+    const float studentsX = leftMargin + 250;
+    const float roomX = leftMargin + 400;
+    const float capX = leftMargin + 485;
+    const float tableRightEdge = leftMargin + 530;
+    const float minBottom = 150; // minimum bottom Y for table on each page
+    const float columns[] = {dayX, dateX, timeX, courseX, studentsX, roomX, capX, tableRightEdge};
+
+    // Vertical column lines between y and y + rowHeight
+    auto columnLines = [&](std::ostringstream& p, float y) {
+        for (float x : columns) {
+            p << x << " " << y << " m " << x << " " << (y + rowHeight) << " l S\n";
+        }
+    };
+
+    // The page header and the two row backgrounds are drawn once as Form XObjects
+    // and referenced from every page, so page streams only carry the row text.
+    {
         std::ostringstream p;
 
         // Title - centered
-        p << "BT\n";
-        p << "/F1 20 Tf\n";
-        p << "150 720 Td\n";
-        p << "(EXAMINATION TIMETABLE) Tj\n";
-        p << "ET\n";
+        p << "BT\n/F1 20 Tf\n150 720 Td\n(EXAMINATION TIMETABLE) Tj\nET\n";
 
         // Subtitle
-        p << "BT\n";
-        p << "/F1 11 Tf\n";
-        p << "72 690 Td\n";
-        p << "(Exam Duration: 2:00 PM - 5:00 PM | Room Capacity: 55 Students) Tj\n";
-        p << "ET\n";
+        std::string seats = std::to_string(roomInventory.largestCapacity());
+        if (roomInventory.smallestCapacity() != roomInventory.largestCapacity()) {
+            seats = std::to_string(roomInventory.smallestCapacity()) + "-" + seats;
+        }
+        std::string times = "Exam Time: " + sittings.timeRange(0);
+        if (sittings.size() > 1) {
+            times = "Sittings:";
+            for (uint32_t i = 0; i < sittings.size(); i++) {
+                times += (i ? ", " : " ") + sittings.sitting(i).name + " " + formatTime(sittings.sitting(i).start);
+            }
+        }
+        p << "BT\n/F1 11 Tf\n72 690 Td\n(" << PdfWriter::escapeText(times) << " | Room Capacity: " << seats
+          << " Students) Tj\nET\n";
 
         // Table header background and borders
         p << "0.9 g\n";
         p << leftMargin << " " << (tableTop - 2) << " " << (tableRightEdge - leftMargin) << " " << rowHeight << " re f\n";
         p << "0 g\n";
         p << "0.5 w\n";
-
-        // Note: Vertical lines will be drawn dynamically as content is added
-        // We'll draw them only to the actual table bottom, not to minBottom
-
-        // Horizontal lines - top and header separator
         p << leftMargin << " " << tableTop << " m " << tableRightEdge << " " << tableTop << " l S\n";
         p << leftMargin << " " << (tableTop - rowHeight) << " m " << tableRightEdge << " " << (tableTop - rowHeight) << " l S\n";
-
-        float headerY = tableTop - 14;
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (dayX + 3) << " " << headerY << " Td\n";
-        p << "(Day) Tj\n";
-        p << "ET\n";
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (dateX + 3) << " " << headerY << " Td\n";
-        p << "(Date) Tj\n";
-        p << "ET\n";
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (courseX + 3) << " " << headerY << " Td\n";
-        p << "(Course) Tj\n";
-        p << "ET\n";
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (studentsX + 3) << " " << headerY << " Td\n";
-        p << "(Students) Tj\n";
-        p << "ET\n";
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (roomX + 3) << " " << headerY << " Td\n";
-        p << "(Room) Tj\n";
-        p << "ET\n";
-
-        p << "BT\n";
-        p << "/F1 10 Tf\n";
-        p << (capX + 3) << " " << headerY << " Td\n";
-        p << "(Cap.) Tj\n";
+        columnLines(p, tableTop - rowHeight);
+
+        // Column titles
+        const char* titles[] = {"Day", "Date", "Time", "Course", "Students", "Room", "Cap."};
+        p << "BT\n/F1 10 Tf\n" << (dayX + 3) << " " << (tableTop - 14) << " Td\n";
+        for (int i = 0; i < 7; i++) {
+            if (i > 0) {
+                p << (columns[i] - columns[i - 1]) << " 0 Td\n";
+            }
+            p << "(" << titles[i] << ") Tj\n";
+        }
         p << "ET\n";
+        pdf.addForm("Hdr", p.str(), 0, 0, 612, 792);
+    }
+    for (int shaded = 0; shaded < 2; shaded++) {
+        // One table row with its top edge at y = rowHeight and the row line at y = 0
+        std::ostringstream p;
+        if (shaded) {
+            p << "0.95 g\n";
+            p << leftMargin << " -2 " << (tableRightEdge - leftMargin) << " " << rowHeight << " re f\n";
+            p << "0 g\n";
+        }
+        p << "0.5 w\n";
+        p << leftMargin << " 0 m " << tableRightEdge << " 0 l S\n";
+        columnLines(p, 0);
+        pdf.addForm(shaded ? "RowA" : "RowB", p.str(), 0, -2, 612, rowHeight);
+    }
 
-        return p;
-    };
-
-    // Build pages by streaming rows into page headers and creating new pages when needed
-    std::vector<std::string> pageContents;
-    std::ostringstream currentPage = createPageHeader(1);
+    const std::string footer = "(Generated: Nov 16 2025 | Sessions: " + std::to_string(entries.size()) + ") Tj\n";
+    std::ostringstream page;
     float currentY = tableTop - rowHeight;
     int rowNum = 0;
+    size_t rowsWritten = 0;
+    setProgress(GenerationPhase::Exporting, 0, entries.size());
 
-    for (const auto& entry : schedule) {
+    // Bottom border and footer, then the page goes straight to disk
+    auto finishPage = [&]() {
+        float finalY = currentY - rowHeight;
+        page << "1 w\n";
+        page << leftMargin << " " << finalY << " m " << tableRightEdge << " " << finalY << " l S\n";
+        page << "BT\n/F1 8 Tf\n" << leftMargin << " " << (finalY - 30) << " Td\n" << footer << "ET\n";
+        pdf.addPage(page.str());
+        page.str("");
+        setProgress(GenerationPhase::Exporting, rowsWritten, entries.size());
+    };
+
+    page << "/Hdr Do\n";
+    for (const ScheduleEntry& entry : entries) {
         // If not enough space for another row, finish current page and start a new one
         if (currentY < (minBottom + rowHeight)) {
-            // Draw vertical lines from tableTop to current table bottom
-            currentPage << "0.5 w\n";
-            float tableBottom = currentY;
-            currentPage << dayX << " " << tableTop << " m " << dayX << " " << tableBottom << " l S\n";
-            currentPage << dateX << " " << tableTop << " m " << dateX << " " << tableBottom << " l S\n";
-            currentPage << courseX << " " << tableTop << " m " << courseX << " " << tableBottom << " l S\n";
-            currentPage << studentsX << " " << tableTop << " m " << studentsX << " " << tableBottom << " l S\n";
-            currentPage << roomX << " " << tableTop << " m " << roomX << " " << tableBottom << " l S\n";
-            currentPage << capX << " " << tableTop << " m " << capX << " " << tableBottom << " l S\n";
-            currentPage << tableRightEdge << " " << tableTop << " m " << tableRightEdge << " " << tableBottom << " l S\n";
-            
-            // Draw bottom border
-            float finalY = currentY - rowHeight;
-            currentPage << "1 w\n";
-            currentPage << leftMargin << " " << finalY << " m " << tableRightEdge << " " << finalY << " l S\n";
-
-            float footerY = finalY - 30;
-            currentPage << "BT\n";
-            currentPage << "/F1 8 Tf\n";
-            currentPage << leftMargin << " " << footerY << " Td\n";
-            currentPage << "(Generated: Nov 16 2025 | Sessions: " << schedule.size() << ") Tj\n";
-            currentPage << "ET\n";
-
-            pageContents.push_back(currentPage.str());
-
-            // Start a new page
-            currentPage = createPageHeader(static_cast<int>(pageContents.size()) + 1);
+            finishPage();
+            page << "/Hdr Do\n";
             currentY = tableTop - rowHeight;
             rowNum = 0;
         }
 
-        // Add row
+        // Add row: alternate row background, then the six cells in one text object
         currentY -= rowHeight;
-
-        // Parse entry
-        std::stringstream ss(entry);
-        std::string day, dayNum, date, courseId, rollNumbers, room, students;
-
-        std::getline(ss, day, ',');
-        std::getline(ss, dayNum, ',');
-        std::getline(ss, date, ',');
-        std::getline(ss, courseId, ',');
-        std::getline(ss, rollNumbers, ',');
-        std::getline(ss, room, ',');
-        std::getline(ss, students);
-
-        // Alternate row background
-        if (rowNum % 2 == 0) {
-            currentPage << "0.95 g\n";
-            currentPage << leftMargin << " " << (currentY - 2) << " " << (tableRightEdge - leftMargin) << " " << rowHeight << " re f\n";
-            currentPage << "0 g\n";
-        }
-
-        // Draw horizontal line for this row
-        currentPage << leftMargin << " " << currentY << " m " << tableRightEdge << " " << currentY << " l S\n";
-
-        float dataY = currentY + 5;
-
-        // Day
-        currentPage << "BT\n";
-        currentPage << "/F1 9 Tf\n";
-        currentPage << (dayX + 3) << " " << dataY << " Td\n";
-        std::string shortDay = day.substr(0, 3);
-        currentPage << "(" << shortDay << ") Tj\n";
-        currentPage << "ET\n";
-
-        // Date
-        currentPage << "BT\n";
-        currentPage << "/F1 9 Tf\n";
-        currentPage << (dateX + 3) << " " << dataY << " Td\n";
-        currentPage << "(" << date << ") Tj\n";
-        currentPage << "ET\n";
-
-        // Course
-        currentPage << "BT\n";
-        currentPage << "/F1 9 Tf\n";
-        currentPage << (courseX + 3) << " " << dataY << " Td\n";
-        currentPage << "(" << courseId << ") Tj\n";
-        currentPage << "ET\n";
+        page << "q 1 0 0 1 0 " << currentY << " cm /" << (rowNum % 2 == 0 ? "RowA" : "RowB") << " Do Q\n";
 
         // Students (truncate if too long)
-        currentPage << "BT\n";
-        currentPage << "/F1 8 Tf\n";
-        currentPage << (studentsX + 3) << " " << dataY << " Td\n";
-        std::string studentRange = rollNumbers;
-        if (studentRange.length() > 32) {
-            studentRange = studentRange.substr(0, 29) + "...";
-        }
-        currentPage << "(" << studentRange << ") Tj\n";
-        currentPage << "ET\n";
-
-        // Room
-        currentPage << "BT\n";
-        currentPage << "/F1 9 Tf\n";
-        currentPage << (roomX + 3) << " " << dataY << " Td\n";
-        currentPage << "(" << room << ") Tj\n";
-        currentPage << "ET\n";
-
-        // Capacity
-        currentPage << "BT\n";
-        currentPage << "/F1 9 Tf\n";
-        currentPage << (capX + 3) << " " << dataY << " Td\n";
-        currentPage << "(" << students << ") Tj\n";
-        currentPage << "ET\n";
+        std::string students = studentRange(entry);
+        if (students.length() > 28) {
+            students = students.substr(0, 25) + "...";
+        }
+
+        page << "BT\n/F1 9 Tf\n" << (dayX + 3) << " " << (currentY + 5) << " Td\n";
+        page << "(" << std::string(weekdayName(entry.date), 3) << ") Tj\n";
+        page << "/F1 8 Tf\n" << (dateX - dayX) << " 0 Td\n(" << formatDate(entry.date) << ") Tj\n";
+        page << (timeX - dateX) << " 0 Td\n(" << examTime(entry) << ") Tj\n";
+        page << "/F1 9 Tf\n" << (courseX - timeX) << " 0 Td\n(" << PdfWriter::escapeText(courseCode(entry)) << ") Tj\n";
+        page << "/F1 8 Tf\n" << (studentsX - courseX) << " 0 Td\n(" << PdfWriter::escapeText(students) << ") Tj\n";
+        page << "/F1 9 Tf\n" << (roomX - studentsX) << " 0 Td\n(" << PdfWriter::escapeText(roomName(entry.room)) << ") Tj\n";
+        page << (capX - roomX) << " 0 Td\n(" << entry.count << "/" << roomCapacity(entry.room) << ") Tj\n";
+        page << "ET\n";
 
         rowNum++;
+        rowsWritten++;
     }
+    finishPage();
 
-    // Push last page
-    if (!currentPage.str().empty()) {
-        // Draw vertical lines from tableTop to actual table bottom
-        currentPage << "0.5 w\n";
-        float tableBottom = currentY;
-        currentPage << dayX << " " << tableTop << " m " << dayX << " " << tableBottom << " l S\n";
-        currentPage << dateX << " " << tableTop << " m " << dateX << " " << tableBottom << " l S\n";
-        currentPage << courseX << " " << tableTop << " m " << courseX << " " << tableBottom << " l S\n";
-        currentPage << studentsX << " " << tableTop << " m " << studentsX << " " << tableBottom << " l S\n";
-        currentPage << roomX << " " << tableTop << " m " << roomX << " " << tableBottom << " l S\n";
-        currentPage << capX << " " << tableTop << " m " << capX << " " << tableBottom << " l S\n";
-        currentPage << tableRightEdge << " " << tableTop << " m " << tableRightEdge << " " << tableBottom << " l S\n";
-        
-        // Draw bottom border for the last page
-        float finalY = currentY - rowHeight;
-        currentPage << "1 w\n";
-        currentPage << leftMargin << " " << finalY << " m " << tableRightEdge << " " << finalY << " l S\n";
-
-        float footerY = finalY - 30;
-        currentPage << "BT\n";
-        currentPage << "/F1 8 Tf\n";
-        currentPage << leftMargin << " " << footerY << " Td\n";
-        currentPage << "(Generated: Nov 16 2025 | Sessions: " << schedule.size() << ") Tj\n";
-        currentPage << "ET\n";
-
-        pageContents.push_back(currentPage.str());
+    bool written = pdf.close();
+    setProgress(GenerationPhase::Finished, 1, 1);
+    if (!written) {
+        return false;
     }
+    PROFILE_COUNT("export.pdf.bytes", pdf.bytesWritten());
 
-    // Build complete PDF structure with one page object per page
-    std::ostringstream pdf;
-    pdf << "%PDF-1.4\n";
-
-    int numPages = static_cast<int>(pageContents.size());
-    int totalObjects = 3 + numPages + numPages; // 1:Catalog,2:Pages, 3..(2+numPages): Page objs, resources, then numPages content objs
-    int resourcesObjNum = 3 + numPages;
-
-    std::vector<int> offsets(totalObjects + 1, 0);
-
-    // Object 1: Catalog
-    offsets[1] = static_cast<int>(pdf.tellp());
-    pdf << "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+    LOG(LogLevel::Info) << "Schedule exported to " << filename;
+    return true;
+}
 
-    // Object 2: Pages (kids list)
-    offsets[2] = static_cast<int>(pdf.tellp());
-    pdf << "2 0 obj\n<< /Type /Pages /Kids [";
-    for (int i = 0; i < numPages; ++i) {
-        int pageObjNum = 3 + i;
-        pdf << pageObjNum << " 0 R ";
+void TimetableGenerator::renderHallTicket(uint32_t student, std::vector<std::string>& pages) const {
+    const EntityStore& store = database.getStore();
+    ArrayView<uint32_t> sessions = studentTimetable(student);
+    const size_t pageCount = (sessions.size() + kTicketRowsPerPage - 1) / kTicketRowsPerPage;
+    
+    // The frame, labels and table header come from the /Ticket form; pages only
+    // carry this student's values and rows
+    for (size_t p = 0; p < pageCount; p++) {
+        std::string page;
+        page.reserve(2048);
+        page += "/Ticket Do\nBT /F1 11 Tf\n";
+        appendShow(page, 170, 680, store.students.rollNo(student));
+        appendShow(page, 0, -18, store.students.name(student));
+        appendShow(page, 0, -18, store.students.program(student));
+        appendShow(page, 230, 36, store.students.batch(student));
+        const int semester = store.students.semester(student);
+        appendShow(page, 0, -18, semester > 0 ? std::to_string(semester) : "-");
+        page += "ET\n";
+        if (pageCount > 1) {
+            appendText(page, 9, kTicketLeft, 610, "Page " + std::to_string(p + 1) + " of " + std::to_string(pageCount));
+        }
+        
+        const size_t first = p * kTicketRowsPerPage;
+        const size_t last = std::min(sessions.size(), first + kTicketRowsPerPage);
+        int y = kTicketTableTop - kTicketRowHeight;
+        for (size_t k = first; k < last; k++) {
+            const ScheduleEntry& entry = entries[sessions[k]];
+            y -= kTicketRowHeight;
+            page += "q 1 0 0 1 0 ";
+            page += std::to_string(y);
+            page += " cm /TRow Do Q\n";
+            
+            std::string course = courseCode(entry) + " " + store.courses.name(entry.course);
+            if (course.size() > 30) {
+                course = course.substr(0, 27) + "...";
+            }
+            page += "BT /F1 9 Tf\n";
+            appendShow(page, kTicketColumns[0] + 3, y + 5, std::string(weekdayName(entry.date), 3));
+            appendShow(page, kTicketColumns[1] - kTicketColumns[0], 0, formatDate(entry.date));
+            appendShow(page, kTicketColumns[2] - kTicketColumns[1], 0, examTime(entry));
+            page += "/F1 8 Tf\n";
+            appendShow(page, kTicketColumns[3] - kTicketColumns[2], 0, course);
+            page += "/F1 9 Tf\n";
+            appendShow(page, kTicketColumns[4] - kTicketColumns[3], 0, roomName(entry.room));
+            page += "ET\n";
+        }
+        pages.push_back(std::move(page));
     }
-    pdf << "] /Count " << numPages << " >>\nendobj\n";
+}
 
-    // Page objects (3 .. 2+numPages)
-    for (int i = 0; i < numPages; ++i) {
-        int pageObjNum = 3 + i;
-        offsets[pageObjNum] = static_cast<int>(pdf.tellp());
-        int contentObjNum = resourcesObjNum + 1 + i;
-        pdf << pageObjNum << " 0 obj\n<< /Type /Page /Parent 2 0 R /Resources " << resourcesObjNum << " 0 R /MediaBox [0 0 612 792] /Contents " << contentObjNum << " 0 R >>\nendobj\n";
+bool TimetableGenerator::exportHallTickets(const std::string& path, bool perStudent, HallTicketReport* report) {
+    PROFILE_SCOPE("export.hallTickets");
+    auto start = std::chrono::steady_clock::now();
+    if (!generated) {
+        LOG(LogLevel::Error) << "No schedule generated yet!";
+        return false;
     }
-
-    // Resources object
-    offsets[resourcesObjNum] = static_cast<int>(pdf.tellp());
-    pdf << resourcesObjNum << " 0 obj\n<< /Font << /F1 << /Type /Font /Subtype /Type1 /BaseFont /Helvetica >> >> >>\nendobj\n";
-
-    // Content objects (streams)
-    for (int i = 0; i < numPages; ++i) {
-        int contentObjNum = resourcesObjNum + 1 + i;
-        offsets[contentObjNum] = static_cast<int>(pdf.tellp());
-        std::string& content = pageContents[i];
-        int length = static_cast<int>(content.length());
-        pdf << contentObjNum << " 0 obj\n<< /Length " << length << " >>\nstream\n";
-        pdf << content;
-        pdf << "\nendstream\nendobj\n";
+    
+    std::vector<uint32_t> ticketed;
+    for (uint32_t s = 0; s + 1 < studentEntryOffsets.size(); s++) {
+        if (studentEntryOffsets[s + 1] > studentEntryOffsets[s]) {
+            ticketed.push_back(s);
+        }
     }
-
-    // Cross-reference table
-    int xrefOffset = static_cast<int>(pdf.tellp());
-    pdf << "xref\n0 " << (totalObjects + 1) << "\n";
-    pdf << "0000000000 65535 f \n";
-    char buffer[64];
-    for (int i = 1; i <= totalObjects; ++i) {
-        sprintf(buffer, "%010d 00000 n \n", offsets[i]);
-        pdf << buffer;
+    if (ticketed.empty()) {
+        LOG(LogLevel::Error) << "No student has a scheduled exam; no hall tickets to export.";
+        return false;
     }
-
-    // Trailer
-    pdf << "trailer\n<< /Size " << (totalObjects + 1) << " /Root 1 0 R >>\nstartxref\n" << xrefOffset << "\n%%EOF\n";
-
-    file << pdf.str();
-    file.close();
-
-    std::cout << "Schedule exported to " << filename << std::endl;
-    return true;
+    
+    // Shared by every page: title, student labels, table header and instructions
+    std::string frame;
+    appendText(frame, 18, 165, 730, "EXAMINATION ADMIT CARD");
+    appendText(frame, 10, kTicketLeft, 712, "Exam period starting " + startDate);
+    frame += "1 w\n" + std::to_string(kTicketLeft) + " 630 " + std::to_string(kTicketRight - kTicketLeft) + " 70 re S\n";
+    appendText(frame, 10, 82, 680, "Roll Number:");
+    appendText(frame, 10, 82, 662, "Name:");
+    appendText(frame, 10, 82, 644, "Program:");
+    appendText(frame, 10, 330, 680, "Batch:");
+    appendText(frame, 10, 330, 662, "Semester:");
+    const int headerY = kTicketTableTop - kTicketRowHeight;
+    frame += "0.9 g\n" + std::to_string(kTicketLeft) + " " + std::to_string(headerY) + " " +
+             std::to_string(kTicketRight - kTicketLeft) + " " + std::to_string(kTicketRowHeight) + " re f\n0 g\n";
+    frame += "0.5 w\n";
+    for (int y : {kTicketTableTop, headerY}) {
+        frame += std::to_string(kTicketLeft) + " " + std::to_string(y) + " m " + std::to_string(kTicketRight) + " " +
+                 std::to_string(y) + " l S\n";
+    }
+    for (int x : kTicketColumns) {
+        frame += std::to_string(x) + " " + std::to_string(headerY) + " m " + std::to_string(x) + " " +
+                 std::to_string(kTicketTableTop) + " l S\n";
+    }
+    const char* titles[] = {"Day", "Date", "Time", "Course", "Room"};
+    for (int i = 0; i < 5; i++) {
+        appendText(frame, 10, kTicketColumns[i] + 3, headerY + 5, titles[i]);
+    }
+    appendText(frame, 9, kTicketLeft, 120, "Bring this card and a photo ID to every exam.");
+    appendText(frame, 9, kTicketLeft, 106, "Be seated in the listed room 15 minutes before the start time.");
+    frame += "380 80 m 540 80 l S\n";
+    appendText(frame, 9, 395, 66, "Controller of Examinations");
+    
+    // One table row: row line at y = 0 and the column lines up to the row above
+    std::string row = "0.5 w\n" + std::to_string(kTicketLeft) + " 0 m " + std::to_string(kTicketRight) + " 0 l S\n";
+    for (int x : kTicketColumns) {
+        row += std::to_string(x) + " 0 m " + std::to_string(x) + " " + std::to_string(kTicketRowHeight) + " l S\n";
+    }
+    const PdfStream frameStream = PdfWriter::encodeStream(frame);
+    const PdfStream rowStream = PdfWriter::encodeStream(row);
+    auto addForms = [&](PdfWriter& pdf) {
+        pdf.addForm("Ticket", frameStream, 0, 0, 612, 792);
+        pdf.addForm("TRow", rowStream, 0, 0, 612, kTicketRowHeight);
+    };
+    
+    PdfWriter single;
+    if (!perStudent) {
+        if (!single.open(path)) {
+            LOG(LogLevel::Error) << "Could not open file " << path << " for writing.";
+            return false;
+        }
+        addForms(single);
+    }
+    
+    const unsigned threads = resolveThreadCount(threadCount);
+    std::atomic<size_t> pages(0);
+    std::atomic<size_t> failed(0);
+    std::atomic<uint64_t> bytes(0);
+    LogLimiter failures(kFailedTicketsLogged);
+    std::vector<std::vector<PdfStream>> rendered(std::min(kTicketBlock, ticketed.size()));
+    bool cancelled = false;
+    setProgress(GenerationPhase::Exporting, 0, ticketed.size());
+    
+    for (size_t begin = 0; begin < ticketed.size(); begin += kTicketBlock) {
+        if (isCancelRequested()) {
+            cancelled = true;
+            break;
+        }
+        const size_t end = std::min(ticketed.size(), begin + kTicketBlock);
+        parallelFor(end - begin, threads, [&](size_t first, size_t last, unsigned) {
+            std::vector<std::string> ticket;
+            for (size_t i = first; i < last; i++) {
+                const uint32_t student = ticketed[begin + i];
+                ticket.clear();
+                renderHallTicket(student, ticket);
+                pages.fetch_add(ticket.size(), std::memory_order_relaxed);
+                if (!perStudent) {
+                    rendered[i].clear();
+                    for (std::string& page : ticket) {
+                        rendered[i].push_back(PdfWriter::encodeStream(std::move(page)));
+                    }
+                    continue;
+                }
+                
+                const std::string fileName = path + "/" + ticketFileName(database.getStore().students.rollNo(student));
+                PdfWriter pdf;
+                if (!pdf.open(fileName)) {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                    LOG_LIMITED(failures, LogLevel::Error) << "Could not open file " << fileName << " for writing.";
+                    continue;
+                }
+                addForms(pdf);
+                for (std::string& page : ticket) {
+                    pdf.addPage(PdfWriter::encodeStream(std::move(page)));
+                }
+                if (pdf.close()) {
+                    bytes.fetch_add(pdf.bytesWritten(), std::memory_order_relaxed);
+                } else {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        
+        // Pages go into the single file in student order
+        if (!perStudent) {
+            for (size_t i = 0; i < end - begin; i++) {
+                for (const PdfStream& page : rendered[i]) {
+                    single.addPage(page);
+                }
+            }
+        }
+        setProgress(GenerationPhase::Exporting, end, ticketed.size());
+    }
+    if (failures.suppressed() > 0) {
+        LOG(LogLevel::Error) << failures.suppressed() << " more hall-ticket files could not be opened.";
+    }
+    
+    bool ok = !cancelled && failed.load() == 0;
+    if (!perStudent) {
+        ok = single.close() && ok;
+        bytes = single.bytesWritten();
+    }
+    setProgress(cancelled ? GenerationPhase::Cancelled : GenerationPhase::Finished, 1, 1);
+    PROFILE_COUNT("export.hallTickets.pages", pages.load());
+    PROFILE_COUNT("export.hallTickets.bytes", bytes.load());
+    
+    if (report) {
+        report->tickets = ticketed.size();
+        report->pages = pages.load();
+        report->files = perStudent ? ticketed.size() - failed.load() : (ok ? 1 : 0);
+        report->failedFiles = failed.load();
+        report->bytes = bytes.load();
+        report->ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (cancelled) {
+        LOG(LogLevel::Info) << "Hall-ticket export cancelled.";
+    } else if (ok) {
+        LOG(LogLevel::Info) << ticketed.size() << " hall tickets (" << pages.load() << " pages) exported to " << path;
+    }
+    return ok;
 }
 
 std::vector<std::string> TimetableGenerator::getSchedule() const {
-    return schedule;
+    std::vector<std::string> lines;
+    lines.reserve(entries.size());
+    for (const ScheduleEntry& entry : entries) {
+        lines.push_back(formatEntry(entry));
+    }
+    return lines;
 }
 
 bool TimetableGenerator::isGenerated() const {
@@ -606,208 +1454,189 @@ bool TimetableGenerator::isGenerated() const {
 std::vector<std::pair<std::string, std::string>> TimetableGenerator::getCoursesWithDates() const {
     std::vector<std::pair<std::string, std::string>> courses;
     
-    if (!generated || schedule.empty()) {
+    if (!generated || entries.empty()) {
         return courses;
     }
     
-    // Extract unique courses and their dates from the schedule
+    // Date of the first session of every scheduled course, ordered by course ID
     std::map<std::string, std::string> courseMap;
-    
-    for (const auto& entry : schedule) {
-        try {
-            std::string day, dayNum, date, courseId;
-            size_t nextPos;
-            std::string str = entry;
-            
-            // Parse day
-            nextPos = str.find(","); 
-            day = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse day number
-            nextPos = str.find(","); 
-            dayNum = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse date
-            nextPos = str.find(","); 
-            date = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse courseId
-            nextPos = str.find(","); 
-            courseId = str.substr(0, nextPos);
-            
-            // Store course and date (only store first occurrence of each course)
-            if (courseMap.find(courseId) == courseMap.end()) {
-                courseMap[courseId] = date;
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing schedule entry: " << e.what() << std::endl;
-            continue;
+    for (uint32_t c = 0; c < courseSessions.size(); c++) {
+        if (!courseSessions[c].empty()) {
+            const ScheduleEntry& first = entries[courseSessions[c].front()];
+            courseMap.emplace(courseCode(first), formatDate(first.date));
         }
     }
     
-    // Convert map to vector
-    for (const auto& pair : courseMap) {
-        courses.push_back(pair);
-    }
-    
+    courses.assign(courseMap.begin(), courseMap.end());
     return courses;
 }
 
-bool TimetableGenerator::updateCourseDate(const std::string& courseId, const std::string& newDate) {
-    if (!generated || schedule.empty()) {
-        return false;
+RescheduleReport TimetableGenerator::planCourseMove(const std::string& courseId, const std::string& newDate,
+                                                    int sitting, uint32_t& course) const {
+    RescheduleReport report;
+    course = database.getStore().courses.find(courseId);
+    if (!generated || course == kInvalidId || course >= courseSessions.size() || courseSessions[course].empty()) {
+        report.error = "Course " + courseId + " is not in the current schedule.";
+        return report;
     }
     
-    // Helper function to get day name from date (DD-MM-YYYY format)
-    auto getDayName = [](const std::string& dateStr) -> std::string {
-        try {
-            // Parse DD-MM-YYYY format
-            int day = std::stoi(dateStr.substr(0, 2));
-            int month = std::stoi(dateStr.substr(3, 2));
-            int year = std::stoi(dateStr.substr(6, 4));
-            
-            std::tm tm = {};
-            tm.tm_year = year - 1900;
-            tm.tm_mon = month - 1;
-            tm.tm_mday = day;
-            
-            std::time_t time = std::mktime(&tm);
-            std::tm* timeinfo = std::localtime(&time);
-            
-            const char* days[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
-            return std::string(days[timeinfo->tm_wday]);
-        } catch (...) {
-            return "Monday"; // Default fallback
-        }
+    int32_t targetDay = 0;
+    if (!parseDate(newDate, targetDay)) {
+        report.error = "Invalid date " + newDate + " (expected DD-MM-YYYY).";
+        return report;
+    }
+    if (targetDay < startDay) {
+        report.error = "Date " + newDate + " is before the exam period starts (" + startDate + ").";
+        return report;
+    }
+    if (!calendar.isExamDay(targetDay)) {
+        report.error = "Date " + newDate + " is a " + (calendar.isHoliday(targetDay) ? "holiday" : "weekend day") +
+                       " (" + weekdayName(targetDay) + "); no exams are held on it.";
+        return report;
+    }
+    if (sitting != kKeepSitting && (sitting < 0 || sitting >= static_cast<int>(sittings.size()))) {
+        report.error = "Sitting " + std::to_string(sitting + 1) + " does not exist; the day has " +
+                       std::to_string(sittings.size()) + ".";
+        return report;
+    }
+    report.newDayNumber = targetDay - startDay + 1;
+    
+    const EntityStore& store = database.getStore();
+    const ArrayView<uint32_t> sessions(courseSessions[course]);
+    auto moved = [&](const ScheduleEntry& entry) {
+        ScheduleEntry target = entry;
+        target.dayIndex = report.newDayNumber;
+        target.date = targetDay;
+        target.sitting = sitting == kKeepSitting ? entry.sitting : static_cast<uint16_t>(sitting);
+        return target;
     };
     
-    // Helper function to calculate day number from start date
-    auto getDayNumber = [](const std::string& dateStr, const std::string& startDate) -> std::string {
-        try {
-            // Parse both dates
-            int day1 = std::stoi(dateStr.substr(0, 2));
-            int month1 = std::stoi(dateStr.substr(3, 2));
-            int year1 = std::stoi(dateStr.substr(6, 4));
-            
-            int day2 = std::stoi(startDate.substr(0, 2));
-            int month2 = std::stoi(startDate.substr(3, 2));
-            int year2 = std::stoi(startDate.substr(6, 4));
-            
-            std::tm tm1 = {};
-            tm1.tm_year = year1 - 1900;
-            tm1.tm_mon = month1 - 1;
-            tm1.tm_mday = day1;
-            
-            std::tm tm2 = {};
-            tm2.tm_year = year2 - 1900;
-            tm2.tm_mon = month2 - 1;
-            tm2.tm_mday = day2;
-            
-            std::time_t time1 = std::mktime(&tm1);
-            std::time_t time2 = std::mktime(&tm2);
-            
-            double diff = std::difftime(time1, time2) / (24 * 60 * 60);
-            int dayNumber = static_cast<int>(diff) + 1;
-            
-            return std::to_string(dayNumber > 0 ? dayNumber : 1);
-        } catch (...) {
-            return "1"; // Default fallback
+    // The course's sessions where they are now and where they would go, sorted by
+    // room and start, so the seats it holds in a room over an interval are found by
+    // binary search instead of rescanning every session for every session
+    struct Held {
+        uint32_t room;
+        int32_t start;
+        int32_t end;
+        int32_t seats;
+        bool operator<(const Held& other) const {
+            return room != other.room ? room < other.room : start < other.start;
         }
     };
+    std::vector<Held> heldNow;
+    std::vector<Held> heldAfter;
+    heldNow.reserve(sessions.size());
+    heldAfter.reserve(sessions.size());
+    int32_t longest = 0;
+    for (uint32_t idx : sessions) {
+        const ScheduleEntry& entry = entries[idx];
+        const int32_t from = entryStart(entry);
+        const int32_t to = entryStart(moved(entry));
+        const int32_t seats = static_cast<int32_t>(entry.count);
+        heldNow.push_back(Held{entry.room, from, from + entry.minutes, seats});
+        heldAfter.push_back(Held{entry.room, to, to + entry.minutes, seats});
+        longest = std::max<int32_t>(longest, entry.minutes);
+    }
+    std::sort(heldNow.begin(), heldNow.end());
+    std::sort(heldAfter.begin(), heldAfter.end());
+    auto seatsHeld = [longest](const std::vector<Held>& held, uint32_t room, int32_t start, int32_t end) {
+        int seats = 0;
+        auto at = std::lower_bound(held.begin(), held.end(), Held{room, start - longest, 0, 0});
+        for (; at != held.end() && at->room == room && at->start < end; ++at) {
+            seats += at->end > start ? at->seats : 0;
+        }
+        return seats;
+    };
     
-    bool updated = false;
-    std::string newDayName = getDayName(newDate);
-    std::string newDayNum = getDayNumber(newDate, startDate);
-    
-    // Update all schedule entries for the specified course
-    for (auto& entry : schedule) {
-        try {
-            std::string day, dayNum, date, entryId, rollNumbers, room, students;
-            size_t nextPos;
-            std::string str = entry;
-            
-            // Parse day
-            nextPos = str.find(","); 
-            day = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse day number
-            nextPos = str.find(","); 
-            dayNum = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse date
-            nextPos = str.find(","); 
-            date = str.substr(0, nextPos); 
-            str = str.substr(nextPos + 1);
-            
-            // Parse courseId
-            nextPos = str.find(","); 
-            entryId = str.substr(0, nextPos);
-            str = str.substr(nextPos + 1);
-            
-            // If this entry matches the course we want to update
-            if (entryId == courseId) {
-                // Parse remaining fields
-                nextPos = str.find(","); 
-                rollNumbers = str.substr(0, nextPos); 
-                str = str.substr(nextPos + 1);
-                
-                nextPos = str.find(","); 
-                room = str.substr(0, nextPos); 
-                str = str.substr(nextPos + 1);
-                
-                students = str; // Remaining string
-                
-                // Rebuild the entry with new date, day name, and day number
-                entry = newDayName + "," + newDayNum + "," + newDate + "," + 
-                       courseId + "," + rollNumbers + "," + room + "," + students;
-                
-                updated = true;
+    for (uint32_t idx : sessions) {
+        const ScheduleEntry& entry = entries[idx];
+        const ScheduleEntry target = moved(entry);
+        
+        // A session already in the target slot does not clash with itself
+        const int slot = examSlot(target);
+        const int own = examSlot(entry) == slot ? 1 : 0;
+        for (uint32_t student : sessionStudents(entry)) {
+            if (examsInSlot(student, slot) > own) {
+                report.clashingStudents.push_back(store.students.rollNo(student));
             }
-        } catch (const std::exception& e) {
-            std::cerr << "Error updating schedule entry: " << e.what() << std::endl;
-            continue;
+        }
+        
+        // Seats the course's own sessions hold in the room at the target time do not
+        // count against it. With sharing every session it moves there must fit;
+        // without, the room must hold no other booking, including another of the
+        // course's own sessions landing on it (a course spread over several slots)
+        const int32_t start = entryStart(target);
+        const int ownSeats = seatsHeld(heldNow, entry.room, start, start + entry.minutes);
+        const int movingSeats = seatsHeld(heldAfter, entry.room, start, start + entry.minutes);
+        const int others = static_cast<int>(roomTimeline.seatsBooked(entry.room - 1, start, start + entry.minutes)) -
+                           ownSeats;
+        const bool full = roomSharing ? others + movingSeats > static_cast<int>(roomCapacity(entry.room))
+                                      : others > 0 || movingSeats > static_cast<int>(entry.count);
+        // A room closed on the target weekday counts as occupied
+        bool closed = !roomInventory.isOpen(entry.room - 1, targetDay);
+        if (closed || full) {
+            const std::string& room = roomName(entry.room);
+            if (std::find(report.occupiedRooms.begin(), report.occupiedRooms.end(), room) == report.occupiedRooms.end()) {
+                report.occupiedRooms.push_back(room);
+            }
+        }
+    }
+    return report;
+}
+
+RescheduleReport TimetableGenerator::checkCourseDate(const std::string& courseId, const std::string& newDate,
+                                                     int sitting) const {
+    uint32_t course = kInvalidId;
+    return planCourseMove(courseId, newDate, sitting, course);
+}
+
+RescheduleReport TimetableGenerator::moveCourseDate(const std::string& courseId, const std::string& newDate,
+                                                    bool allowClashes, int sitting) {
+    uint32_t course = kInvalidId;
+    RescheduleReport report = planCourseMove(courseId, newDate, sitting, course);
+    if (!report.error.empty() || (report.hasClashes() && !allowClashes)) {
+        return report;
+    }
+    
+    // Move every session of the course, keeping its room and duration
+    for (uint32_t idx : courseSessions[course]) {
+        ScheduleEntry& entry = entries[idx];
+        bookSession(entry, -1);
+        entry.dayIndex = report.newDayNumber;
+        entry.date = startDay + report.newDayNumber - 1;
+        if (sitting != kKeepSitting) {
+            entry.sitting = static_cast<uint16_t>(sitting);
+        }
+        bookSession(entry, +1);
+    }
+    
+    // Only this course's students have a session at a new time
+    for (uint32_t idx : courseSessions[course]) {
+        for (uint32_t student : sessionStudents(entries[idx])) {
+            uint32_t* first = studentEntryIndex.data() + studentEntryOffsets[student];
+            uint32_t* last = studentEntryIndex.data() + studentEntryOffsets[student + 1];
+            std::sort(first, last, [this](uint32_t a, uint32_t b) { return entryBefore(a, b); });
         }
     }
     
-    return updated;
+    bumpScheduleVersion();
+    report.applied = true;
+    return report;
+}
+
+bool TimetableGenerator::updateCourseDate(const std::string& courseId, const std::string& newDate) {
+    return moveCourseDate(courseId, newDate, true).applied;
 }
 
 void TimetableGenerator::cleanup() {
-    schedule.clear();
+    entries.clear();
+    courseSessions.clear();
+    studentSlotOffsets.clear();
+    studentSlots.clear();
+    courseMinutes.clear();
+    roomTimeline.reset(0);
+    studentEntryOffsets.clear();
+    studentEntryIndex.clear();
     generated = false;
+    bumpScheduleVersion();
 }
-
-std::string TimetableGenerator::calculateExamDate(const std::string& startDate, int dayOffset) {
-    try {
-        // Parse startDate in DD-MM-YYYY format
-        int day = std::stoi(startDate.substr(0, 2));
-        int month = std::stoi(startDate.substr(3, 2));
-        int year = std::stoi(startDate.substr(6, 4));
-        
-        std::tm tm = {};
-        tm.tm_year = year - 1900;
-        tm.tm_mon = month - 1;
-        tm.tm_mday = day;
-        
-        std::time_t startTime = std::mktime(&tm);
-        
-        // Add dayOffset-1 days (since day 1 should be the start date itself)
-        std::time_t examTime = startTime + ((dayOffset - 1) * 24 * 60 * 60);
-        
-        std::tm* examTm = std::localtime(&examTime);
-        
-        // Format as DD-MM-YYYY
-        char buffer[12];
-        std::strftime(buffer, sizeof(buffer), "%d-%m-%Y", examTm);
-        
-        return std::string(buffer);
-    } catch (...) {
-        // Fallback to startDate if parsing fails
-        return startDate;
-    }
-}
\ No newline at end of file
@@ -10,6 +10,8 @@ AnalyticsWindow::AnalyticsWindow(DatabaseManager* dbManager, QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::AnalyticsWindow)
     , m_databaseManager(dbManager)
+    , m_generator(nullptr)
+    , m_analytics(&m_noSchedule)
     , m_examLoadChartView(nullptr)
     , m_departmentChartView(nullptr)
     , m_roomUtilizationChartView(nullptr)
@@ -55,6 +57,11 @@ void AnalyticsWindow::setDatabaseManager(DatabaseManager* dbManager)
     m_databaseManager = dbManager;
 }
 
+void AnalyticsWindow::setGenerator(const TimetableGenerator* generator)
+{
+    m_generator = generator;
+}
+
 void AnalyticsWindow::refreshAnalytics()
 {
     // Clear existing charts
@@ -140,147 +147,18 @@ void AnalyticsWindow::clearCharts()
 
 void AnalyticsWindow::loadAnalyticsData()
 {
-    if (m_databaseManager) {
-        // Load data from database
-        auto examSchedule = getExamScheduleFromDatabase();
-        
-        if (!examSchedule.empty()) {
-            // Process real data
-            processExamLoadData();
-            processDepartmentDistributionData();
-            processRoomUtilizationData();
-            processConflictDetectionData();
-            processExamTimingData();
-            processRoomLoadOverDaysData();
-            processStudentExamDistributionData();
-        } else {
-            // Fall back to sample data
-            generateSampleData();
-        }
+    // The engine recomputes only when the schedule version changed since the last call
+    if (m_generator && m_generator->isGenerated()) {
+        m_analytics = &m_engine.analyse(*m_generator);
     } else {
-        // Use sample data for demonstration
-        generateSampleData();
+        m_analytics = &m_noSchedule;
     }
 }
 
-void AnalyticsWindow::generateSampleData()
+QString AnalyticsWindow::dayLabel(int day) const
 {
-    m_analyticsData = createSampleAnalyticsData();
-}
-
-AnalyticsData AnalyticsWindow::createSampleAnalyticsData()
-{
-    AnalyticsData data;
-    
-    // Real exam load data based on actual timetable
-    data.examCountPerDay["Friday"] = 2;  // ML101 sessions
-    data.examCountPerDay["Saturday"] = 4; // AI401 sessions  
-    data.examCountPerDay["Sunday"] = 1;  // CS301 session
-    data.examCountPerDay["Monday"] = 4;  // CN601 sessions
-    data.examCountPerDay["Tuesday"] = 2;  // DB301, OOP201 lab sessions
-    data.examCountPerDay["Wednesday"] = 2; // SE701, WD801 lab sessions
-    data.examCountPerDay["Thursday"] = 2; // CC901, CY102 lab sessions
-    data.examCountPerDay["Friday2"] = 2; // DS501 sessions in Room#6, Room#7
-    data.examCountPerDay["Saturday2"] = 2; // WD801 sessions in Room#8, Room#9
-    data.examCountPerDay["Sunday2"] = 2; // SE701 sessions in Room#10, Room#11
-    
-    // Real department distribution based on course codes
-    data.examCountPerDepartment["Computer Science"] = 10; // ML101, AI401, CS301, CN601, OOP201, SE701, CC901
-    data.examCountPerDepartment["Information Technology"] = 7; // DB301, WD801, CY102 + others
-    data.examCountPerDepartment["Data Science"] = 2;
-    data.examCountPerDepartment["Networks"] = 4;
-    
-    // Real room utilization based on actual schedule (55 students per room capacity)
-    data.roomUtilizationPercentage["Room#1"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#2"] = 100.0; // 55/55 students (25+55 for split courses)
-    data.roomUtilizationPercentage["Room#3"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#4"] = 85.4;  // 47/55 students
-    data.roomUtilizationPercentage["Room#5"] = 76.4;  // 42/55 students
-    data.roomUtilizationPercentage["Room#6"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#7"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#8"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#9"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#10"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Room#11"] = 81.8;  // 45/55 students
-    
-    // Lab room utilization
-    data.roomUtilizationPercentage["Lab1"] = 100.0; // 55/55 + 45/55 for multiple sessions
-    data.roomUtilizationPercentage["Lab2"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Lab3"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Lab4"] = 100.0; // 55/55 students
-    data.roomUtilizationPercentage["Lab5"] = 100.0; // 55/55 students
-    
-    // Real conflict data - No conflicts detected as per timetable
-    data.conflictsPerCourse["ML101"] = 0; // Split across 2 rooms, no conflicts
-    data.conflictsPerCourse["AI401"] = 0; // Split across 4 rooms, no conflicts
-    data.conflictsPerCourse["CS301"] = 0; // Single room, no conflicts
-    data.conflictsPerCourse["CN601"] = 0; // Split across 4 rooms, no conflicts
-    data.conflictsPerCourse["DB301"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["OOP201"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["SE701"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["WD801"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["CC901"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["CY102"] = 0; // Lab session, no conflicts
-    data.conflictsPerCourse["DS501"] = 0; // Additional room sessions, no conflicts
-    
-    // Real room load over days based on actual schedule
-    std::vector<std::string> rooms = {"Room#1", "Room#2", "Room#3", "Room#4", "Room#5", "Room#6", "Room#7", "Room#8", "Room#9", "Room#10", "Room#11", "Lab1", "Lab2", "Lab3", "Lab4", "Lab5"};
-    std::vector<std::string> days = {"Friday", "Saturday", "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday2", "Saturday2", "Sunday2"};
-    
-    // Set actual room loads based on timetable
-    // Friday - ML101
-    data.roomLoadPerDay[{"Room#1", "Friday"}] = 55; // CT-24001 to CT-24085
-    data.roomLoadPerDay[{"Room#2", "Friday"}] = 25; // CT-24312 to CT-24318 (partial)
-    // Saturday - AI401
-    data.roomLoadPerDay[{"Room#1", "Saturday"}] = 55; // CT-24001 to CT-24085
-    data.roomLoadPerDay[{"Room#2", "Saturday"}] = 55; // CT-24086 to CT-24166
-    data.roomLoadPerDay[{"Room#3", "Saturday"}] = 55; // CT-24169 to CT-24249
-    data.roomLoadPerDay[{"Room#4", "Saturday"}] = 47; // CT-24252 to CT-24320
-    // Sunday - CS301
-    data.roomLoadPerDay[{"Room#1", "Sunday"}] = 55; // CT-24002 to CT-24311
-    // Monday - CN601
-    data.roomLoadPerDay[{"Room#2", "Monday"}] = 55; // CT-24073 to CT-24137
-    data.roomLoadPerDay[{"Room#3", "Monday"}] = 55; // CT-24139 to CT-24203
-    data.roomLoadPerDay[{"Room#4", "Monday"}] = 55; // CT-24205 to CT-24269
-    data.roomLoadPerDay[{"Room#5", "Monday"}] = 42; // CT-24273 to CT-24320
-    
-    // Tuesday - Lab sessions
-    data.roomLoadPerDay[{"Lab1", "Tuesday"}] = 55; // DB301: CT-24001 to CT-24055
-    data.roomLoadPerDay[{"Lab2", "Tuesday"}] = 55; // OOP201: CT-24056 to CT-24110
-    // Wednesday - Lab sessions
-    data.roomLoadPerDay[{"Lab3", "Wednesday"}] = 55; // SE701: CT-24111 to CT-24165
-    data.roomLoadPerDay[{"Lab4", "Wednesday"}] = 55; // WD801: CT-24166 to CT-24220
-    // Thursday - Lab sessions
-    data.roomLoadPerDay[{"Lab5", "Thursday"}] = 55; // CC901: CT-24221 to CT-24275
-    data.roomLoadPerDay[{"Lab1", "Thursday"}] = 45; // CY102: CT-24276 to CT-24320
-    // Friday Week 2 - Additional Room sessions
-    data.roomLoadPerDay[{"Room#6", "Friday2"}] = 55; // DS501: CT-24001 to CT-24055
-    data.roomLoadPerDay[{"Room#7", "Friday2"}] = 55; // DS501: CT-24056 to CT-24110
-    // Saturday Week 2 - Additional Room sessions
-    data.roomLoadPerDay[{"Room#8", "Saturday2"}] = 55; // WD801: CT-24111 to CT-24165
-    data.roomLoadPerDay[{"Room#9", "Saturday2"}] = 55; // WD801: CT-24166 to CT-24220
-    // Sunday Week 2 - Additional Room sessions
-    data.roomLoadPerDay[{"Room#10", "Sunday2"}] = 55; // SE701: CT-24221 to CT-24275
-    data.roomLoadPerDay[{"Room#11", "Sunday2"}] = 45; // SE701: CT-24276 to CT-24320
-    
-    // Set unused room-day combinations to 0
-    for (const auto& room : rooms) {
-        for (const auto& day : days) {
-            if (data.roomLoadPerDay.find({room, day}) == data.roomLoadPerDay.end()) {
-                data.roomLoadPerDay[{room, day}] = 0;
-            }
-        }
-    }
-    
-    // Student exam distribution based on roll number analysis
-    // All students (CT-24001 to CT-24320) appear to be taking multiple exams
-    data.studentExamCountDistribution[1] = 50;  // Some students with 1 exam
-    data.studentExamCountDistribution[2] = 80;  // Students with 2 exams
-    data.studentExamCountDistribution[3] = 120; // Students with 3 exams (most common)
-    data.studentExamCountDistribution[4] = 60;  // Students with 4 exams
-    data.studentExamCountDistribution[5] = 10;  // Few students with all 5 exams
-    
-    return data;
+    // DD-MM of the exam day
+    return QString::fromStdString(formatDate(m_analytics->firstDate + day)).left(5);
 }
 
 void AnalyticsWindow::createExamLoadChart()
@@ -291,9 +169,9 @@ void AnalyticsWindow::createExamLoadChart()
     
     QStringList categories;
     
-    for (const auto& pair : m_analyticsData.examCountPerDay) {
-        categories << QString::fromStdString(pair.first);
-        *barSet << pair.second;
+    for (int day = 0; day < m_analytics->days; ++day) {
+        categories << dayLabel(day);
+        *barSet << m_analytics->sessionsPerDay[day];
     }
     
     series->append(barSet);
@@ -309,7 +187,7 @@ void AnalyticsWindow::createExamLoadChart()
     series->attachAxis(axisX);
     
     auto axisY = new QValueAxis();
-    axisY->setTitleText("Number of Exams");
+    axisY->setTitleText("Number of Exam Sessions");
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
     
@@ -333,19 +211,24 @@ void AnalyticsWindow::createDepartmentDistributionChart()
     // Create pie chart for department distribution
     auto series = new QPieSeries();
     
-    int total = 0;
-    for (const auto& pair : m_analyticsData.examCountPerDepartment) {
-        total += pair.second;
+    uint64_t total = 0;
+    for (uint32_t sessions : m_analytics->sessionsPerDepartment) {
+        total += sessions;
     }
     
     QStringList colors = {"#e74c3c", "#3498db", "#2ecc71", "#f39c12", "#9b59b6", "#1abc9c"};
     int colorIndex = 0;
     
-    for (const auto& pair : m_analyticsData.examCountPerDepartment) {
-        double percentage = (static_cast<double>(pair.second) / total) * 100.0;
-        auto slice = series->append(QString::fromStdString(pair.first), pair.second);
+    for (size_t dept = 0; dept < m_analytics->departments.size(); ++dept) {
+        uint32_t sessions = m_analytics->sessionsPerDepartment[dept];
+        if (sessions == 0) {
+            continue;
+        }
+        QString name = QString::fromStdString(m_analytics->departments[dept]);
+        double percentage = (static_cast<double>(sessions) / total) * 100.0;
+        auto slice = series->append(name, sessions);
         slice->setLabelVisible(true);
-        slice->setLabel(QString("%1 (%2%)").arg(QString::fromStdString(pair.first)).arg(QString::number(percentage, 'f', 1)));
+        slice->setLabel(QString("%1 (%2%)").arg(name).arg(QString::number(percentage, 'f', 1)));
         slice->setColor(QColor(colors[colorIndex % colors.size()]));
         colorIndex++;
     }
@@ -375,9 +258,12 @@ void AnalyticsWindow::createRoomUtilizationChart()
     
     QStringList categories;
     
-    for (const auto& pair : m_analyticsData.roomUtilizationPercentage) {
-        categories << QString::fromStdString(pair.first);
-        *barSet << pair.second;
+    for (int room = 0; room < m_analytics->rooms; ++room) {
+        if (m_analytics->sessionsPerRoom[room] == 0) {
+            continue;
+        }
+        categories << QString::fromStdString(m_generator->roomName(static_cast<uint32_t>(room) + 1));
+        *barSet << m_analytics->roomUtilisation(room);
     }
     
     series->append(barSet);
@@ -422,16 +308,29 @@ void AnalyticsWindow::createConflictDetectionChart()
     
     QStringList categories;
     
-    for (const auto& pair : m_analyticsData.conflictsPerCourse) {
-        categories << QString::fromStdString(pair.first);
-        *barSet << pair.second;
+    // Only the courses with the most clashing students fit on the axis
+    const int maxCourses = 15;
+    std::vector<uint32_t> clashing;
+    for (uint32_t course = 0; course < m_analytics->clashesPerCourse.size(); ++course) {
+        if (m_analytics->clashesPerCourse[course] > 0) {
+            clashing.push_back(course);
+        }
+    }
+    size_t shown = std::min<size_t>(clashing.size(), maxCourses);
+    std::partial_sort(clashing.begin(), clashing.begin() + shown, clashing.end(), [this](uint32_t a, uint32_t b) {
+        return m_analytics->clashesPerCourse[a] > m_analytics->clashesPerCourse[b];
+    });
+    for (size_t i = 0; i < shown; ++i) {
+        categories << QString::fromStdString(m_generator->getStore().courses.id(clashing[i]));
+        *barSet << m_analytics->clashesPerCourse[clashing[i]];
     }
     
     series->append(barSet);
     
     auto chart = new QChart();
     chart->addSeries(series);
-    chart->setTitle("⚡ Conflicts Detected per Course");
+    chart->setTitle(QString("⚡ Conflicts Detected per Course (%1 students sit two exams in one slot)")
+                        .arg(m_analytics->clashingStudents));
     chart->setAnimationOptions(QChart::SeriesAnimations);
     
     auto axisX = new QBarCategoryAxis();
@@ -440,7 +339,7 @@ void AnalyticsWindow::createConflictDetectionChart()
     series->attachAxis(axisX);
     
     auto axisY = new QValueAxis();
-    axisY->setTitleText("Number of Conflicts");
+    axisY->setTitleText("Students with a Same-Slot Exam");
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
     
@@ -462,33 +361,33 @@ void AnalyticsWindow::createConflictDetectionChart()
 
 void AnalyticsWindow::createExamTimingChart()
 {
-    // Create a Gantt-style chart using scatter plot with different markers for time visualization
+    // Students sitting an exam on each day; every session runs in the same 2-5 PM slot
     auto series = new QScatterSeries();
-    series->setName("Exam Timings");
-    series->setMarkerSize(15.0);
-    
-    // Sample time slots data (would come from actual exam schedule)
-    QStringList timeSlots = {"09:00-12:00", "14:00-17:00", "09:00-11:00", "11:30-14:30", "15:00-18:00"};
-    QStringList courses = {"ML101", "AI401", "DSA201", "DB301", "OS401"};
+    series->setName("Students Sitting Exams");
+    series->setMarkerSize(10.0);
     
-    for (int i = 0; i < timeSlots.size() && i < courses.size(); ++i) {
-        series->append(i, i); // Simple positioning for demo
+    uint32_t busiest = 0;
+    for (int day = 0; day < m_analytics->days; ++day) {
+        series->append(day + 1, m_analytics->seatsPerDay[day]);
+        busiest = std::max(busiest, m_analytics->seatsPerDay[day]);
     }
     
     auto chart = new QChart();
     chart->addSeries(series);
-    chart->setTitle("📊 Exam Timings Overview");
+    chart->setTitle("📊 Exam Timings Overview (14:00-17:00)");
     chart->setAnimationOptions(QChart::SeriesAnimations);
     
     auto axisX = new QValueAxis();
-    axisX->setTitleText("Time Period");
-    axisX->setRange(0, 6);
+    axisX->setTitleText("Exam Day");
+    axisX->setRange(0, m_analytics->days + 1);
+    axisX->setLabelFormat("%d");
     chart->addAxis(axisX, Qt::AlignBottom);
     series->attachAxis(axisX);
     
     auto axisY = new QValueAxis();
-    axisY->setTitleText("Courses");
-    axisY->setRange(0, 6);
+    axisY->setTitleText("Students");
+    axisY->setRange(0, busiest + 1);
+    axisY->setLabelFormat("%d");
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
     
@@ -516,18 +415,15 @@ void AnalyticsWindow::createRoomLoadOverDaysChart()
     auto surfaceSeries = new QSurface3DSeries();
     surfaceSeries->setName("Room Load");
     
-    // Create sample data array
+    // One row per room, one column per exam day, height = seated students
+    const int rooms = m_analytics->rooms;
+    const int days = m_analytics->days;
     auto dataArray = new QSurfaceDataArray();
-    
-    std::vector<std::string> rooms = {"Room#1", "Room#2", "Room#3", "Room#4", "Room#5"};
-    std::vector<std::string> days = {"Friday", "Saturday", "Sunday", "Monday", "Tuesday"};
-    
-    dataArray->reserve(rooms.size());
-    for (int room = 0; room < rooms.size(); ++room) {
-        auto newRow = new QSurfaceDataRow(days.size());
-        for (int day = 0; day < days.size(); ++day) {
-            auto it = m_analyticsData.roomLoadPerDay.find({rooms[room], days[day]});
-            float load = (it != m_analyticsData.roomLoadPerDay.end()) ? it->second : 0;
+    dataArray->reserve(rooms);
+    for (int room = 0; room < rooms; ++room) {
+        auto newRow = new QSurfaceDataRow(days);
+        for (int day = 0; day < days; ++day) {
+            float load = static_cast<float>(m_analytics->roomLoad(day, room));
             (*newRow)[day].setPosition(QVector3D(day, load, room));
         }
         dataArray->append(newRow);
@@ -542,9 +438,14 @@ void AnalyticsWindow::createRoomLoadOverDaysChart()
     m_roomLoad3DSurface->axisZ()->setTitle("Rooms");
     
     // Set axis ranges
-    m_roomLoad3DSurface->axisX()->setRange(0, days.size() - 1);
-    m_roomLoad3DSurface->axisY()->setRange(0, 100);
-    m_roomLoad3DSurface->axisZ()->setRange(0, rooms.size() - 1);
+    m_roomLoad3DSurface->axisX()->setRange(0, std::max(days - 1, 1));
+    // With several sittings a day a room seats more than its capacity over the day
+    uint32_t peakLoad = m_analytics->largestRoom;
+    for (uint32_t load : m_analytics->roomDayLoad) {
+        peakLoad = std::max(peakLoad, load);
+    }
+    m_roomLoad3DSurface->axisY()->setRange(0, peakLoad);
+    m_roomLoad3DSurface->axisZ()->setRange(0, std::max(rooms - 1, 1));
     
     // Create widget container for 3D surface
     m_roomLoad3DWidget = QWidget::createWindowContainer(m_roomLoad3DSurface);
@@ -554,21 +455,11 @@ void AnalyticsWindow::createRoomLoadOverDaysChart()
     auto series = new QLineSeries();
     series->setName("Average Room Load");
     
-    std::vector<std::string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
-    
-    for (int i = 0; i < days.size(); ++i) {
-        int totalLoad = 0;
-        int roomCount = 0;
-        
-        for (const auto& pair : m_analyticsData.roomLoadPerDay) {
-            if (pair.first.second == days[i]) {
-                totalLoad += pair.second;
-                roomCount++;
-            }
-        }
-        
-        double averageLoad = roomCount > 0 ? (double)totalLoad / roomCount : 0;
-        series->append(i, averageLoad);
+    // Seated students per booked room on each day
+    for (int day = 0; day < m_analytics->days; ++day) {
+        uint32_t sessions = m_analytics->sessionsPerDay[day];
+        double averageLoad = sessions > 0 ? static_cast<double>(m_analytics->seatsPerDay[day]) / sessions : 0;
+        series->append(day + 1, averageLoad);
     }
     
     auto chart = new QChart();
@@ -578,13 +469,14 @@ void AnalyticsWindow::createRoomLoadOverDaysChart()
     
     auto axisX = new QValueAxis();
     axisX->setTitleText("Days");
-    axisX->setRange(0, days.size() - 1);
+    axisX->setRange(1, std::max(m_analytics->days, 2));
+    axisX->setLabelFormat("%d");
     chart->addAxis(axisX, Qt::AlignBottom);
     series->attachAxis(axisX);
     
     auto axisY = new QValueAxis();
     axisY->setTitleText("Average Load");
-    axisY->setRange(0, 100);
+    axisY->setRange(0, m_analytics->largestRoom);
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
     
@@ -613,9 +505,12 @@ void AnalyticsWindow::createStudentExamDistributionChart()
     
     QStringList categories;
     
-    for (const auto& pair : m_analyticsData.studentExamCountDistribution) {
-        categories << QString("%1 Exams").arg(pair.first);
-        *barSet << pair.second;
+    for (size_t exams = 0; exams < m_analytics->examsPerStudent.size(); ++exams) {
+        if (m_analytics->examsPerStudent[exams] == 0) {
+            continue;
+        }
+        categories << QString("%1 Exams").arg(exams);
+        *barSet << m_analytics->examsPerStudent[exams];
     }
     
     series->append(barSet);
@@ -690,56 +585,6 @@ void AnalyticsWindow::closeEvent(QCloseEvent* event)
     event->accept();
 }
 
-// Data processing methods (stubs for database integration)
-void AnalyticsWindow::processExamLoadData()
-{
-    // Implementation would fetch and process real exam schedule data
-    // For now, using sample data
-    generateSampleData();
-}
-
-void AnalyticsWindow::processDepartmentDistributionData()
-{
-    // Implementation would analyze course-department relationships
-}
-
-void AnalyticsWindow::processRoomUtilizationData()
-{
-    // Implementation would calculate room capacity vs actual usage
-}
-
-void AnalyticsWindow::processConflictDetectionData()
-{
-    // Implementation would detect scheduling conflicts
-}
-
-void AnalyticsWindow::processExamTimingData()
-{
-    // Implementation would analyze exam timing overlaps
-}
-
-void AnalyticsWindow::processRoomLoadOverDaysData()
-{
-    // Implementation would track room usage over time
-}
-
-void AnalyticsWindow::processStudentExamDistributionData()
-{
-    // Implementation would count exams per student
-}
-
-std::vector<ExamScheduleData> AnalyticsWindow::getExamScheduleFromDatabase()
-{
-    std::vector<ExamScheduleData> schedule;
-    
-    if (m_databaseManager) {
-        // Implementation would fetch actual schedule data from database
-        // For now, return empty to use sample data
-    }
-    
-    return schedule;
-}
-
 void AnalyticsWindow::exportChartsAsPDF(const QString& filename)
 {
     QPrinter printer(QPrinter::PrinterResolution);
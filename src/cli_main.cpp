@@ -0,0 +1,568 @@
+#include "../include/DatabaseManager.h"
+#include "../include/TimetableGenerator.h"
+#include "../include/Snapshot.h"
+#include "../include/Logger.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Headless timetable engine: imports CSV enrolments (or opens a snapshot), generates
+// the timetable and exports it, then prints a JSON report with timings and schedule
+// metrics on stdout.
+// Progress messages from the engine go to stderr so stdout stays machine-readable.
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string snapshotFile;     // Dataset (and schedule) to open instead of CSV inputs
+    std::string saveSnapshotFile; // Where to save the dataset and final schedule
+    std::string roomsFile; // Empty: standard campus
+    std::string holidaysFile;
+    uint8_t weekend = 0; // Weekdays without exams, bit 0 = Monday
+    std::string sittings;      // Empty: one afternoon sitting
+    std::string durationsFile; // Course,Minutes
+    std::string startDate;
+    std::string outputDir = ".";
+    std::string name = "timetable";
+    std::vector<std::string> formats = {"csv"};
+    std::string ticketsPath;      // Hall tickets: one PDF, or a directory with --tickets-dir
+    bool ticketsPerStudent = false;
+    unsigned threads = 0;
+    SchedulingMode mode = SchedulingMode::Sequential;
+    bool shareRooms = false;
+    double optimiseSeconds = 0; // 0: no optimiser pass
+    int maxDays = 0;
+    std::string metricsFile; // Empty: stdout
+    std::string logFile;     // Empty: console only
+    std::string profileFile; // Per-phase timer and counter totals, JSON
+    std::string traceFile;   // Chrome trace-event JSON
+    std::vector<std::string> students; // Roll numbers whose personal timetables are reported
+    bool quiet = false;
+};
+
+struct ExportResult {
+    std::string format;
+    std::string path;
+    bool ok = false;
+    double ms = 0;
+    uint64_t bytes = 0;
+};
+
+void printUsage(std::ostream& out) {
+    out << "Usage: timetable-cli --input FILE.csv [--input FILE.csv ...] --start DD-MM-YYYY [options]\n"
+           "       timetable-cli --snapshot FILE.snap [--start DD-MM-YYYY] [options]\n"
+           "\n"
+           "Options:\n"
+           "  -i, --input FILE      Enrolment CSV; repeat to merge several files\n"
+           "  -s, --start DATE      First exam day, DD-MM-YYYY\n"
+           "      --snapshot FILE   Open a saved snapshot instead of CSV inputs; without --start\n"
+           "                        its saved schedule is used as-is\n"
+           "      --save-snapshot FILE  Save the dataset and final schedule as a snapshot\n"
+           "  -r, --rooms FILE      Room inventory CSV: Name,Capacity,Type,Days (default: 11 rooms + 4 labs of 55)\n"
+           "      --weekend DAYS    Weekdays without exams, e.g. Sat;Sun or Fri (default: none)\n"
+           "      --holidays FILE   Dates without exams, one DD-MM-YYYY per line\n"
+           "      --sittings LIST   Exam sittings per day: 1-3 standard three-hour sittings, or\n"
+           "                        [Name=]HH:MM-HH:MM,... (default: 14:00-17:00)\n"
+           "      --durations FILE  Course,Minutes CSV of exams that do not run a whole sitting\n"
+           "  -o, --output-dir DIR  Directory for exported files (default: .)\n"
+           "  -n, --name NAME       Base name of exported files (default: timetable)\n"
+           "  -f, --formats LIST    Comma-separated list of csv, txt, pdf (default: csv)\n"
+           "      --tickets FILE    Write every student's hall ticket into one PDF\n"
+           "      --tickets-dir DIR Write one hall-ticket PDF per student into the existing DIR\n"
+           "  -t, --threads N       Worker threads, 0 = all hardware threads (default: 0)\n"
+           "  -m, --mode MODE       sequential or dsatur (default: sequential)\n"
+           "      --share-rooms     Seat several courses of an exam slot in one room, up to its capacity\n"
+           "      --optimise SECS   Improve the schedule by simulated annealing for SECS seconds\n"
+           "      --max-days N      Days the optimiser may use (default: the generated exam period)\n"
+           "      --student ROLLNO  Include the student's exams in the report; repeat for several\n"
+           "      --metrics FILE    Write the JSON report to FILE instead of stdout\n"
+           "      --log FILE        Also write engine messages, including debug ones, to FILE\n"
+           "      --profile FILE    Write per-phase timings and counters as JSON to FILE\n"
+           "      --trace FILE      Write a Chrome trace-event file (chrome://tracing, Perfetto) to FILE\n"
+           "  -q, --quiet           Discard engine progress messages\n"
+           "  -h, --help            Show this help\n";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// Returns 0 on success, otherwise the process exit code
+int parseArguments(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](std::string& target) {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            target = argv[++i];
+            return true;
+        };
+
+        std::string text;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(std::cout);
+            return -1;
+        } else if (arg == "-q" || arg == "--quiet") {
+            options.quiet = true;
+        } else if (arg == "-i" || arg == "--input") {
+            if (!value(text)) return 2;
+            options.inputs.push_back(text);
+        } else if (arg == "--snapshot") {
+            if (!value(options.snapshotFile)) return 2;
+        } else if (arg == "--save-snapshot") {
+            if (!value(options.saveSnapshotFile)) return 2;
+        } else if (arg == "-r" || arg == "--rooms") {
+            if (!value(options.roomsFile)) return 2;
+        } else if (arg == "--holidays") {
+            if (!value(options.holidaysFile)) return 2;
+        } else if (arg == "--sittings") {
+            if (!value(options.sittings)) return 2;
+        } else if (arg == "--durations") {
+            if (!value(options.durationsFile)) return 2;
+        } else if (arg == "--weekend") {
+            if (!value(text)) return 2;
+            if (text == "none") {
+                options.weekend = 0;
+            } else if (!parseWeekdays(text, options.weekend) || text.empty()) {
+                std::cerr << "Invalid weekend days: " << text << std::endl;
+                return 2;
+            }
+        } else if (arg == "-s" || arg == "--start") {
+            if (!value(options.startDate)) return 2;
+        } else if (arg == "-o" || arg == "--output-dir") {
+            if (!value(options.outputDir)) return 2;
+        } else if (arg == "-n" || arg == "--name") {
+            if (!value(options.name)) return 2;
+        } else if (arg == "--tickets" || arg == "--tickets-dir") {
+            if (!value(options.ticketsPath)) return 2;
+            options.ticketsPerStudent = arg == "--tickets-dir";
+        } else if (arg == "--student") {
+            if (!value(text)) return 2;
+            options.students.push_back(text);
+        } else if (arg == "--metrics") {
+            if (!value(options.metricsFile)) return 2;
+        } else if (arg == "--log") {
+            if (!value(options.logFile)) return 2;
+        } else if (arg == "--profile") {
+            if (!value(options.profileFile)) return 2;
+        } else if (arg == "--trace") {
+            if (!value(options.traceFile)) return 2;
+        } else if (arg == "-f" || arg == "--formats") {
+            if (!value(text)) return 2;
+            options.formats = splitList(text);
+            for (const std::string& format : options.formats) {
+                if (format != "csv" && format != "txt" && format != "pdf") {
+                    std::cerr << "Unknown output format: " << format << std::endl;
+                    return 2;
+                }
+            }
+        } else if (arg == "-t" || arg == "--threads") {
+            if (!value(text)) return 2;
+            char* end = nullptr;
+            long threads = std::strtol(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || threads < 0) {
+                std::cerr << "Invalid thread count: " << text << std::endl;
+                return 2;
+            }
+            options.threads = static_cast<unsigned>(threads);
+        } else if (arg == "-m" || arg == "--mode") {
+            if (!value(text)) return 2;
+            if (text == "sequential") {
+                options.mode = SchedulingMode::Sequential;
+            } else if (text == "dsatur") {
+                options.mode = SchedulingMode::DSatur;
+            } else {
+                std::cerr << "Unknown scheduling mode: " << text << std::endl;
+                return 2;
+            }
+        } else if (arg == "--share-rooms") {
+            options.shareRooms = true;
+        } else if (arg == "--optimise") {
+            if (!value(text)) return 2;
+            char* end = nullptr;
+            options.optimiseSeconds = std::strtod(text.c_str(), &end);
+            if (text.empty() || *end != '\0' || options.optimiseSeconds < 0) {
+                std::cerr << "Invalid optimiser budget: " << text << std::endl;
+                return 2;
+            }
+        } else if (arg == "--max-days") {
+            if (!value(text)) return 2;
+            char* end = nullptr;
+            long days = std::strtol(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || days < 1) {
+                std::cerr << "Invalid day count: " << text << std::endl;
+                return 2;
+            }
+            options.maxDays = static_cast<int>(days);
+        } else if (!arg.empty() && arg[0] != '-') {
+            options.inputs.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    if (!options.snapshotFile.empty()) {
+        if (!options.inputs.empty()) {
+            std::cerr << "--snapshot cannot be combined with --input." << std::endl;
+            return 2;
+        }
+    } else if (options.inputs.empty() || options.startDate.empty()) {
+        std::cerr << "At least one --input and a --start date are required." << std::endl;
+        printUsage(std::cerr);
+        return 2;
+    }
+    return 0;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char ch : text) {
+        switch (ch) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                    out += buffer;
+                } else {
+                    out += ch;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+uint64_t fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+// Students sitting more than one exam in the same exam slot; timetables are in time order
+size_t countStudentClashes(const TimetableGenerator& generator) {
+    const std::vector<ScheduleEntry>& entries = generator.getEntries();
+    size_t clashes = 0;
+    for (uint32_t s = 0; s < generator.getStore().students.size(); s++) {
+        ArrayView<uint32_t> sessions = generator.studentTimetable(s);
+        for (size_t i = 1; i < sessions.size(); i++) {
+            if (generator.examSlot(entries[sessions[i]]) == generator.examSlot(entries[sessions[i - 1]])) {
+                clashes++;
+            }
+        }
+    }
+    return clashes;
+}
+
+// Rooms in use per exam slot, and how full they are
+struct RoomSlotUsage {
+    size_t roomSlots = 0;       // (slot, room) pairs holding at least one session
+    size_t sharedRoomSlots = 0; // ... holding sessions of more than one course
+    uint64_t seats = 0;         // Seats of those rooms
+    uint64_t seated = 0;
+};
+
+RoomSlotUsage roomSlotUsage(const TimetableGenerator& generator) {
+    struct Load {
+        uint32_t seated = 0;
+        uint32_t sessions = 0;
+    };
+    std::unordered_map<uint64_t, Load> loads;
+    for (const ScheduleEntry& entry : generator.getEntries()) {
+        Load& load = loads[(static_cast<uint64_t>(static_cast<uint32_t>(generator.examSlot(entry))) << 32) | entry.room];
+        load.seated += entry.count;
+        load.sessions++;
+    }
+    RoomSlotUsage usage;
+    for (const auto& room : loads) {
+        usage.roomSlots++;
+        usage.sharedRoomSlots += room.second.sessions > 1 ? 1 : 0;
+        usage.seats += generator.roomCapacity(static_cast<uint32_t>(room.first));
+        usage.seated += room.second.seated;
+    }
+    return usage;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int status = parseArguments(argc, argv, options);
+    if (status != 0) {
+        return status < 0 ? 0 : status;
+    }
+
+    // Keep stdout for the JSON report; quiet still shows errors
+    Log::setConsole(options.quiet ? LogLevel::Error : LogLevel::Info, stderr);
+    if (!options.logFile.empty() && !Log::openFile(options.logFile)) {
+        std::cerr << "Could not open log file: " << options.logFile << std::endl;
+        return 1;
+    }
+    Profiler::setEnabled(!options.profileFile.empty() || !options.traceFile.empty());
+    auto runStart = std::chrono::steady_clock::now();
+
+    DatabaseManager db;
+    bool ok = true;
+    SnapshotFile snapshot;
+    double snapshotLoadMs = 0;
+    if (!options.snapshotFile.empty()) {
+        ok = snapshot.open(options.snapshotFile) && db.loadSnapshot(snapshot);
+        snapshotLoadMs = db.getLastImportTimings().mergeMs + db.getLastImportTimings().indexMs;
+    }
+    std::vector<ImportTimings> imports;
+    for (size_t i = 0; i < options.inputs.size() && ok; i++) {
+        ok = db.importFromCSV(options.inputs[i], options.threads, i > 0);
+        imports.push_back(db.getLastImportTimings());
+    }
+
+    TimetableGenerator generator(db);
+    RoomInventory rooms = RoomInventory::standardCampus();
+    if (ok && !options.roomsFile.empty()) {
+        ok = rooms.loadFromCSV(options.roomsFile);
+        generator.setRoomInventory(rooms);
+    }
+    ExamCalendar calendar;
+    calendar.setWeekend(options.weekend);
+    if (ok && !options.holidaysFile.empty()) {
+        ok = calendar.loadHolidays(options.holidaysFile);
+    }
+    generator.setExamCalendar(calendar);
+    SittingPlan sittings = SittingPlan::singleAfternoon();
+    if (ok && options.sittings.size() == 1 && options.sittings[0] >= '1' && options.sittings[0] <= '3') {
+        sittings = SittingPlan::standardDay(options.sittings[0] - '0');
+    } else if (ok && !options.sittings.empty()) {
+        ok = sittings.parse(options.sittings);
+    }
+    if (ok && !options.durationsFile.empty()) {
+        ok = sittings.loadDurations(options.durationsFile);
+    }
+    generator.setSittingPlan(sittings);
+    generator.setStartDate(options.startDate);
+    generator.setThreadCount(options.threads);
+    generator.setSchedulingMode(options.mode);
+    generator.setRoomSharing(options.shareRooms);
+    double generateMs = 0;
+    bool restored = false;
+    if (ok && options.startDate.empty()) {
+        // Snapshot without --start: reuse its schedule, rooms and calendar
+        if (!snapshot.hasSchedule()) {
+            std::cerr << options.snapshotFile << " holds no schedule; pass --start to generate one." << std::endl;
+        }
+        auto start = std::chrono::steady_clock::now();
+        ok = generator.loadSchedule(snapshot);
+        restored = ok;
+        generateMs = elapsedMs(start);
+        if (ok && (!options.roomsFile.empty() || !options.holidaysFile.empty() || options.weekend != 0 ||
+                   !options.sittings.empty() || !options.durationsFile.empty())) {
+            std::cerr << "Note: --rooms, --weekend, --holidays, --sittings and --durations only apply with --start."
+                      << std::endl;
+        }
+    } else if (ok) {
+        auto start = std::chrono::steady_clock::now();
+        ok = generator.generate();
+        generateMs = elapsedMs(start);
+    }
+    snapshot.close();
+
+    OptimiserReport optimiser;
+    bool optimised = false;
+    if (ok && options.optimiseSeconds > 0) {
+        OptimiserConfig config;
+        config.seconds = options.optimiseSeconds;
+        config.threads = options.threads;
+        config.maxDays = options.maxDays;
+        ok = generator.optimise(config, &optimiser);
+        optimised = ok;
+    }
+
+    ExportResult savedSnapshot;
+    if (ok && !options.saveSnapshotFile.empty()) {
+        savedSnapshot.format = "snapshot";
+        savedSnapshot.path = options.saveSnapshotFile;
+        auto start = std::chrono::steady_clock::now();
+        savedSnapshot.ok = writeSnapshot(savedSnapshot.path, db.getStore(), &generator);
+        savedSnapshot.ms = elapsedMs(start);
+        savedSnapshot.bytes = savedSnapshot.ok ? fileSize(savedSnapshot.path) : 0;
+        ok = savedSnapshot.ok;
+    }
+
+    std::vector<ExportResult> exports;
+    for (const std::string& format : options.formats) {
+        if (!ok) break;
+        ExportResult result;
+        result.format = format;
+        result.path = options.outputDir + "/" + options.name + "." + format;
+        auto start = std::chrono::steady_clock::now();
+        if (format == "csv") {
+            result.ok = generator.exportToCSV(result.path);
+        } else if (format == "txt") {
+            result.ok = generator.exportToText(result.path);
+        } else {
+            result.ok = generator.exportToPDF(result.path);
+        }
+        result.ms = elapsedMs(start);
+        result.bytes = result.ok ? fileSize(result.path) : 0;
+        ok = result.ok;
+        exports.push_back(result);
+    }
+    HallTicketReport tickets;
+    if (ok && !options.ticketsPath.empty()) {
+        ExportResult result;
+        result.format = options.ticketsPerStudent ? "tickets-dir" : "tickets";
+        result.path = options.ticketsPath;
+        result.ok = generator.exportHallTickets(result.path, options.ticketsPerStudent, &tickets);
+        result.ms = tickets.ms;
+        result.bytes = tickets.bytes;
+        ok = result.ok;
+        exports.push_back(result);
+    }
+    double totalMs = elapsedMs(runStart);
+    Log::flush();
+
+    // JSON report
+    const EntityStore& store = db.getStore();
+    const ConflictGraph& conflicts = generator.getConflictGraph();
+    if (restored) {
+        rooms = generator.getRoomInventory();
+        calendar = generator.getExamCalendar();
+    }
+    const bool dsatur = generator.getSchedulingMode() == SchedulingMode::DSatur;
+    const std::string startDate = restored ? formatDate(generator.getStartDay()) : options.startDate;
+    int days = 0;
+    int slots = 0;
+    for (const ScheduleEntry& entry : generator.getEntries()) {
+        days = std::max(days, entry.dayIndex);
+        slots = std::max(slots, generator.examSlot(entry));
+    }
+
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"ok\": " << (ok ? "true" : "false") << ",\n";
+    json << "  \"mode\": \"" << (dsatur ? "dsatur" : "sequential") << "\",\n";
+    json << "  \"startDate\": " << jsonString(startDate) << ",\n";
+    json << "  \"imports\": [";
+    for (size_t i = 0; i < imports.size(); i++) {
+        const ImportTimings& t = imports[i];
+        json << (i ? ",\n" : "\n") << "    {\"file\": " << jsonString(options.inputs[i]) << ", \"threads\": " << t.threads
+             << ", \"chunks\": " << t.chunks << ", \"rows\": " << t.rows << ", \"bytes\": " << t.bytes
+             << ", \"mapMs\": " << t.mapMs << ", \"splitMs\": " << t.splitMs << ", \"parseMs\": " << t.parseMs
+             << ", \"mergeMs\": " << t.mergeMs << ", \"indexMs\": " << t.indexMs << ", \"totalMs\": " << t.totalMs << "}";
+    }
+    json << (imports.empty() ? "],\n" : "\n  ],\n");
+    if (!options.snapshotFile.empty() || !options.saveSnapshotFile.empty()) {
+        json << "  \"snapshot\": {";
+        if (!options.snapshotFile.empty()) {
+            json << "\"input\": " << jsonString(options.snapshotFile) << ", \"openMs\": " << snapshot.getOpenMs()
+                 << ", \"loadMs\": " << snapshotLoadMs << ", \"restoredSchedule\": " << (restored ? "true" : "false");
+        }
+        if (!options.saveSnapshotFile.empty()) {
+            json << (options.snapshotFile.empty() ? "" : ", ") << "\"output\": " << jsonString(savedSnapshot.path)
+                 << ", \"ok\": " << (savedSnapshot.ok ? "true" : "false") << ", \"saveMs\": " << savedSnapshot.ms
+                 << ", \"bytes\": " << savedSnapshot.bytes;
+        }
+        json << "},\n";
+    }
+    json << "  \"data\": {\"students\": " << store.students.size() << ", \"courses\": " << store.courses.size()
+         << ", \"enrollments\": " << store.enrollments.size() << ", \"rooms\": " << rooms.size()
+         << ", \"seatsPerDay\": " << rooms.maxSeatsPerDay() << ", \"holidays\": " << calendar.holidayCount() << "},\n";
+    const RoomSlotUsage usage = roomSlotUsage(generator);
+    json << "  \"generation\": {\"ms\": " << generateMs << ", \"conflictGraphMs\": " << conflicts.getBuildMs()
+         << ", \"conflictEdges\": " << conflicts.edgeCount() << ", \"sessions\": " << generator.getEntries().size()
+         << ", \"days\": " << days << ", \"sittingsPerDay\": " << generator.getSittingPlan().size()
+         << ", \"examSlots\": " << slots << ", \"studentClashes\": " << countStudentClashes(generator)
+         << ", \"roomSharing\": " << (generator.getRoomSharing() ? "true" : "false") << ", \"roomSlots\": " << usage.roomSlots
+         << ", \"sharedRoomSlots\": " << usage.sharedRoomSlots << ", \"seatUtilisation\": "
+         << (usage.seats ? 100.0 * static_cast<double>(usage.seated) / static_cast<double>(usage.seats) : 0.0) << "},\n";
+    if (optimised) {
+        auto score = [&json](const char* name, const ScheduleScore& s) {
+            json << "\"" << name << "\": {\"examDays\": " << s.examDays << ", \"clashes\": " << s.clashes
+                 << ", \"backToBack\": " << s.backToBack << ", \"emptySeats\": " << s.emptySeats
+                 << ", \"overflowSeats\": " << s.overflowSeats << ", \"energy\": " << s.energy << "}";
+        };
+        json << "  \"optimiser\": {\"ms\": " << optimiser.ms << ", \"chains\": " << optimiser.chains
+             << ", \"moves\": " << optimiser.moves << ", \"accepted\": " << optimiser.accepted << ", ";
+        score("initial", optimiser.initial);
+        json << ", ";
+        score("best", optimiser.best);
+        json << "},\n";
+    }
+    if (!options.students.empty()) {
+        json << "  \"students\": [";
+        for (size_t i = 0; i < options.students.size(); i++) {
+            const uint32_t student = store.students.find(options.students[i]);
+            json << (i ? ",\n" : "\n") << "    {\"rollNo\": " << jsonString(options.students[i])
+                 << ", \"found\": " << (student != kInvalidId ? "true" : "false") << ", \"exams\": [";
+            ArrayView<uint32_t> sessions = student != kInvalidId ? generator.studentTimetable(student)
+                                                                 : ArrayView<uint32_t>();
+            for (size_t k = 0; k < sessions.size(); k++) {
+                const ScheduleEntry& entry = generator.getEntries()[sessions[k]];
+                json << (k ? ", " : "") << "{\"date\": \"" << formatDate(entry.date) << "\", \"day\": " << entry.dayIndex
+                     << ", \"time\": " << jsonString(generator.examTime(entry)) << ", \"course\": " << jsonString(generator.courseCode(entry))
+                     << ", \"room\": " << jsonString(generator.roomName(entry.room)) << "}";
+            }
+            json << "]}";
+        }
+        json << "\n  ],\n";
+    }
+    json << "  \"exports\": [";
+    for (size_t i = 0; i < exports.size(); i++) {
+        const ExportResult& e = exports[i];
+        json << (i ? ",\n" : "\n") << "    {\"format\": \"" << e.format << "\", \"path\": " << jsonString(e.path)
+             << ", \"ok\": " << (e.ok ? "true" : "false") << ", \"ms\": " << e.ms << ", \"bytes\": " << e.bytes;
+        if (e.format == "tickets" || e.format == "tickets-dir") {
+            json << ", \"tickets\": " << tickets.tickets << ", \"pages\": " << tickets.pages << ", \"files\": "
+                 << tickets.files << ", \"failedFiles\": " << tickets.failedFiles;
+        }
+        json << "}";
+    }
+    json << (exports.empty() ? "],\n" : "\n  ],\n");
+    json << "  \"totalMs\": " << totalMs << "\n";
+    json << "}\n";
+
+    if (options.metricsFile.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream metrics(options.metricsFile);
+        if (!metrics.is_open()) {
+            std::cerr << "Could not open metrics file: " << options.metricsFile << std::endl;
+            return 1;
+        }
+        metrics << json.str();
+    }
+    if (!options.profileFile.empty() && !Profiler::writeStatsJson(options.profileFile)) {
+        std::cerr << "Could not write profile file: " << options.profileFile << std::endl;
+        return 1;
+    }
+    if (!options.traceFile.empty() && !Profiler::writeChromeTrace(options.traceFile)) {
+        std::cerr << "Could not write trace file: " << options.traceFile << std::endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -31,6 +31,35 @@ QString GenerateTimetableDialog::getStartDate() const
     return ui->dateEdit->date().toString("dd-MM-yyyy");
 }
 
+SchedulingMode GenerateTimetableDialog::getSchedulingMode() const
+{
+    return ui->modeComboBox->currentIndex() == 1 ? SchedulingMode::DSatur : SchedulingMode::Sequential;
+}
+
+int GenerateTimetableDialog::getOptimiseSeconds() const
+{
+    return ui->optimiseSpinBox->value();
+}
+
+ExamCalendar GenerateTimetableDialog::getExamCalendar() const
+{
+    ExamCalendar calendar;
+    if (ui->skipWeekendsCheckBox->isChecked()) {
+        calendar.setWeekend(ExamCalendar::kSaturdayAndSunday);
+    }
+    return calendar;
+}
+
+bool GenerateTimetableDialog::getRoomSharing() const
+{
+    return ui->shareRoomsCheckBox->isChecked();
+}
+
+SittingPlan GenerateTimetableDialog::getSittingPlan() const
+{
+    return SittingPlan::standardDay(ui->sittingsComboBox->currentIndex() + 1);
+}
+
 void GenerateTimetableDialog::onAccept()
 {
     QString date = getStartDate();
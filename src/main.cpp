@@ -2,49 +2,45 @@
 #include <QApplication>
 #include <QMessageBox>
 #include <QDebug>
-#include <QFile>
-#include <QDateTime>
+#include "Logger.h"
 
+// Routes Qt messages into the application log; only the writer thread touches debug.log
 void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    static QFile logFile("debug.log");
-    static bool firstTime = true;
-    if (firstTime) {
-        logFile.open(QIODevice::WriteOnly | QIODevice::Text);
-        firstTime = false;
-    } else {
-        logFile.open(QIODevice::Append | QIODevice::Text);
-    }
-
-    QTextStream stream(&logFile);
-    stream << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz ");
-    
+    LogLevel level = LogLevel::Debug;
     switch (type) {
         case QtDebugMsg:
-            stream << "Debug: ";
+            level = LogLevel::Debug;
             break;
         case QtInfoMsg:
-            stream << "Info: ";
+            level = LogLevel::Info;
             break;
         case QtWarningMsg:
-            stream << "Warning: ";
+            level = LogLevel::Warning;
             break;
         case QtCriticalMsg:
-            stream << "Critical: ";
-            break;
         case QtFatalMsg:
-            stream << "Fatal: ";
+            level = LogLevel::Error;
             break;
     }
-    
-    stream << msg << " (" << context.file << ":" << context.line << ")" << Qt::endl;
-    logFile.close();
+
+    if (Log::enabled(level)) {
+        QByteArray text = msg.toUtf8();
+        if (context.file != nullptr) {
+            text += " (" + QByteArray(context.file) + ":" + QByteArray::number(context.line) + ")";
+        }
+        Log::write(level, std::string_view(text.constData(), static_cast<size_t>(text.size())));
+    }
+    if (type == QtFatalMsg) {
+        Log::flush(); // Qt aborts once the handler returns
+    }
 }
 
 int main(int argc, char *argv[])
 {
     try {
         // Install message handler for debug logging
+        Log::openFile("debug.log");
         qInstallMessageHandler(messageHandler);
 
         // Enable high DPI scaling
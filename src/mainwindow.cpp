@@ -3,18 +3,35 @@
 #include "connectdialog.h"
 #include "generatetimetabledialog.h"
 #include "analyticswindow.h"
+#include "statsdialog.h"
+#include "Profiler.h"
+#include "Snapshot.h"
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QInputDialog>
+#include <QProgressDialog>
+#include <QStatusBar>
+#include <QThread>
+#include <QTimer>
+#include <QFontMetrics>
+#include <QHeaderView>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(nullptr)  // Initialize to nullptr first
-    , generator(dbManager)
+    , roomInventory(RoomInventory::standardCampus())
+    , generator(std::make_unique<TimetableGenerator>(dbManager))
+    , generationThread(nullptr)
+    , progressDialog(nullptr)
+    , progressTimer(nullptr)
+    , pendingGenerated(false)
+    , pendingExported(false)
     , isConnected(false)
     , scheduleGenerated(false)
     , scheduleModel(nullptr)  // Initialize to nullptr first
     , analyticsWindow(nullptr)
+    , statsDialog(nullptr)
 {
     try {
         qDebug() << "Creating UI...";
@@ -32,9 +49,22 @@ MainWindow::MainWindow(QWidget *parent)
         
         enableScheduleActions(false);
         
+        // Phase timings are cheap enough to keep on; the stats panel can pause them
+        Profiler::setEnabled(true);
+        
+        // Polls the running generator's progress counters
+        progressTimer = new QTimer(this);
+        progressTimer->setInterval(100);
+        connect(progressTimer, &QTimer::timeout, this, &MainWindow::onGenerationProgress);
+        
         // Set up schedule table view
         ui->scheduleTableView->setModel(scheduleModel);
-        ui->scheduleTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        // Fixed three-line rows and sampled column widths; measuring every cell
+        // does not scale to hundreds of rooms
+        ui->scheduleTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+        ui->scheduleTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        ui->scheduleTableView->verticalHeader()->setDefaultSectionSize(
+            QFontMetrics(ui->scheduleTableView->font()).lineSpacing() * 3 + 8);
         qDebug() << "Table view set up";
         
         setWindowTitle("Timetable Planner");
@@ -57,8 +87,9 @@ void MainWindow::onImportCSV()
 
     if (fileName.isEmpty()) return;
 
-    if (dbManager.importFromCSV(fileName.toStdString())) {
-        scheduleGenerated = false; // Reset schedule status
+    if (dbManager.importFromCSV(fileName.toStdString(), 0)) {
+        // The old schedule's ids index the previous dataset
+        resetGenerator();
         QMessageBox::information(this, "Import Success",
             "Successfully imported data from CSV file! You can now generate a timetable using this data.");
         enableScheduleActions(true);
@@ -69,9 +100,93 @@ void MainWindow::onImportCSV()
     }
 }
 
+void MainWindow::onLoadRooms()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Load Room Inventory", "",
+        "CSV Files (*.csv);;All Files (*)");
+
+    if (fileName.isEmpty()) return;
+
+    // The current schedule keeps its rooms; the inventory applies from the next generation
+    if (roomInventory.loadFromCSV(fileName.toStdString())) {
+        QMessageBox::information(this, "Rooms Loaded",
+            QString("Loaded %1 rooms with %2 to %3 seats. They will be used for the next generated timetable.")
+                .arg(roomInventory.size())
+                .arg(roomInventory.smallestCapacity())
+                .arg(roomInventory.largestCapacity()));
+    } else {
+        QMessageBox::critical(this, "Room Inventory Error",
+            "Failed to load the room inventory! Expected columns: Name, Capacity, Type, Days.");
+    }
+}
+
+void MainWindow::onOpenSnapshot()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Open Snapshot", "",
+        "Timetable Snapshots (*.snap);;All Files (*)");
+
+    if (fileName.isEmpty()) return;
+
+    SnapshotFile snapshot;
+    if (!snapshot.open(fileName.toStdString()) || !dbManager.loadSnapshot(snapshot)) {
+        QMessageBox::critical(this, "Snapshot Error",
+            "Failed to open the snapshot! The file is damaged or was not written by this application.");
+        return;
+    }
+
+    // A saved schedule comes back with the rooms and calendar it was made with
+    resetGenerator();
+    auto restored = std::make_unique<TimetableGenerator>(dbManager);
+    if (snapshot.hasSchedule() && restored->loadSchedule(snapshot)) {
+        generator = std::move(restored);
+        roomInventory = generator->getRoomInventory();
+        if (analyticsWindow) {
+            analyticsWindow->setGenerator(generator.get());
+        }
+        scheduleGenerated = true;
+    }
+    enableScheduleActions(true);
+    if (scheduleGenerated) {
+        updateScheduleView();
+    } else {
+        scheduleModel->clear();
+    }
+    statusBar()->showMessage(QString("Opened %1 in %2 ms").arg(fileName)
+        .arg(dbManager.getLastImportTimings().totalMs, 0, 'f', 1), 5000);
+}
+
+void MainWindow::onSaveSnapshot()
+{
+    if (dbManager.getStore().courses.size() == 0) {
+        QMessageBox::warning(this, "No Data", "Please import data before saving a snapshot!");
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "Save Snapshot", "timetable.snap",
+        "Timetable Snapshots (*.snap);;All Files (*)");
+
+    if (fileName.isEmpty()) return;
+
+    if (writeSnapshot(fileName.toStdString(), dbManager.getStore(), scheduleGenerated ? generator.get() : nullptr)) {
+        statusBar()->showMessage(QString("Snapshot saved to %1").arg(fileName), 5000);
+    } else {
+        QMessageBox::critical(this, "Snapshot Error", "Failed to save the snapshot!");
+    }
+}
+
 MainWindow::~MainWindow()
 {
     try {
+        // Stop a running generation before the data it reads goes away
+        if (generationThread) {
+            pendingGenerator->requestCancel();
+            generationThread->wait();
+            delete generationThread;
+            generationThread = nullptr;
+        }
         if (analyticsWindow) {
             delete analyticsWindow;
             analyticsWindow = nullptr;
@@ -92,14 +207,20 @@ void MainWindow::setupConnections()
     // Connect menu actions
     connect(ui->actionConnect, &QAction::triggered, this, &MainWindow::onConnectDatabase);
     connect(ui->actionImportCSV, &QAction::triggered, this, &MainWindow::onImportCSV);
+    connect(ui->actionLoadRooms, &QAction::triggered, this, &MainWindow::onLoadRooms);
+    connect(ui->actionOpenSnapshot, &QAction::triggered, this, &MainWindow::onOpenSnapshot);
+    connect(ui->actionSaveSnapshot, &QAction::triggered, this, &MainWindow::onSaveSnapshot);
     connect(ui->actionGenerate, &QAction::triggered, this, &MainWindow::onGenerateTimetable);
     connect(ui->actionViewSchedule, &QAction::triggered, this, &MainWindow::onViewSchedule);
     connect(ui->actionExportCSV, &QAction::triggered, this, &MainWindow::onExportCSV);
     connect(ui->actionExportText, &QAction::triggered, this, &MainWindow::onExportText);
     connect(ui->actionExportPDF, &QAction::triggered, this, &MainWindow::onExportPDF);
+    connect(ui->actionExportHallTickets, &QAction::triggered, this, &MainWindow::onExportHallTickets);
     connect(ui->actionShiftCourse, &QAction::triggered, this, &MainWindow::onShiftCourse);
     connect(ui->actionChangeTestDate, &QAction::triggered, this, &MainWindow::onChangeTestDate);
+    connect(ui->actionFindStudent, &QAction::triggered, this, &MainWindow::onFindStudent);
     connect(ui->actionAnalytics, &QAction::triggered, this, &MainWindow::onAnalytics);
+    connect(ui->actionPerformanceStats, &QAction::triggered, this, &MainWindow::onPerformanceStats);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::onAbout);
 }
 
@@ -124,6 +245,9 @@ void MainWindow::onConnectDatabase()
 
 void MainWindow::onGenerateTimetable()
 {
+    if (generationThread) {
+        return; // A run is already in progress
+    }
     if (!isConnected && !dbManager.isDataFromCSV()) {
         QMessageBox::warning(this, "No Data Source",
             "Please connect to the database or import CSV data first!");
@@ -131,31 +255,147 @@ void MainWindow::onGenerateTimetable()
     }
     
     GenerateTimetableDialog dialog(this);
-    if (dialog.exec() == QDialog::Accepted) {
-        QString startDate = dialog.getStartDate();
-        generator.setStartDate(startDate.toStdString());
-        
-        QString dataSource = dbManager.isDataFromCSV() ? "CSV data" : "database";
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    
+    // The current schedule stays viewable and editable while the new one is built
+    pendingGenerator = std::make_unique<TimetableGenerator>(dbManager);
+    pendingGenerator->setStartDate(dialog.getStartDate().toStdString());
+    pendingGenerator->setSchedulingMode(dialog.getSchedulingMode());
+    pendingGenerator->setRoomSharing(dialog.getRoomSharing());
+    pendingGenerator->setSittingPlan(dialog.getSittingPlan());
+    pendingGenerator->setRoomInventory(roomInventory);
+    pendingGenerator->setExamCalendar(dialog.getExamCalendar());
+    pendingSource = dbManager.isDataFromCSV() ? "CSV data" : "database";
+    pendingGenerated = false;
+    pendingExported = false;
+    
+    OptimiserConfig optimiser;
+    optimiser.seconds = dialog.getOptimiseSeconds();
+    
+    TimetableGenerator *worker = pendingGenerator.get();
+    generationThread = QThread::create([this, worker, optimiser]() {
+        pendingGenerated = worker->generate();
+        // Cancelling the optimiser keeps the best schedule it found so far
+        if (pendingGenerated && optimiser.seconds > 0) {
+            worker->optimise(optimiser);
+        }
+        // Auto-export to CSV
+        pendingExported = pendingGenerated && worker->exportToCSV("exam_schedule.csv");
+    });
+    connect(generationThread, &QThread::finished, this, &MainWindow::onGenerationFinished);
+    
+    progressDialog = new QProgressDialog("Preparing...", "Cancel", 0, 100, this);
+    progressDialog->setWindowTitle("Generating Timetable");
+    progressDialog->setWindowModality(Qt::NonModal);
+    progressDialog->setAutoClose(false);
+    progressDialog->setAutoReset(false);
+    progressDialog->setMinimumDuration(0);
+    connect(progressDialog, &QProgressDialog::canceled, this, &MainWindow::onCancelGeneration);
+    progressDialog->show();
+    
+    setGenerationRunning(true);
+    generationThread->start();
+    progressTimer->start();
+}
+
+void MainWindow::onGenerationProgress()
+{
+    if (!pendingGenerator || !progressDialog) {
+        return;
+    }
+    
+    QString label;
+    switch (pendingGenerator->getPhase()) {
+        case GenerationPhase::BuildingConflicts:
+            label = "Building course conflict graph...";
+            break;
+        case GenerationPhase::Scheduling:
+            label = "Scheduling exam sessions...";
+            break;
+        case GenerationPhase::Optimising:
+            label = "Optimising the timetable...";
+            break;
+        case GenerationPhase::Exporting:
+            label = "Saving exam_schedule.csv...";
+            break;
+        case GenerationPhase::Cancelled:
+            label = "Cancelling...";
+            break;
+        case GenerationPhase::Failed:
+            label = "Generation failed.";
+            break;
+        default:
+            label = "Preparing...";
+            break;
+    }
+    if (progressDialog->wasCanceled()) {
+        label = "Cancelling...";
+    }
+    progressDialog->setLabelText(label);
+    progressDialog->setValue(pendingGenerator->getProgressPercent());
+}
+
+void MainWindow::onCancelGeneration()
+{
+    if (pendingGenerator) {
+        pendingGenerator->requestCancel();
+        statusBar()->showMessage("Cancelling timetable generation...");
+    }
+}
+
+void MainWindow::onGenerationFinished()
+{
+    progressTimer->stop();
+    if (progressDialog) {
+        progressDialog->close();
+        progressDialog->deleteLater();
+        progressDialog = nullptr;
+    }
+    generationThread->deleteLater();
+    generationThread = nullptr;
+    setGenerationRunning(false);
+    
+    if (pendingGenerated) {
+        // Swap in the finished schedule
+        generator = std::move(pendingGenerator);
+        if (analyticsWindow) {
+            analyticsWindow->setGenerator(generator.get());
+        }
+        scheduleGenerated = true;
+        updateScheduleView();
+        // Enable view/export actions now that a schedule exists
+        enableScheduleActions(true);
+        statusBar()->clearMessage();
+        QMessageBox::information(this, "Success", 
+            QString("Timetable generated successfully using %1!").arg(pendingSource));
         
-        if (generator.generate()) {
-            scheduleGenerated = true;
-            updateScheduleView();
-            // Enable view/export actions now that a schedule exists
-            enableScheduleActions(true);
-            QMessageBox::information(this, "Success", 
-                QString("Timetable generated successfully using %1!").arg(dataSource));
-            
-            // Auto-export to CSV
-            if (generator.exportToCSV("exam_schedule.csv")) {
-                QMessageBox::information(this, "Export", "Schedule automatically saved to 'exam_schedule.csv'");
-            }
-        } else {
-            QMessageBox::critical(this, "Error", 
-                QString("Failed to generate timetable using %1!").arg(dataSource));
+        if (pendingExported) {
+            QMessageBox::information(this, "Export", "Schedule automatically saved to 'exam_schedule.csv'");
         }
+    } else if (pendingGenerator->getPhase() == GenerationPhase::Cancelled) {
+        pendingGenerator.reset();
+        statusBar()->showMessage("Timetable generation cancelled.", 5000);
+    } else {
+        pendingGenerator.reset();
+        statusBar()->clearMessage();
+        QMessageBox::critical(this, "Error", 
+            QString("Failed to generate timetable using %1!").arg(pendingSource));
     }
 }
 
+void MainWindow::setGenerationRunning(bool running)
+{
+    // The data source must not change under a running generation
+    ui->actionConnect->setEnabled(!running);
+    ui->actionImportCSV->setEnabled(!running);
+    ui->actionLoadRooms->setEnabled(!running);
+    ui->actionOpenSnapshot->setEnabled(!running);
+    ui->actionSaveSnapshot->setEnabled(!running);
+    ui->actionGenerate->setEnabled(!running);
+}
+
 void MainWindow::onViewSchedule()
 {
     if (!scheduleGenerated) {
@@ -176,7 +416,7 @@ void MainWindow::onExportCSV()
         QString(), "CSV Files (*.csv)");
     
     if (!filename.isEmpty()) {
-        if (generator.exportToCSV(filename.toStdString())) {
+        if (generator->exportToCSV(filename.toStdString())) {
             QMessageBox::information(this, "Success", "Schedule exported to CSV successfully!");
         } else {
             QMessageBox::critical(this, "Error", "Failed to export schedule!");
@@ -195,7 +435,7 @@ void MainWindow::onExportText()
         QString(), "Text Files (*.txt)");
     
     if (!filename.isEmpty()) {
-        if (generator.exportToText(filename.toStdString())) {
+        if (generator->exportToText(filename.toStdString())) {
             QMessageBox::information(this, "Success", "Schedule exported to text file successfully!");
         } else {
             QMessageBox::critical(this, "Error", "Failed to export schedule!");
@@ -214,7 +454,7 @@ void MainWindow::onExportPDF()
         QString(), "PDF Files (*.pdf)");
     
     if (!filename.isEmpty()) {
-        if (generator.exportToPDF(filename.toStdString())) {
+        if (generator->exportToPDF(filename.toStdString())) {
             QMessageBox::information(this, "Success", "Schedule exported to PDF successfully!");
         } else {
             QMessageBox::critical(this, "Error", "Failed to export schedule!");
@@ -222,6 +462,42 @@ void MainWindow::onExportPDF()
     }
 }
 
+void MainWindow::onExportHallTickets()
+{
+    if (!scheduleGenerated) {
+        QMessageBox::warning(this, "No Schedule", "Please generate a timetable first!");
+        return;
+    }
+    
+    QMessageBox::StandardButton layout = QMessageBox::question(this, "Export Hall Tickets",
+        "Write one PDF file per student?\n\n"
+        "Yes: one file per roll number in a folder\n"
+        "No: all tickets in a single PDF",
+        QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, QMessageBox::No);
+    if (layout == QMessageBox::Cancel) {
+        return;
+    }
+    
+    const bool perStudent = layout == QMessageBox::Yes;
+    QString path = perStudent
+        ? QFileDialog::getExistingDirectory(this, "Hall Ticket Folder")
+        : QFileDialog::getSaveFileName(this, "Export Hall Tickets", "hall_tickets.pdf", "PDF Files (*.pdf)");
+    if (path.isEmpty()) {
+        return;
+    }
+    
+    HallTicketReport report;
+    if (generator->exportHallTickets(path.toStdString(), perStudent, &report)) {
+        QMessageBox::information(this, "Success",
+            QString("%1 hall tickets exported in %2 s.").arg(report.tickets).arg(report.ms / 1000.0, 0, 'f', 1));
+    } else if (report.failedFiles > 0) {
+        QMessageBox::critical(this, "Error",
+            QString("%1 of %2 hall-ticket files could not be written!").arg(report.failedFiles).arg(report.tickets));
+    } else {
+        QMessageBox::critical(this, "Error", "Failed to export hall tickets!");
+    }
+}
+
 void MainWindow::onShiftCourse()
 {
     if (!scheduleGenerated) {
@@ -241,7 +517,7 @@ void MainWindow::onChangeTestDate()
     }
     
     // Get available courses from the schedule
-    std::vector<std::pair<std::string, std::string>> courses = generator.getCoursesWithDates();
+    std::vector<std::pair<std::string, std::string>> courses = generator->getCoursesWithDates();
     
     if (courses.empty()) {
         QMessageBox::warning(this, "No Courses", "No courses found in the current schedule!");
@@ -292,9 +568,62 @@ void MainWindow::onChangeTestDate()
         return;
     }
     
+    // With several sittings a day, also ask which one; the first entry keeps the current sitting
+    int sitting = TimetableGenerator::kKeepSitting;
+    const SittingPlan &plan = generator->getSittingPlan();
+    if (plan.size() > 1) {
+        QStringList choices("Keep current sitting");
+        for (uint32_t i = 0; i < plan.size(); i++) {
+            choices << QString("%1 (%2)").arg(QString::fromStdString(plan.sitting(i).name))
+                       .arg(QString::fromStdString(plan.timeRange(i)));
+        }
+        QString choice = QInputDialog::getItem(this, "Change Test Sitting",
+            QString("Sitting for %1 on %2:").arg(courseId).arg(newDateStr), choices, 0, false, &ok);
+        if (!ok) {
+            return;
+        }
+        sitting = static_cast<int>(choices.indexOf(choice)) - 1;
+    }
+    
+    // Validate the move against the student and room occupancy indexes first
+    RescheduleReport check = generator->checkCourseDate(courseId.toStdString(), newDateStr.toStdString(), sitting);
+    if (!check.error.empty()) {
+        QMessageBox::critical(this, "Error", QString::fromStdString(check.error));
+        return;
+    }
+    
+    if (check.hasClashes()) {
+        QString details;
+        if (!check.clashingStudents.empty()) {
+            details += QString("%1 student(s) already have an exam in that sitting").arg(check.clashingStudents.size());
+            QStringList sample;
+            for (size_t i = 0; i < check.clashingStudents.size() && i < 10; i++) {
+                sample << QString::fromStdString(check.clashingStudents[i]);
+            }
+            details += QString(":\n%1%2\n").arg(sample.join(", "))
+                       .arg(check.clashingStudents.size() > 10 ? ", ..." : "");
+        }
+        if (!check.occupiedRooms.empty()) {
+            QStringList rooms;
+            for (const auto& room : check.occupiedRooms) {
+                rooms << QString::fromStdString(room);
+            }
+            details += QString("Rooms already booked at that time: %1\n").arg(rooms.join(", "));
+        }
+        
+        QMessageBox::StandardButton answer = QMessageBox::warning(this, "Scheduling Conflicts",
+            QString("Moving %1 to %2 would create conflicts.\n\n%3\nMove it anyway?")
+            .arg(courseId).arg(newDateStr).arg(details),
+            QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if (answer != QMessageBox::Yes) {
+            return;
+        }
+    }
+    
     // Update the course date
-    if (generator.updateCourseDate(courseId.toStdString(), newDateStr.toStdString())) {
-        updateScheduleView();
+    RescheduleReport result = generator->moveCourseDate(courseId.toStdString(), newDateStr.toStdString(), true, sitting);
+    if (result.applied) {
+        scheduleModel->updateCourse(*generator, dbManager.getStore().courses.find(courseId.toStdString()));
         QMessageBox::information(this, "Success", 
             QString("Test date for course %1 has been changed to %2!")
             .arg(courseId)
@@ -304,6 +633,45 @@ void MainWindow::onChangeTestDate()
     }
 }
 
+void MainWindow::onFindStudent()
+{
+    if (!scheduleGenerated) {
+        QMessageBox::warning(this, "No Schedule", "Please generate a timetable first!");
+        return;
+    }
+    
+    bool ok;
+    QString rollNo = QInputDialog::getText(this, "Find Student",
+        "Enter the student's roll number:", QLineEdit::Normal, "", &ok).trimmed();
+    if (!ok || rollNo.isEmpty()) {
+        return;
+    }
+    
+    const StudentTable& students = generator->getStore().students;
+    uint32_t student = students.find(rollNo.toStdString());
+    if (student == kInvalidId) {
+        QMessageBox::warning(this, "Not Found", QString("No student with roll number %1.").arg(rollNo));
+        return;
+    }
+    
+    ArrayView<uint32_t> sessions = generator->studentTimetable(student);
+    QString text = QString("%1 (%2)\n\n")
+                   .arg(QString::fromStdString(students.name(student)))
+                   .arg(rollNo);
+    if (sessions.size() == 0) {
+        text += "No exams scheduled.";
+    }
+    for (uint32_t idx : sessions) {
+        const ScheduleEntry& entry = generator->getEntries()[idx];
+        text += QString("%1 %2 - %3 in %4\n")
+                .arg(QString::fromLatin1(weekdayName(entry.date)))
+                .arg(QString::fromStdString(formatDate(entry.date)))
+                .arg(QString::fromStdString(generator->courseCode(entry)))
+                .arg(QString::fromStdString(generator->roomName(entry.room)));
+    }
+    QMessageBox::information(this, "Student Exams", text);
+}
+
 void MainWindow::onAnalytics()
 {
     if (!analyticsWindow) {
@@ -311,6 +679,8 @@ void MainWindow::onAnalytics()
         analyticsWindow->setAttribute(Qt::WA_DeleteOnClose, false);
     }
     
+    // The generator is replaced after every background run, so hand over the current one
+    analyticsWindow->setGenerator(scheduleGenerated ? generator.get() : nullptr);
     analyticsWindow->refreshAnalytics();
     
     // Show analytics as modal dialog instead of hiding main window
@@ -319,6 +689,18 @@ void MainWindow::onAnalytics()
     }
 }
 
+void MainWindow::onPerformanceStats()
+{
+    // Non-modal, so it can stay open and be refreshed while a generation runs
+    if (!statsDialog) {
+        statsDialog = new StatsDialog(this);
+    }
+    statsDialog->refreshStats();
+    statsDialog->show();
+    statsDialog->raise();
+    statsDialog->activateWindow();
+}
+
 void MainWindow::onAbout()
 {
     QMessageBox::about(this, "About Timetable Planner",
@@ -334,10 +716,33 @@ void MainWindow::onAbout()
 
 void MainWindow::updateScheduleView()
 {
-    // TODO: Update schedule model with current timetable data
-    scheduleModel->setSchedule(generator);
-    ui->scheduleTableView->resizeColumnsToContents();
-    ui->scheduleTableView->resizeRowsToContents();
+    scheduleModel->setSchedule(*generator);
+    resizeScheduleColumns();
+}
+
+void MainWindow::resizeScheduleColumns()
+{
+    // Width from the header and a sample of cells per column instead of every row
+    QFontMetrics metrics(ui->scheduleTableView->font());
+    QHeaderView *header = ui->scheduleTableView->horizontalHeader();
+    for (int column = 0; column < scheduleModel->columnCount(); column++) {
+        int width = metrics.horizontalAdvance(scheduleModel->headerData(column, Qt::Horizontal).toString());
+        for (const QString &text : scheduleModel->sampleColumn(column, 32)) {
+            for (const QString &line : text.split('\n')) {
+                width = std::max(width, metrics.horizontalAdvance(line));
+            }
+        }
+        header->resizeSection(column, width + 16);
+    }
+}
+
+void MainWindow::resetGenerator()
+{
+    scheduleGenerated = false;
+    generator = std::make_unique<TimetableGenerator>(dbManager);
+    if (analyticsWindow) {
+        analyticsWindow->setGenerator(nullptr);
+    }
 }
 
 void MainWindow::enableScheduleActions(bool enable)
@@ -347,7 +752,9 @@ void MainWindow::enableScheduleActions(bool enable)
     ui->actionExportCSV->setEnabled(enable && scheduleGenerated);
     ui->actionExportText->setEnabled(enable && scheduleGenerated);
     ui->actionExportPDF->setEnabled(enable && scheduleGenerated);
+    ui->actionExportHallTickets->setEnabled(enable && scheduleGenerated);
     ui->actionShiftCourse->setEnabled(enable && scheduleGenerated);
     ui->actionChangeTestDate->setEnabled(enable && scheduleGenerated);
+    ui->actionFindStudent->setEnabled(enable && scheduleGenerated);
     ui->actionAnalytics->setEnabled(enable); // Analytics can work with or without generated schedule
 }
\ No newline at end of file
@@ -1,31 +1,26 @@
 #include "scheduletablemodel.h"
-#include <sstream>
-#include <map>
+#include <algorithm>
 
 ScheduleTableModel::ScheduleTableModel(QObject *parent)
     : QAbstractTableModel(parent)
-    , maxDays(15)
-    , maxRooms(16)
+    , firstDate(0)
+    , examSlots(0)
+    , rooms(0)
 {
-    // Initialize empty schedule
-    schedule.resize(maxDays);
-    for (auto &day : schedule) {
-        day.resize(maxRooms);
-    }
 }
 
 int ScheduleTableModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return maxDays;
+    return examSlots;
 }
 
 int ScheduleTableModel::columnCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return maxRooms;
+    return rooms;
 }
 
 QVariant ScheduleTableModel::data(const QModelIndex &index, int role) const
@@ -33,18 +28,50 @@ QVariant ScheduleTableModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    if (role == Qt::DisplayRole) {
-        const ExamSlot &slot = schedule[index.row()][index.column()];
-        if (!slot.courseId.isEmpty()) {
-            return QString("%1\n%2\nStudents: %3")
-                .arg(slot.courseId)
-                .arg(slot.courseName)
-                .arg(slot.students);
-        }
-        return "Empty";
+    int cell = index.row() * rooms + index.column();
+    if (role == Qt::ToolTipRole) {
+        return cells[cell].size() > 1 ? cellToolTip(cells[cell]) : QVariant();
+    }
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    QString &text = displayCache[cell];
+    if (text.isNull()) {
+        text = cellText(cells[cell]);
     }
+    return text;
+}
 
-    return QVariant();
+QString ScheduleTableModel::cellText(const QVector<ExamSlot> &slots) const
+{
+    if (slots.isEmpty()) {
+        return QStringLiteral("Empty");
+    }
+    if (slots.size() == 1) {
+        const ExamSlot &slot = slots.front();
+        return slot.courseId + '\n' + slot.studentRange + "\nStudents: " + QString::number(slot.students);
+    }
+
+    // Shared room: keep the cell three lines high, the tooltip has the details
+    QStringList codes;
+    int students = 0;
+    for (const ExamSlot &slot : slots) {
+        codes << slot.courseId;
+        students += slot.students;
+    }
+    return codes.join(", ") + QString("\n%1 courses\nStudents: %2").arg(slots.size()).arg(students);
+}
+
+QString ScheduleTableModel::cellToolTip(const QVector<ExamSlot> &slots) const
+{
+    QStringList lines;
+    int students = 0;
+    for (const ExamSlot &slot : slots) {
+        lines << QString("%1: %2 seats (%3)").arg(slot.courseId).arg(slot.students).arg(slot.studentRange);
+        students += slot.students;
+    }
+    lines << QString("Total: %1 seats").arg(students);
+    return lines.join('\n');
 }
 
 QVariant ScheduleTableModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -53,101 +80,174 @@ QVariant ScheduleTableModel::headerData(int section, Qt::Orientation orientation
         return QVariant();
 
     if (orientation == Qt::Horizontal) {
-        if (section < 11) {
-            return QString("Room #%1").arg(section + 1);
-        } else {
-            return QString("Lab%1").arg(section - 10);
-        }
+        return roomHeaders.value(section);
+    }
+    return slotHeader(section);
+}
+
+QString ScheduleTableModel::slotHeader(int slot) const
+{
+    if (sittingNames.isEmpty()) {
+        return QString("Day %1\n%2").arg(slot + 1)
+            .arg(QString::fromStdString(formatDate(firstDate + slot)));
+    }
+    const int day = slot / sittingNames.size();
+    return QString("Day %1, %2\n%3").arg(day + 1).arg(sittingNames[slot % sittingNames.size()])
+        .arg(QString::fromStdString(formatDate(firstDate + day)));
+}
+
+void ScheduleTableModel::resizeGrid(const TimetableGenerator &generator, int newSlots, int newRooms)
+{
+    roomHeaders.resize(newRooms);
+    for (int room = 0; room < newRooms; room++) {
+        roomHeaders[room] = QString::fromStdString(generator.roomName(static_cast<uint32_t>(room) + 1));
+    }
+
+    if (newRooms == rooms) {
+        // Row-major: extra slots are appended at the end
+        cells.resize(newSlots * rooms);
+        displayCache.resize(newSlots * rooms);
     } else {
-        return QString("Day %1").arg(section + 1);
+        QVector<QVector<ExamSlot>> grid(newSlots * newRooms);
+        for (int slot = 0; slot < std::min(examSlots, newSlots); slot++) {
+            for (int room = 0; room < std::min(rooms, newRooms); room++) {
+                grid[slot * newRooms + room] = cells[slot * rooms + room];
+            }
+        }
+        cells.swap(grid);
+        displayCache = QVector<QString>(newSlots * newRooms);
+
+        // Cell numbers changed with the row width
+        courseCells.clear();
+        for (int cell = 0; cell < cells.size(); cell++) {
+            for (const ExamSlot &slot : cells[cell]) {
+                courseCells[slot.course].append(cell);
+            }
+        }
     }
+    examSlots = newSlots;
+    rooms = newRooms;
+}
+
+int ScheduleTableModel::placeEntry(const TimetableGenerator &generator, const ScheduleEntry &entry)
+{
+    int cell = (generator.examSlot(entry) - 1) * rooms + static_cast<int>(entry.room) - 1;
+    ExamSlot slot;
+    slot.courseId = QString::fromStdString(generator.courseCode(entry));
+    slot.studentRange = QString::fromStdString(generator.studentRange(entry));
+    slot.students = static_cast<int>(entry.count);
+    slot.course = entry.course;
+    cells[cell].append(slot);
+    displayCache[cell] = QString();
+    courseCells[entry.course].append(cell);
+    return cell;
 }
 
 void ScheduleTableModel::setSchedule(const TimetableGenerator &generator)
 {
     beginResetModel();
-    
-    // Clear current schedule
-    for (auto &day : schedule) {
-        day.fill(ExamSlot());
-    }
-
-    if (generator.isGenerated()) {
-        std::vector<std::string> generatedSchedule = generator.getSchedule();
-        
-        for (const auto& line : generatedSchedule) {
-            if (line.empty()) continue;
-            
-            try {
-                // Parse CSV format: day,dayNum,date,courseId,rollNumbers,room,students
-                std::string str = line;
-                std::string token;
-                std::vector<std::string> tokens;
-                std::stringstream ss(str);
-                
-                // Split the line into tokens
-                while (std::getline(ss, token, ',')) {
-                    tokens.push_back(token);
-                }
-                
-                // Make sure we have all the required fields
-                if (tokens.size() < 7) {
-                    qDebug() << "Invalid line format:" << QString::fromStdString(line);
-                    continue;
-                }
-                
-                // Get day number (tokens[1])
-                int dayNum = std::stoi(tokens[1]) - 1;
-                
-                // Get course ID (tokens[3])
-                std::string courseId = tokens[3];
-                
-                // Get roll numbers (tokens[4])
-                std::string studentRange = tokens[4];
-                
-                // Get room number from "Room#X" or "LabX" format (tokens[5])
-                std::string roomStr = tokens[5];
-                int roomNum = 0;
-                
-                if (roomStr.find("Room#") != std::string::npos) {
-                    roomNum = std::stoi(roomStr.substr(roomStr.find("#") + 1)) - 1;
-                } else if (roomStr.find("Lab") != std::string::npos) {
-                    // Map Lab1-Lab5 to positions 11-15 (since Room#1-Room#11 use 0-10)
-                    roomNum = std::stoi(roomStr.substr(3)) + 10; // Lab1 -> 11, Lab2 -> 12, etc.
-                } else {
-                    qDebug() << "Unknown room format:" << QString::fromStdString(roomStr);
-                    continue;
-                }
-                
-                // Get number of students from "X/Y" format (tokens[6])
-                std::string capacity = tokens[6];
-                int numStudents = std::stoi(capacity.substr(0, capacity.find("/")));
-                
-                if (dayNum < maxDays && roomNum < maxRooms) {
-                    ExamSlot slot;
-                    slot.courseId = QString::fromStdString(courseId);
-                    slot.courseName = QString::fromStdString(studentRange);
-                    slot.students = numStudents;
-                    schedule[dayNum][roomNum] = slot;
-                }
-            } catch (const std::exception& e) {
-                qDebug() << "Error parsing schedule line:" << QString::fromStdString(line) << "\nError:" << e.what();
-                continue;
+
+    cells.clear();
+    displayCache.clear();
+    courseCells.clear();
+    roomHeaders.clear();
+    sittingNames.clear();
+    examSlots = 0;
+    rooms = 0;
+
+    if (generator.isGenerated() && !generator.getEntries().empty()) {
+        const std::vector<ScheduleEntry> &entries = generator.getEntries();
+        int newSlots = 0;
+        int newRooms = 0;
+        for (const ScheduleEntry &entry : entries) {
+            newSlots = std::max(newSlots, generator.examSlot(entry));
+            newRooms = std::max(newRooms, static_cast<int>(entry.room));
+        }
+        const SittingPlan &plan = generator.getSittingPlan();
+        if (plan.size() > 1) {
+            for (const Sitting &sitting : plan.getSittings()) {
+                sittingNames.append(QString::fromStdString(sitting.name));
             }
         }
+        firstDate = entries.front().date - (entries.front().dayIndex - 1);
+        resizeGrid(generator, newSlots, newRooms);
+        for (const ScheduleEntry &entry : entries) {
+            placeEntry(generator, entry);
+        }
     }
 
     endResetModel();
 }
 
+void ScheduleTableModel::updateCourse(const TimetableGenerator &generator, uint32_t course)
+{
+    const std::vector<ScheduleEntry> &entries = generator.getEntries();
+    ArrayView<uint32_t> sessions = generator.courseEntries(course);
+
+    // Grow the grid first if the course moved past the last slot or room
+    int newSlots = examSlots;
+    int newRooms = rooms;
+    for (uint32_t idx : sessions) {
+        newSlots = std::max(newSlots, generator.examSlot(entries[idx]));
+        newRooms = std::max(newRooms, static_cast<int>(entries[idx].room));
+    }
+    if (examSlots == 0 && !sessions.empty()) {
+        firstDate = entries[sessions[0]].date - (entries[sessions[0]].dayIndex - 1);
+    }
+    if (newRooms > rooms) {
+        beginInsertColumns(QModelIndex(), rooms, newRooms - 1);
+        resizeGrid(generator, examSlots, newRooms);
+        endInsertColumns();
+    }
+    if (newSlots > examSlots) {
+        beginInsertRows(QModelIndex(), examSlots, newSlots - 1);
+        resizeGrid(generator, newSlots, rooms);
+        endInsertRows();
+    }
+
+    // Vacate the cells the course held, then place its sessions again
+    QVector<int> changed = courseCells.take(course);
+    for (int cell : changed) {
+        QVector<ExamSlot> &slots = cells[cell];
+        slots.erase(std::remove_if(slots.begin(), slots.end(),
+                                   [course](const ExamSlot &slot) { return slot.course == course; }),
+                    slots.end());
+        displayCache[cell] = QString();
+    }
+    for (uint32_t idx : sessions) {
+        changed.append(placeEntry(generator, entries[idx]));
+    }
+
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    for (int cell : changed) {
+        QModelIndex changedIndex = index(cell / rooms, cell % rooms);
+        emit dataChanged(changedIndex, changedIndex, {Qt::DisplayRole, Qt::ToolTipRole});
+    }
+}
+
 void ScheduleTableModel::clear()
 {
     beginResetModel();
-    
-    // Clear current schedule
-    for (auto &day : schedule) {
-        day.fill(ExamSlot());
-    }
-    
+    cells.clear();
+    displayCache.clear();
+    courseCells.clear();
+    roomHeaders.clear();
+    sittingNames.clear();
+    examSlots = 0;
+    rooms = 0;
     endResetModel();
-}
\ No newline at end of file
+}
+
+QStringList ScheduleTableModel::sampleColumn(int column, int samples) const
+{
+    QStringList texts;
+    if (column < 0 || column >= rooms || examSlots == 0 || samples <= 0)
+        return texts;
+
+    int step = std::max(1, examSlots / samples);
+    for (int slot = 0; slot < examSlots; slot += step) {
+        texts << data(index(slot, column)).toString();
+    }
+    return texts;
+}
@@ -0,0 +1,101 @@
+#include "statsdialog.h"
+#include "ui_statsdialog.h"
+#include "Profiler.h"
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidgetItem>
+
+StatsDialog::StatsDialog(QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::StatsDialog)
+{
+    ui->setupUi(this);
+    setWindowTitle("Performance Stats");
+    ui->statsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    ui->statsTable->verticalHeader()->setVisible(false);
+    ui->recordCheckBox->setChecked(Profiler::enabled());
+
+    connect(ui->recordCheckBox, &QCheckBox::toggled, this, &StatsDialog::onRecordToggled);
+    connect(ui->refreshButton, &QPushButton::clicked, this, &StatsDialog::refreshStats);
+    connect(ui->resetButton, &QPushButton::clicked, this, &StatsDialog::onReset);
+    connect(ui->exportJsonButton, &QPushButton::clicked, this, &StatsDialog::onExportJson);
+    connect(ui->exportTraceButton, &QPushButton::clicked, this, &StatsDialog::onExportTrace);
+    connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &StatsDialog::reject);
+}
+
+StatsDialog::~StatsDialog()
+{
+    delete ui;
+}
+
+void StatsDialog::refreshStats()
+{
+    const std::vector<ProfileStat> stats = Profiler::stats();
+
+    // Numbers are stored as numbers so the columns sort numerically
+    auto number = [](double value) {
+        QTableWidgetItem *item = new QTableWidgetItem;
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+
+    ui->statsTable->setSortingEnabled(false);
+    ui->statsTable->setRowCount(static_cast<int>(stats.size()));
+    for (int row = 0; row < static_cast<int>(stats.size()); row++) {
+        const ProfileStat &stat = stats[row];
+        ui->statsTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(stat.name)));
+        ui->statsTable->setItem(row, 1, number(static_cast<double>(stat.calls)));
+        if (stat.kind == ProfileKind::Timer) {
+            ui->statsTable->setItem(row, 2, number(stat.totalMs));
+            ui->statsTable->setItem(row, 3, number(stat.minMs));
+            ui->statsTable->setItem(row, 4, number(stat.maxMs));
+            ui->statsTable->setItem(row, 5, new QTableWidgetItem);
+        } else {
+            for (int column = 2; column <= 4; column++) {
+                ui->statsTable->setItem(row, column, new QTableWidgetItem);
+            }
+            ui->statsTable->setItem(row, 5, number(static_cast<double>(stat.value)));
+        }
+    }
+    ui->statsTable->setSortingEnabled(true);
+}
+
+void StatsDialog::onRecordToggled(bool checked)
+{
+    Profiler::setEnabled(checked);
+}
+
+void StatsDialog::onReset()
+{
+    Profiler::reset();
+    refreshStats();
+}
+
+void StatsDialog::onExportJson()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "Export Stats", "timetable_stats.json",
+        "JSON Files (*.json);;All Files (*)");
+
+    if (fileName.isEmpty()) return;
+
+    if (!Profiler::writeStatsJson(fileName.toStdString())) {
+        QMessageBox::critical(this, "Export Error", "Failed to write the stats file!");
+    }
+}
+
+void StatsDialog::onExportTrace()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "Export Trace", "timetable_trace.json",
+        "Chrome Trace Files (*.json);;All Files (*)");
+
+    if (fileName.isEmpty()) return;
+
+    if (!Profiler::writeChromeTrace(fileName.toStdString())) {
+        QMessageBox::critical(this, "Export Error", "Failed to write the trace file!");
+    }
+}
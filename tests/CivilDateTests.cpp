@@ -0,0 +1,95 @@
+#include "TestHarness.h"
+#include "../include/CivilDate.h"
+
+namespace {
+
+int32_t date(const char* text) {
+    int32_t days = 0;
+    CHECK(parseDate(text, days));
+    return days;
+}
+
+} // namespace
+
+TEST_CASE(dates, dayNumbersRoundTrip) {
+    CHECK_EQ(daysFromCivil(1970, 1, 1), 0);
+    CHECK_EQ(daysFromCivil(1969, 12, 31), -1);
+    for (int32_t days = -800000; days <= 800000; days += 37) {
+        const CivilDate civil = civilFromDays(days);
+        CHECK(civil.month >= 1 && civil.month <= 12);
+        CHECK(civil.day >= 1 && civil.day <= daysInMonth(civil.year, civil.month));
+        CHECK_EQ(daysFromCivil(civil.year, civil.month, civil.day), days);
+    }
+}
+
+TEST_CASE(dates, parseAndFormat) {
+    CHECK_EQ(formatDate(date("01-12-2025")), "01-12-2025");
+    CHECK_EQ(formatDate(date("29-02-2024")), "29-02-2024");
+    CHECK_EQ(formatDate(0), "01-01-1970");
+
+    int32_t days = 0;
+    CHECK(!parseDate("29-02-2023", days));
+    CHECK(!parseDate("29-02-1900", days));
+    CHECK(parseDate("29-02-2000", days));
+    CHECK(!parseDate("31-04-2025", days));
+    CHECK(!parseDate("00-01-2025", days));
+    CHECK(!parseDate("01-13-2025", days));
+    CHECK(!parseDate("1-12-2025", days));
+    CHECK(!parseDate("01/12/2025", days));
+    CHECK(!parseDate("01-12-20x5", days));
+}
+
+TEST_CASE(dates, arithmeticAcrossMonthAndYearEnds) {
+    CHECK_EQ(date("31-12-2025") + 1, date("01-01-2026"));
+    CHECK_EQ(date("28-02-2024") + 2, date("01-03-2024"));
+    CHECK_EQ(date("28-02-2025") + 1, date("01-03-2025"));
+    CHECK_EQ(date("01-01-2026") - date("01-01-2025"), 365);
+    CHECK_EQ(date("01-01-2025") - date("01-01-2024"), 366);
+    CHECK_EQ(std::string(weekdayName(date("01-12-2025"))), "Monday");
+    CHECK_EQ(std::string(weekdayName(date("01-01-1970"))), "Thursday");
+    CHECK_EQ(weekdayFromDays(-1), 2); // Wednesday
+}
+
+TEST_CASE(dates, timesOfDay) {
+    int32_t minutes = 0;
+    CHECK(parseTime("09:30", minutes));
+    CHECK_EQ(minutes, 570);
+    CHECK(parseTime(" 8:05 ", minutes));
+    CHECK_EQ(minutes, 485);
+    CHECK(!parseTime("24:00", minutes));
+    CHECK(!parseTime("12:60", minutes));
+    CHECK(!parseTime("9:5", minutes));
+    CHECK_EQ(formatTime(14 * 60), "2:00 PM");
+    CHECK_EQ(formatTime(0), "12:00 AM");
+    CHECK_EQ(formatTime(12 * 60 + 5), "12:05 PM");
+    CHECK_EQ(formatTime(25 * 60), "1:00 AM");
+}
+
+TEST_CASE(dates, weekdaySets) {
+    uint8_t mask = 0;
+    CHECK(parseWeekdays("Sat;Sun", mask));
+    CHECK_EQ(int(mask), int(ExamCalendar::kSaturdayAndSunday));
+    CHECK(parseWeekdays("sat-mon", mask));
+    CHECK_EQ(int(mask), 0x61);
+    CHECK(parseWeekdays("All", mask));
+    CHECK_EQ(int(mask), 0x7F);
+    CHECK(!parseWeekdays("Funday", mask));
+}
+
+TEST_CASE(dates, examCalendarSkipsWeekendsAndHolidays) {
+    ExamCalendar calendar;
+    calendar.setWeekend(ExamCalendar::kSaturdayAndSunday);
+    calendar.addHoliday(date("25-12-2025"));
+    calendar.addHoliday(date("01-01-2025")); // Grows the bitmap downwards
+    calendar.addHoliday(date("25-12-2025"));
+    CHECK_EQ(calendar.holidayCount(), 2u);
+    CHECK(calendar.isHoliday(date("01-01-2025")));
+    CHECK(!calendar.isHoliday(date("02-01-2025")));
+
+    CHECK_EQ(calendar.nextExamDay(date("20-12-2025")), date("22-12-2025")); // Saturday -> Monday
+    std::vector<int32_t> days = calendar.examDays(date("24-12-2025"), 3);
+    CHECK_EQ(days.size(), 3u);
+    CHECK_EQ(formatDate(days[0]), "24-12-2025");
+    CHECK_EQ(formatDate(days[1]), "26-12-2025");
+    CHECK_EQ(formatDate(days[2]), "29-12-2025");
+}
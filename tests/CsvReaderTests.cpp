@@ -0,0 +1,181 @@
+#include "TestHarness.h"
+#include "../include/CsvReader.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+using Records = std::vector<std::vector<std::string>>;
+
+Records readAll(const char* begin, const char* end) {
+    Records records;
+    CsvReader reader(begin, end);
+    std::vector<CsvField> fields;
+    std::string scratch;
+    while (reader.nextRecord(fields)) {
+        std::vector<std::string> record;
+        for (const CsvField& field : fields) {
+            record.emplace_back(field.value(scratch));
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+Records readAll(const std::string& text) {
+    return readAll(text.data(), text.data() + text.size());
+}
+
+// Records with quoted fields holding delimiters, escaped quotes and line breaks,
+// long enough that the SIMD kernels scan whole blocks
+std::string quotedRecords(size_t count) {
+    std::string text;
+    for (size_t i = 0; i < count; i++) {
+        const std::string n = std::to_string(i);
+        text += "Student " + n + ",CT-" + n + ",\"Batch, \"\"" + n + "\"\"\",\"Program\nspanning\r\nlines " + n +
+                "\",CS" + n + "," + std::string(40 + i % 7, 'x') + "\n";
+    }
+    return text;
+}
+
+} // namespace
+
+TEST_CASE(csv, plainRecords) {
+    Records records = readAll("a,b,c\n1,2,3\n");
+    CHECK_EQ(records.size(), 2u);
+    CHECK(records[0] == (std::vector<std::string>{"a", "b", "c"}));
+    CHECK(records[1] == (std::vector<std::string>{"1", "2", "3"}));
+    CHECK(readAll("").empty());
+}
+
+TEST_CASE(csv, quotedFieldsKeepDelimitersAndLineBreaks) {
+    Records records = readAll("\"x,y\",\"line 1\nline 2\",z\nnext\n");
+    CHECK_EQ(records.size(), 2u);
+    CHECK(records[0] == (std::vector<std::string>{"x,y", "line 1\nline 2", "z"}));
+    CHECK(records[1] == (std::vector<std::string>{"next"}));
+}
+
+TEST_CASE(csv, doubledQuotesCollapse) {
+    const std::string text = "\"say \"\"hi\"\"\",\"\"\"\"\n";
+    CsvReader reader(text.data(), text.data() + text.size());
+    std::vector<CsvField> fields;
+    std::string scratch;
+    CHECK(reader.nextRecord(fields));
+    CHECK_EQ(fields.size(), 2u);
+    CHECK(fields[0].escaped);
+    CHECK_EQ(fields[0].value(scratch), "say \"hi\"");
+    CHECK_EQ(fields[1].value(scratch), "\"");
+    CHECK(!reader.nextRecord(fields));
+}
+
+TEST_CASE(csv, unquotedFieldKeepsQuotesLiterally) {
+    Records records = readAll("5\" floppy,b\n");
+    CHECK(records[0] == (std::vector<std::string>{"5\" floppy", "b"}));
+}
+
+TEST_CASE(csv, byteOrderMarkIsSkipped) {
+    Records records = readAll("\xEF\xBB\xBFName,Roll\nAli,CT-1\n");
+    CHECK_EQ(records.size(), 2u);
+    CHECK_EQ(records[0][0], "Name");
+}
+
+TEST_CASE(csv, lineBreaksCrLfLfAndCr) {
+    Records records = readAll("a,b\r\nc,d\ne,f\rg,h");
+    CHECK_EQ(records.size(), 4u);
+    CHECK(records[0] == (std::vector<std::string>{"a", "b"}));
+    CHECK(records[1] == (std::vector<std::string>{"c", "d"}));
+    CHECK(records[2] == (std::vector<std::string>{"e", "f"}));
+    CHECK(records[3] == (std::vector<std::string>{"g", "h"}));
+
+    const std::string text = "\"quoted\"\r\nnext\r\n";
+    CsvReader reader(text.data(), text.data() + text.size());
+    std::vector<CsvField> fields;
+    CHECK(reader.nextRecord(fields));
+    CHECK_EQ(reader.recordText(), "\"quoted\"");
+    CHECK(reader.nextRecord(fields));
+    CHECK_EQ(reader.recordText(), "next");
+    CHECK(!reader.nextRecord(fields));
+}
+
+TEST_CASE(csv, trailingDelimiterYieldsEmptyField) {
+    CHECK(readAll("a,\n") == (Records{{"a", ""}}));
+    CHECK(readAll("a,") == (Records{{"a", ""}}));
+    CHECK(readAll(",,\n") == (Records{{"", "", ""}}));
+}
+
+TEST_CASE(csv, longQuotedRecords) {
+    Records records = readAll(quotedRecords(50));
+    CHECK_EQ(records.size(), 50u);
+    CHECK_EQ(records[7].size(), 6u);
+    CHECK_EQ(records[7][2], "Batch, \"7\"");
+    CHECK_EQ(records[7][3], "Program\nspanning\r\nlines 7");
+    CHECK_EQ(records[5][5], std::string(45, 'x'));
+}
+
+TEST_CASE(csv, trimAndCaseHelpers) {
+    CHECK_EQ(trim("  Lab \t\r\n"), "Lab");
+    CHECK_EQ(trim(" \t "), "");
+    CHECK(equalsIgnoreCase("HALL", "hall"));
+    CHECK(!equalsIgnoreCase("hall", "halls"));
+}
+
+TEST_CASE(split, boundsStartRecords) {
+    const std::string text = quotedRecords(400);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    for (size_t parts : {size_t(1), size_t(2), size_t(7), size_t(64)}) {
+        std::vector<const char*> bounds = splitAtRecords(begin, end, parts, 4);
+        CHECK(bounds.size() >= 2);
+        CHECK(bounds.size() <= parts + 1);
+        CHECK(bounds.front() == begin);
+        CHECK(bounds.back() == end);
+        for (size_t i = 1; i < bounds.size(); i++) {
+            CHECK(bounds[i] > bounds[i - 1]);
+            if (i + 1 < bounds.size()) {
+                CHECK(bounds[i][-1] == '\n');
+            }
+        }
+    }
+}
+
+TEST_CASE(split, quotedLineBreaksNeverSplitARecord) {
+    // Every slice must parse to the same records as the whole buffer; a bound
+    // inside a quoted field would cut a record in two
+    const std::string text = quotedRecords(400);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const Records whole = readAll(begin, end);
+    for (size_t parts : {size_t(3), size_t(16), size_t(97)}) {
+        std::vector<const char*> bounds = splitAtRecords(begin, end, parts, 4);
+        Records joined;
+        for (size_t i = 0; i + 1 < bounds.size(); i++) {
+            Records slice = readAll(bounds[i], bounds[i + 1]);
+            joined.insert(joined.end(), slice.begin(), slice.end());
+        }
+        CHECK_EQ(joined.size(), whole.size());
+        CHECK(joined == whole);
+    }
+}
+
+TEST_CASE(split, oddQuoteCountBeforeASliceStart) {
+    // Slice starts that land after one quote of a field must skip to the end of
+    // that field before looking for a line break
+    std::string text;
+    for (int i = 0; i < 30; i++) {
+        text += "\"" + std::string(20, '\n') + "\"\n";
+    }
+    std::vector<const char*> bounds = splitAtRecords(text.data(), text.data() + text.size(), 40, 2);
+    for (size_t i = 1; i + 1 < bounds.size(); i++) {
+        CHECK(bounds[i][0] == '"');
+        CHECK(bounds[i][-2] == '"');
+    }
+    CHECK_EQ(bounds.size(), 31u);
+}
+
+TEST_CASE(split, inputSmallerThanParts) {
+    const std::string text = "a\nb\n";
+    std::vector<const char*> bounds = splitAtRecords(text.data(), text.data() + text.size(), 16, 4);
+    CHECK(bounds.front() == text.data());
+    CHECK(bounds.back() == text.data() + text.size());
+    CHECK(bounds.size() <= 3);
+}
@@ -0,0 +1,130 @@
+#include "TestHarness.h"
+#include "../include/LinkedList.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+std::vector<T> toVector(const LinkedList<T>& list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+LinkedList<int> listOf(const std::vector<int>& values) {
+    LinkedList<int> list;
+    for (int value : values) {
+        list.insertAtEnd(value);
+    }
+    return list;
+}
+
+} // namespace
+
+TEST_CASE(linkedlist, insertEmplaceAndIterate) {
+    LinkedList<std::string> list;
+    CHECK(list.isEmpty());
+    CHECK(list.begin() == list.end());
+    list.insertAtEnd("a");
+    list.emplace(3, 'b');
+    CHECK_EQ(list.getSize(), 2);
+    CHECK(toVector(list) == (std::vector<std::string>{"a", "bbb"}));
+    CHECK_EQ(list.getHead()->data, "a");
+
+    // Enough nodes to span several pool chunks
+    LinkedList<int> numbers;
+    for (int i = 0; i < 5000; i++) {
+        numbers.insertAtEnd(i);
+    }
+    CHECK_EQ(numbers.getSize(), 5000);
+    CHECK_EQ(std::accumulate(numbers.begin(), numbers.end(), 0LL), 5000LL * 4999 / 2);
+    CHECK(std::find(numbers.begin(), numbers.end(), 4321) != numbers.end());
+
+    numbers.clear();
+    CHECK(numbers.isEmpty());
+    CHECK(numbers.getHead() == nullptr);
+    numbers.insertAtEnd(7);
+    CHECK(toVector(numbers) == (std::vector<int>{7}));
+}
+
+TEST_CASE(linkedlist, copyIsDeep) {
+    LinkedList<int> original = listOf({3, 1, 2});
+    LinkedList<int> copy(original);
+    CHECK(toVector(copy) == toVector(original));
+    CHECK(copy.getHead() != original.getHead());
+
+    *copy.begin() = 99;
+    copy.insertAtEnd(4);
+    CHECK(toVector(original) == (std::vector<int>{3, 1, 2}));
+    CHECK(toVector(copy) == (std::vector<int>{99, 1, 2, 4}));
+
+    LinkedList<int> assigned = listOf({8, 9});
+    assigned = original;
+    CHECK(toVector(assigned) == (std::vector<int>{3, 1, 2}));
+    assigned.insertAtEnd(5); // The tail must belong to the new nodes
+    CHECK_EQ(assigned.getSize(), 4);
+    CHECK_EQ(original.getSize(), 3);
+
+    LinkedList<int>& self = assigned;
+    assigned = self;
+    CHECK(toVector(assigned) == (std::vector<int>{3, 1, 2, 5}));
+}
+
+TEST_CASE(linkedlist, moveTransfersNodes) {
+    LinkedList<int> source = listOf({1, 2, 3});
+    const Node<int>* head = source.getHead();
+    LinkedList<int> moved(std::move(source));
+    CHECK(moved.getHead() == head);
+    CHECK_EQ(moved.getSize(), 3);
+    CHECK(source.isEmpty());
+    CHECK(source.getHead() == nullptr);
+
+    // A moved-from list is usable again and independent of the new owner
+    source.insertAtEnd(10);
+    moved.insertAtEnd(4);
+    CHECK(toVector(source) == (std::vector<int>{10}));
+    CHECK(toVector(moved) == (std::vector<int>{1, 2, 3, 4}));
+
+    LinkedList<int> target = listOf({7, 7});
+    target = std::move(moved);
+    CHECK(toVector(target) == (std::vector<int>{1, 2, 3, 4}));
+    CHECK(moved.isEmpty());
+}
+
+TEST_CASE(linkedlist, quickSortOrdersValues) {
+    LinkedList<int> empty;
+    empty.quickSort();
+    CHECK(empty.isEmpty());
+
+    std::vector<int> values;
+    unsigned state = 12345;
+    for (int i = 0; i < 3000; i++) {
+        state = state * 1103515245u + 12345u;
+        values.push_back(static_cast<int>((state >> 16) % 200)); // Many duplicates
+    }
+    LinkedList<int> list = listOf(values);
+    list.quickSort();
+    std::sort(values.begin(), values.end());
+    CHECK(toVector(list) == values);
+    CHECK_EQ(list.getSize(), 3000);
+
+    LinkedList<int> descending;
+    for (int i = 1000; i > 0; i--) {
+        descending.insertAtEnd(i);
+    }
+    descending.quickSort();
+    std::vector<int> sorted = toVector(descending);
+    CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+    CHECK_EQ(sorted.front(), 1);
+    CHECK_EQ(sorted.back(), 1000);
+
+    LinkedList<std::string> names;
+    for (const char* name : {"Saad", "Ayan", "Maaz", "David", "Ayan"}) {
+        names.insertAtEnd(name);
+    }
+    names.quickSort();
+    CHECK(toVector(names) == (std::vector<std::string>{"Ayan", "Ayan", "David", "Maaz", "Saad"}));
+    names.insertAtEnd("Zed"); // The tail is still the last node after sorting
+    CHECK_EQ(toVector(names).back(), "Zed");
+}
@@ -0,0 +1,252 @@
+#include "TestHarness.h"
+#include "../include/DatabaseManager.h"
+#include "../include/Snapshot.h"
+#include "../include/TimetableGenerator.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kSnapshot = "snapshot_test.snap";
+const char* const kDamaged = "snapshot_test_damaged.snap";
+
+std::string readFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& filename, const std::string& bytes) {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Section table entry of a section in the raw file bytes
+SnapshotSectionEntry sectionEntry(const std::string& bytes, SnapshotSection id) {
+    SnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    for (uint32_t i = 0; i < header.sectionCount; i++) {
+        SnapshotSectionEntry entry;
+        std::memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.id == static_cast<uint32_t>(id)) {
+            return entry;
+        }
+    }
+    SnapshotSectionEntry missing{};
+    CHECK(false);
+    return missing;
+}
+
+void checkSameStore(const EntityStore& a, const EntityStore& b) {
+    CHECK_EQ(a.courses.size(), b.courses.size());
+    CHECK_EQ(a.students.size(), b.students.size());
+    CHECK_EQ(a.enrollments.size(), b.enrollments.size());
+    if (a.courses.size() != b.courses.size() || a.students.size() != b.students.size() ||
+        a.enrollments.size() != b.enrollments.size()) {
+        return;
+    }
+    for (uint32_t c = 0; c < a.courses.size(); c++) {
+        CHECK_EQ(a.courses.id(c), b.courses.id(c));
+        CHECK_EQ(a.courses.name(c), b.courses.name(c));
+        CHECK_EQ(a.courses.department(c), b.courses.department(c));
+        CHECK_EQ(b.courses.find(a.courses.id(c)), c);
+    }
+    for (uint32_t s = 0; s < a.students.size(); s++) {
+        CHECK_EQ(a.students.rollNo(s), b.students.rollNo(s));
+        CHECK_EQ(a.students.name(s), b.students.name(s));
+        CHECK_EQ(a.students.semester(s), b.students.semester(s));
+        CHECK_EQ(a.students.batch(s), b.students.batch(s));
+        CHECK_EQ(a.students.program(s), b.students.program(s));
+        CHECK_EQ(b.students.find(a.students.rollNo(s)), s);
+    }
+    for (size_t e = 0; e < a.enrollments.size(); e++) {
+        CHECK_EQ(a.enrollments.student(e), b.enrollments.student(e));
+        CHECK_EQ(a.enrollments.course(e), b.enrollments.course(e));
+    }
+}
+
+// Writes the mock dataset with a generated schedule to kSnapshot
+bool writeMockSnapshot() {
+    DatabaseManager db;
+    db.connect("", "", "");
+    TimetableGenerator generator(db);
+    generator.setStartDate("01-12-2025");
+    return generator.generate() && writeSnapshot(kSnapshot, db.getStore(), &generator);
+}
+
+} // namespace
+
+TEST_CASE(snapshot, datasetAndScheduleRoundTrip) {
+    DatabaseManager db;
+    db.connect("", "", "");
+    TimetableGenerator generator(db);
+    generator.setStartDate("01-12-2025");
+    CHECK(generator.generate());
+    CHECK(writeSnapshot(kSnapshot, db.getStore(), &generator));
+
+    SnapshotFile snapshot;
+    CHECK(snapshot.open(kSnapshot));
+    CHECK(snapshot.hasSchedule());
+    DatabaseManager loaded;
+    CHECK(loaded.loadSnapshot(snapshot));
+    checkSameStore(db.getStore(), loaded.getStore());
+    CHECK_EQ(loaded.getIndex().enrollmentCount(0), db.getIndex().enrollmentCount(0));
+
+    TimetableGenerator restored(loaded);
+    CHECK(restored.loadSchedule(snapshot));
+    CHECK(restored.getSchedule() == generator.getSchedule());
+    CHECK_EQ(restored.getStartDay(), generator.getStartDay());
+    snapshot.close();
+    std::remove(kSnapshot);
+}
+
+TEST_CASE(snapshot, importedTextSurvivesRoundTrip) {
+    const char* const csv = "snapshot_test.csv";
+    writeFile(csv, "Name,Roll,Batch,Program,Course1,Name1,Course2,Name2\n"
+                   "\"Khan, Imran\",CT-1,2024,BSCS,ML101,\"Machine \"\"Learning\"\"\",DB301,Databases\n"
+                   "Ayan,CT-2,2023,\"BS\nIT\",DB301,Databases,,\n");
+    DatabaseManager db;
+    CHECK(db.importFromCSV(csv));
+    CHECK_EQ(db.getStore().students.name(0), "Khan, Imran");
+    CHECK(writeSnapshot(kSnapshot, db.getStore(), nullptr));
+
+    SnapshotFile snapshot;
+    CHECK(snapshot.open(kSnapshot));
+    CHECK(!snapshot.hasSchedule());
+    DatabaseManager loaded;
+    CHECK(loaded.loadSnapshot(snapshot));
+    checkSameStore(db.getStore(), loaded.getStore());
+    CHECK_EQ(loaded.getStore().courses.name(0), "Machine \"Learning\"");
+    CHECK_EQ(loaded.getStore().students.program(1), "BS\nIT");
+    snapshot.close();
+    std::remove(kSnapshot);
+    std::remove(csv);
+}
+
+TEST_CASE(snapshot, versionOneSchedulesStillLoad) {
+    DatabaseManager db;
+    db.connect("", "", "");
+    TimetableGenerator generator(db);
+    generator.setStartDate("01-12-2025");
+    CHECK(generator.generate());
+    CHECK(writeSnapshot(kSnapshot, db.getStore(), &generator));
+    std::string bytes = readFile(kSnapshot);
+    SnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    CHECK_EQ(header.version, kSnapshotVersion);
+
+    // Rewrite the file as version 1: entries without sitting and duration, no sittings
+    SnapshotSectionEntry* table = reinterpret_cast<SnapshotSectionEntry*>(&bytes[sizeof(header)]);
+    for (uint32_t i = 0; i < header.sectionCount; i++) {
+        SnapshotSectionEntry& entry = table[i];
+        if (entry.id == static_cast<uint32_t>(SnapshotSection::Sittings)) {
+            entry.id = 0;
+        } else if (entry.id == static_cast<uint32_t>(SnapshotSection::ScheduleEntries)) {
+            const size_t count = entry.bytes / sizeof(ScheduleEntry);
+            std::vector<SnapshotEntryV1> old(count);
+            for (size_t e = 0; e < count; e++) {
+                ScheduleEntry current;
+                std::memcpy(&current, &bytes[entry.offset + e * sizeof(current)], sizeof(current));
+                old[e] = SnapshotEntryV1{current.dayIndex, current.date, current.course, current.room,
+                                         current.firstStudent, current.count};
+            }
+            std::memcpy(&bytes[entry.offset], old.data(), count * sizeof(SnapshotEntryV1));
+            entry.elementSize = sizeof(SnapshotEntryV1);
+            entry.bytes = count * sizeof(SnapshotEntryV1);
+            entry.checksum = snapshotChecksum(&bytes[entry.offset], entry.bytes);
+        }
+    }
+    header.version = 1;
+    header.checksum = snapshotHeaderChecksum(header, table);
+    std::memcpy(&bytes[0], &header, sizeof(header));
+    writeFile(kDamaged, bytes);
+
+    SnapshotFile snapshot;
+    CHECK(snapshot.open(kDamaged));
+    CHECK_EQ(snapshot.getVersion(), 1u);
+    DatabaseManager loaded;
+    CHECK(loaded.loadSnapshot(snapshot));
+    TimetableGenerator restored(loaded);
+    CHECK(restored.loadSchedule(snapshot));
+    CHECK(restored.getSchedule() == generator.getSchedule());
+    CHECK_EQ(restored.getEntries().size(), generator.getEntries().size());
+    snapshot.close();
+    std::remove(kDamaged);
+    std::remove(kSnapshot);
+}
+
+TEST_CASE(snapshot, damagedFilesAreRejected) {
+    CHECK(writeMockSnapshot());
+    const std::string bytes = readFile(kSnapshot);
+    CHECK(bytes.size() > sizeof(SnapshotHeader));
+    SnapshotFile snapshot;
+    CHECK(snapshot.open(kSnapshot));
+    snapshot.close();
+
+    // A flipped byte in a payload fails that section's checksum
+    std::string damaged = bytes;
+    const SnapshotSectionEntry names = sectionEntry(bytes, SnapshotSection::StudentNames);
+    damaged[names.offset + names.bytes - 1] ^= 0x20;
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged));
+    CHECK(!snapshot.isOpen());
+
+    // Truncated, or a bad magic or version
+    writeFile(kDamaged, bytes.substr(0, bytes.size() - 64));
+    CHECK(!snapshot.open(kDamaged));
+    writeFile(kDamaged, bytes.substr(0, sizeof(SnapshotHeader) - 1));
+    CHECK(!snapshot.open(kDamaged));
+    damaged = bytes;
+    damaged[0] = 'X';
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged));
+    damaged = bytes;
+    damaged[offsetof(SnapshotHeader, version)] ^= 0x7F;
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged));
+
+    // An edited section table fails the header checksum
+    damaged = bytes;
+    damaged[sizeof(SnapshotHeader) + offsetof(SnapshotSectionEntry, bytes)] ^= 0x08;
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged, false));
+
+    std::remove(kDamaged);
+    std::remove(kSnapshot);
+}
+
+TEST_CASE(snapshot, textOffsetsAreValidatedWithoutChecksums) {
+    // Offsets that go backwards would hand out strings outside the column; they
+    // must be caught even when payload checksums are skipped
+    CHECK(writeMockSnapshot());
+    const std::string bytes = readFile(kSnapshot);
+    const SnapshotSectionEntry rollNos = sectionEntry(bytes, SnapshotSection::StudentRollNos);
+    uint64_t count = 0;
+    std::memcpy(&count, bytes.data() + rollNos.offset, sizeof(count));
+    CHECK(count > 2);
+
+    SnapshotFile snapshot;
+    std::string damaged = bytes;
+    uint64_t* offsets = reinterpret_cast<uint64_t*>(&damaged[rollNos.offset + sizeof(count)]);
+    offsets[1] = offsets[2] + 1;
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged, false));
+
+    damaged = bytes;
+    offsets = reinterpret_cast<uint64_t*>(&damaged[rollNos.offset + sizeof(count)]);
+    offsets[count] += 1; // Past the end of the characters
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged, false));
+
+    damaged = bytes;
+    count = ~uint64_t(0);
+    std::memcpy(&damaged[rollNos.offset], &count, sizeof(count));
+    writeFile(kDamaged, damaged);
+    CHECK(!snapshot.open(kDamaged, false));
+
+    std::remove(kDamaged);
+    std::remove(kSnapshot);
+}
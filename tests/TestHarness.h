@@ -0,0 +1,44 @@
+#ifndef TESTHARNESS_H
+#define TESTHARNESS_H
+
+#include <sstream>
+#include <string>
+
+// Minimal self-registering test cases, so the engine tests need nothing beyond
+// the standard library. TEST_CASE(group, name) defines a case; the runner takes
+// an optional group name and runs only that group (one CTest test per group).
+// CHECK failures are reported and counted; the case keeps running.
+
+using TestFunction = void (*)();
+
+struct TestRegistrar {
+    TestRegistrar(const char* group, const char* name, TestFunction run);
+};
+
+void reportFailure(const char* file, int line, const std::string& message);
+
+#define TEST_CASE(group, name)                                                   \
+    static void group##_##name();                                                \
+    static const TestRegistrar group##_##name##Registrar(#group, #name, group##_##name); \
+    static void group##_##name()
+
+#define CHECK(expression)                                                        \
+    do {                                                                         \
+        if (!(expression)) {                                                     \
+            reportFailure(__FILE__, __LINE__, "CHECK(" #expression ")");         \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                               \
+    do {                                                                         \
+        const auto& actualValue = (actual);                                      \
+        const auto& expectedValue = (expected);                                  \
+        if (!(actualValue == expectedValue)) {                                   \
+            std::ostringstream message;                                          \
+            message << "CHECK_EQ(" #actual ", " #expected "): got '" << actualValue \
+                    << "', expected '" << expectedValue << "'";                  \
+            reportFailure(__FILE__, __LINE__, message.str());                    \
+        }                                                                        \
+    } while (0)
+
+#endif // TESTHARNESS_H
@@ -0,0 +1,308 @@
+#include "TestHarness.h"
+#include "../include/DatabaseManager.h"
+#include "../include/RoomInventory.h"
+#include "../include/TimetableGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char* const kDataset = "generator_test.csv";
+
+// Imports `students` students (roll numbers CT-900000 on); coursesOf(s) lists the
+// course ids student s takes, up to three
+template<typename CoursesOf>
+bool loadStudents(DatabaseManager& db, int students, CoursesOf coursesOf) {
+    {
+        std::ofstream out(kDataset, std::ios::trunc);
+        out << "Name,Roll Number,Batch,Program,Course ID 1,Course 1,Course ID 2,Course 2,Course ID 3,Course 3\n";
+        for (int s = 0; s < students; s++) {
+            out << "Student " << s << ",CT-" << 900000 + s << ",2024,BSCS";
+            for (const std::string& course : coursesOf(s)) {
+                out << "," << course << ",Course " << course;
+            }
+            out << "\n";
+        }
+    }
+    const bool ok = db.importFromCSV(kDataset);
+    std::remove(kDataset);
+    return ok;
+}
+
+bool loadCourse(DatabaseManager& db, const std::string& course, int students) {
+    return loadStudents(db, students, [&](int) { return std::vector<std::string>{course}; });
+}
+
+Room room(const char* name, uint32_t capacity, uint8_t weekdays) {
+    Room r;
+    r.name = name;
+    r.capacity = capacity;
+    r.weekdays = weekdays;
+    return r;
+}
+
+uint32_t seatedStudents(const TimetableGenerator& generator) {
+    uint32_t seated = 0;
+    for (const ScheduleEntry& entry : generator.getEntries()) {
+        seated += entry.count;
+    }
+    return seated;
+}
+
+// Students of course s % 6 and of the next two courses: every course conflicts
+// with four others, and courses are 30 students each
+std::vector<std::string> overlappingCourses(int s) {
+    std::vector<std::string> courses;
+    for (int k = 0; k < 3; k++) {
+        courses.push_back("CT-" + std::to_string(100 + (s + k) % 6));
+    }
+    return courses;
+}
+
+RoomInventory smallRooms() {
+    RoomInventory rooms;
+    rooms.addRoom(room("Room 1", 12, RoomInventory::kEveryDay));
+    rooms.addRoom(room("Room 2", 20, RoomInventory::kEveryDay));
+    return rooms;
+}
+
+// Checks what every schedule must hold: each enrolled student is seated exactly
+// once per course, no room takes more seats than it has in a slot (nor, without
+// sharing, two sessions), and every enrolment has an exam slot. noClashes also
+// requires that no student sits two exams in one slot.
+void checkSchedule(const TimetableGenerator& generator, bool noClashes) {
+    CHECK(generator.isGenerated());
+    const EntityStore& store = generator.getStore();
+    const StoreIndex& index = generator.getStoreIndex();
+    const std::vector<ScheduleEntry>& entries = generator.getEntries();
+    for (uint32_t c = 0; c < store.courses.size(); c++) {
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        for (uint32_t e : generator.courseEntries(c)) {
+            CHECK_EQ(entries[e].course, c);
+            ranges.emplace_back(entries[e].firstStudent, entries[e].count);
+        }
+        std::sort(ranges.begin(), ranges.end());
+        uint32_t next = 0;
+        for (const auto& range : ranges) {
+            CHECK_EQ(range.first, next);
+            next = range.first + range.second;
+        }
+        CHECK_EQ(next, index.enrollmentCount(c));
+    }
+
+    std::map<std::pair<uint32_t, int32_t>, std::pair<uint32_t, uint32_t>> roomSlots; // -> sessions, seats
+    for (const ScheduleEntry& entry : entries) {
+        CHECK(entry.count > 0);
+        auto& booked = roomSlots[{entry.room, generator.examSlot(entry)}];
+        booked.first++;
+        booked.second += entry.count;
+    }
+    for (const auto& roomSlot : roomSlots) {
+        CHECK(roomSlot.second.second <= generator.roomCapacity(roomSlot.first.first));
+        if (!generator.getRoomSharing()) {
+            CHECK_EQ(roomSlot.second.first, 1u);
+        }
+    }
+
+    for (uint32_t s = 0; s < store.students.size(); s++) {
+        ArrayView<int32_t> slots = generator.studentExamSlots(s);
+        std::vector<int32_t> sorted(slots.begin(), slots.end());
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted.empty() || sorted.front() > 0);
+        if (noClashes) {
+            CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE(generator, schedulesSeatEveryStudentOnce) {
+    DatabaseManager mock;
+    mock.connect("", "", "");
+    DatabaseManager overlapping;
+    CHECK(loadStudents(overlapping, 60, overlappingCourses));
+
+    for (DatabaseManager* db : {&mock, &overlapping}) {
+        for (SchedulingMode mode : {SchedulingMode::Sequential, SchedulingMode::DSatur}) {
+            for (bool sharing : {false, true}) {
+                TimetableGenerator generator(*db);
+                generator.setStartDate("05-01-2026");
+                generator.setSchedulingMode(mode);
+                generator.setRoomSharing(sharing);
+                if (db == &overlapping) {
+                    generator.setRoomInventory(smallRooms());
+                }
+                CHECK(generator.generate());
+                CHECK(generator.getPhase() == GenerationPhase::Finished);
+                checkSchedule(generator, mode == SchedulingMode::DSatur);
+            }
+        }
+    }
+}
+
+TEST_CASE(generator, sittingsSeparateClashingExams) {
+    // Three sittings a day: clashing courses may share a day but never a sitting
+    DatabaseManager db;
+    CHECK(loadStudents(db, 60, overlappingCourses));
+    TimetableGenerator generator(db);
+    generator.setStartDate("05-01-2026");
+    generator.setSchedulingMode(SchedulingMode::DSatur);
+    generator.setSittingPlan(SittingPlan::standardDay(3));
+    CHECK(generator.generate());
+    checkSchedule(generator, true);
+    bool sharedDay = false;
+    for (const ScheduleEntry& entry : generator.getEntries()) {
+        CHECK(entry.sitting < 3);
+        CHECK_EQ(entry.minutes, generator.getSittingPlan().sitting(entry.sitting).length);
+        sharedDay = sharedDay || entry.sitting > 0;
+    }
+    CHECK(sharedDay);
+}
+
+TEST_CASE(generator, optimiseKeepsSchedulesValid) {
+    DatabaseManager db;
+    CHECK(loadStudents(db, 60, overlappingCourses));
+    for (bool sharing : {false, true}) {
+        TimetableGenerator generator(db);
+        generator.setStartDate("05-01-2026");
+        generator.setSchedulingMode(SchedulingMode::Sequential);
+        generator.setRoomInventory(smallRooms());
+        generator.setRoomSharing(sharing);
+        CHECK(generator.generate());
+        const uint64_t version = generator.getScheduleVersion();
+
+        OptimiserConfig config;
+        config.seconds = 0.2;
+        config.threads = 2;
+        OptimiserReport report;
+        CHECK(generator.optimise(config, &report));
+        CHECK(report.best.energy <= report.initial.energy);
+        CHECK(generator.getScheduleVersion() != version);
+        checkSchedule(generator, false);
+    }
+
+    TimetableGenerator empty(db);
+    OptimiserConfig config;
+    CHECK(!empty.optimise(config)); // Nothing generated yet
+}
+
+TEST_CASE(generator, generateRejectsInvalidInput) {
+    DatabaseManager db;
+    CHECK(loadCourse(db, "CT-900", 10));
+    TimetableGenerator generator(db);
+    generator.setStartDate("31-02-2026");
+    CHECK(!generator.generate());
+    CHECK(generator.getPhase() == GenerationPhase::Failed);
+    CHECK(!generator.isGenerated());
+
+    generator.setStartDate("05-01-2026");
+    generator.setRoomInventory(RoomInventory());
+    CHECK(!generator.generate());
+
+    DatabaseManager none;
+    TimetableGenerator noData(none);
+    noData.setStartDate("05-01-2026");
+    CHECK(!noData.generate());
+    CHECK(noData.getPhase() == GenerationPhase::Failed);
+}
+
+TEST_CASE(generator, roomsOpenOnlyAtWeekendsAreNotCounted) {
+    // The hall is the only room that holds the whole course, but it opens on
+    // Saturday, a weekend day: the course must span slots of the small room
+    // instead of waiting forever for a slot it fits in
+    DatabaseManager db;
+    CHECK(loadCourse(db, "CT-900", 50));
+    RoomInventory rooms;
+    rooms.addRoom(room("Small", 10, RoomInventory::kEveryDay));
+    rooms.addRoom(room("Hall", 100, 1u << 5));
+    ExamCalendar calendar;
+    calendar.setWeekend(ExamCalendar::kSaturdayAndSunday);
+
+    for (bool sharing : {false, true}) {
+        TimetableGenerator generator(db);
+        generator.setStartDate("05-01-2026");
+        generator.setRoomInventory(rooms);
+        generator.setExamCalendar(calendar);
+        generator.setRoomSharing(sharing);
+        CHECK(generator.generate());
+        CHECK_EQ(generator.getEntries().size(), 5u);
+        CHECK_EQ(seatedStudents(generator), 50u);
+        for (const ScheduleEntry& entry : generator.getEntries()) {
+            CHECK(calendar.isExamDay(entry.date));
+            CHECK_EQ(entry.room, 1u);
+            CHECK(entry.count <= 10u);
+        }
+
+        OptimiserConfig config;
+        config.seconds = 0.2;
+        config.threads = 1;
+        CHECK(generator.optimise(config));
+        CHECK_EQ(seatedStudents(generator), 50u);
+    }
+}
+
+TEST_CASE(generator, moveOntoOneDateStacksNoSessions) {
+    // Three sessions of one course in the only room, on days 1-3: moving the course
+    // to a single date would seat all of them in that room at once
+    DatabaseManager db;
+    CHECK(loadCourse(db, "CT-900", 50));
+    RoomInventory rooms;
+    rooms.addRoom(room("Room 1", 20, RoomInventory::kEveryDay));
+    TimetableGenerator generator(db);
+    generator.setStartDate("05-01-2026");
+    generator.setRoomInventory(rooms);
+    CHECK(generator.generate());
+    CHECK_EQ(generator.getEntries().size(), 3u);
+
+    for (const char* date : {"05-01-2026", "12-01-2026"}) {
+        RescheduleReport check = generator.checkCourseDate("CT-900", date);
+        CHECK(check.error.empty());
+        CHECK(check.clashingStudents.empty());
+        CHECK_EQ(check.occupiedRooms.size(), 1u);
+        RescheduleReport move = generator.moveCourseDate("CT-900", date, false);
+        CHECK(!move.applied);
+    }
+    CHECK_EQ(generator.getEntries()[2].dayIndex, 3);
+}
+
+TEST_CASE(generator, moveReportsClashesAndOccupiedRooms) {
+    // Every student takes A; the first ten also take B, so DSatur puts them in two slots
+    DatabaseManager db;
+    CHECK(loadStudents(db, 30, [](int s) {
+        return s < 10 ? std::vector<std::string>{"A", "B"} : std::vector<std::string>{"A"};
+    }));
+    TimetableGenerator generator(db);
+    generator.setStartDate("05-01-2026");
+    generator.setSchedulingMode(SchedulingMode::DSatur);
+    CHECK(generator.generate());
+    const std::vector<ScheduleEntry>& entries = generator.getEntries();
+    CHECK_EQ(entries.size(), 2u);
+    CHECK(entries[0].dayIndex != entries[1].dayIndex);
+    const uint32_t b = db.getStore().courses.find("B");
+    const int32_t bDay = entries[0].course == b ? entries[0].dayIndex : entries[1].dayIndex;
+    const char* aDate = bDay == 1 ? "06-01-2026" : "05-01-2026";
+
+    // Onto A's day: ten clashing students; the standard campus still has rooms free
+    RescheduleReport clash = generator.checkCourseDate("B", aDate);
+    CHECK_EQ(clash.clashingStudents.size(), 10u);
+    CHECK(!generator.moveCourseDate("B", aDate, false).applied);
+
+    CHECK(!generator.checkCourseDate("B", "31-02-2026").error.empty());
+    CHECK(!generator.checkCourseDate("B", "01-01-2026").error.empty()); // Before the start
+    CHECK(!generator.checkCourseDate("NOPE", "07-01-2026").error.empty());
+
+    // Onto a free day: applied, and the students' timetables follow
+    RescheduleReport move = generator.moveCourseDate("B", "09-01-2026", false);
+    CHECK(move.applied);
+    CHECK_EQ(move.newDayNumber, 5);
+    const uint32_t student = db.getStore().students.find("CT-900000");
+    ArrayView<uint32_t> exams = generator.studentTimetable(student);
+    CHECK_EQ(exams.size(), 2u);
+    CHECK_EQ(formatDate(entries[exams[1]].date), "09-01-2026");
+}
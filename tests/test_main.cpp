@@ -0,0 +1,60 @@
+#include "TestHarness.h"
+#include "../include/Logger.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+struct TestCase {
+    const char* group;
+    const char* name;
+    TestFunction run;
+};
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+int failures = 0;
+
+} // namespace
+
+TestRegistrar::TestRegistrar(const char* group, const char* name, TestFunction run) {
+    registry().push_back({group, name, run});
+}
+
+void reportFailure(const char* file, int line, const std::string& message) {
+    failures++;
+    std::cerr << file << ":" << line << ": " << message << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Expected failures (corrupt snapshots, bad input) still log as errors
+    Log::setConsole(LogLevel::Error, stderr);
+
+    const char* group = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    int failedCases = 0;
+    for (const TestCase& test : registry()) {
+        if (group != nullptr && std::strcmp(group, test.group) != 0) {
+            continue;
+        }
+        const int before = failures;
+        test.run();
+        run++;
+        if (failures != before) {
+            failedCases++;
+            std::cerr << "FAILED " << test.group << "." << test.name << std::endl;
+        }
+    }
+    Log::flush();
+
+    if (run == 0) {
+        std::cerr << "No tests in group " << (group != nullptr ? group : "(all)") << std::endl;
+        return 1;
+    }
+    std::cout << run - failedCases << "/" << run << " test cases passed" << std::endl;
+    return failedCases == 0 ? 0 : 1;
+}